@@ -39,9 +39,15 @@ auto apply_decision(AnnotatedFile file, const Warning& warning, NolintStyle styl
 // Render AnnotatedFile to final text with proper ordering
 auto render_annotated_file(const AnnotatedFile& file) -> std::vector<std::string>;
 
-// Write AnnotatedFile back to disk
+// Write AnnotatedFile back to disk (atomically, via write_lines_atomically)
 auto save_annotated_file(const AnnotatedFile& file, const std::string& file_path) -> bool;
 
+// Write lines to a unique temporary file beside `file_path`, then rename it into
+// place so readers never observe a partially written file. Symlinks are written
+// through to their target; files with other hard links are rewritten in place.
+auto write_lines_atomically(const std::vector<std::string>& lines, const std::string& file_path)
+    -> bool;
+
 // Extract indentation from a line
 auto extract_indentation(const std::string& line) -> std::string;
 
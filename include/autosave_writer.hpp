@@ -0,0 +1,101 @@
+#pragma once
+
+#include "ui_model.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace nolint {
+
+// Every decided warning in one file, as the writer should render it
+using FileDecisions = std::vector<std::pair<Warning, NolintStyle>>;
+
+// Indices of warnings per file path (built once per session)
+auto group_warning_indices_by_file(const std::vector<Warning>& warnings)
+    -> std::unordered_map<std::string, std::vector<size_t>>;
+
+// Snapshot the non-NONE decisions for one file's warnings
+auto collect_file_decisions(const std::vector<Warning>& warnings,
+                            const std::unordered_map<size_t, NolintStyle>& decisions,
+                            const std::vector<size_t>& file_warning_indices) -> FileDecisions;
+
+// Background writer for the opt-in autosave mode.
+//
+// Files are submitted with their complete decision snapshot whenever the user
+// leaves them. Submissions are coalesced per file for `coalesce_delay`, so
+// rapid toggles produce one write. Each file is always rendered from its
+// original contents (read on first touch), never from an already annotated
+// version, so re-submitting a file cannot stack comments.
+class AutosaveWriter {
+public:
+    struct Result {
+        std::vector<std::string> written_files;
+        std::vector<std::string> failed_files;
+    };
+
+    explicit AutosaveWriter(
+        std::chrono::milliseconds coalesce_delay = std::chrono::milliseconds(300));
+    ~AutosaveWriter();
+
+    AutosaveWriter(const AutosaveWriter&) = delete;
+    auto operator=(const AutosaveWriter&) -> AutosaveWriter& = delete;
+
+    // Queue a file's decisions, replacing any pending snapshot for that file
+    auto submit(const std::string& file_path, FileDecisions decisions) -> void;
+
+    // Write everything pending now and wait for it. Returns the files that now
+    // differ from their originals and every file that failed this session.
+    auto flush() -> Result;
+
+    // Flush, then put every written file back to its original contents
+    auto revert() -> Result;
+
+    // Before a file is edited outside the session: flush, put the file back to
+    // its original contents and return them (the text the warnings refer to).
+    // Returns nullopt when the writer never read the file or could not read it.
+    auto restore_original(const std::string& file_path)
+        -> std::optional<std::vector<std::string>>;
+
+    // After a file was edited outside the session: forget its state so the
+    // next write renders from the edited contents instead of the old original
+    auto rebase(const std::string& file_path) -> void;
+
+private:
+    struct Pending {
+        FileDecisions decisions;
+        std::chrono::steady_clock::time_point due;
+    };
+
+    struct FileState {
+        std::optional<std::vector<std::string>> original_lines; // nullopt: unreadable
+        FileDecisions written_decisions; // Decisions currently on disk
+        bool written = false;
+    };
+
+    // Write everything pending and wait for the worker; `lock` holds mutex_ throughout
+    auto wait_until_idle(std::unique_lock<std::mutex>& lock) -> void;
+    auto run() -> void;
+    auto write_file(const std::string& file_path, const FileDecisions& decisions) -> void;
+
+    std::chrono::milliseconds coalesce_delay_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable idle_;
+    std::unordered_map<std::string, Pending> pending_;
+    // Map guarded by mutex_; states touched by the worker while busy, else by callers
+    std::unordered_map<std::string, std::shared_ptr<FileState>> files_;
+    Result result_;
+    bool flush_requested_ = false;
+    bool busy_ = false;
+    bool stopping_ = false;
+    std::thread worker_;
+};
+
+} // namespace nolint
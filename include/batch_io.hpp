@@ -0,0 +1,37 @@
+#pragma once
+
+#include "progress.hpp"
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace nolint {
+
+// Threads used for batched file I/O. Sized to keep many requests in flight on
+// NVMe and network storage rather than to match the CPU count, since workers
+// mostly wait on the device.
+constexpr size_t DEFAULT_IO_WORKERS = 16;
+
+// One file to replace with `lines`
+struct FileWrite {
+    std::string path;
+    std::vector<std::string> lines;
+};
+
+// Split file contents into lines exactly as repeated std::getline would
+auto split_lines(std::string_view content) -> std::vector<std::string>;
+
+// Read every file in one batch; result i is std::nullopt when paths[i] cannot be
+// read or is not a regular file (a directory, a missing path)
+auto read_files(const std::vector<std::string>& paths, size_t worker_count = DEFAULT_IO_WORKERS)
+    -> std::vector<std::optional<std::string>>;
+
+// Write every file in one batch, each via write_lines_atomically (write, fsync,
+// rename). Result i is true when writes[i] landed. Completed files are counted
+// into `progress` as they finish (nullptr = off).
+auto write_files(const std::vector<FileWrite>& writes, ProgressCounters* progress = nullptr,
+                 size_t worker_count = DEFAULT_IO_WORKERS) -> std::vector<bool>;
+
+} // namespace nolint
@@ -0,0 +1,389 @@
+#pragma once
+
+#include "string_pool.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace nolint {
+
+using CheckId = std::uint32_t;
+
+// Metadata for a check known at compile time
+struct CheckInfo {
+    std::string_view name;
+    std::string_view category;  // "readability", "clang-analyzer", ...
+    bool reports_function_size; // Followed by a "note: N lines including ..." note
+};
+
+// One entry of the known check table
+struct KnownCheck {
+    std::string_view name;
+    bool reports_function_size = false; // Followed by a "note: N lines including ..." note
+};
+
+// clang-tidy checks we expect to see often. Ids are positions in this list;
+// anything else is interned at runtime by CheckRegistry.
+inline constexpr auto KNOWN_CHECKS = std::to_array<KnownCheck>({
+    {"abseil-string-find-startswith"},
+    {"altera-struct-pack-align"},
+    {"android-cloexec-open"},
+    {"boost-use-to-string"},
+    {"bugprone-argument-comment"},
+    {"bugprone-assignment-in-if-condition"},
+    {"bugprone-bool-pointer-implicit-conversion"},
+    {"bugprone-branch-clone"},
+    {"bugprone-casting-through-void"},
+    {"bugprone-copy-constructor-init"},
+    {"bugprone-dangling-handle"},
+    {"bugprone-easily-swappable-parameters"},
+    {"bugprone-empty-catch"},
+    {"bugprone-exception-escape"},
+    {"bugprone-forward-declaration-namespace"},
+    {"bugprone-implicit-widening-of-multiplication-result"},
+    {"bugprone-inc-dec-in-conditions"},
+    {"bugprone-integer-division"},
+    {"bugprone-macro-parentheses"},
+    {"bugprone-misplaced-widening-cast"},
+    {"bugprone-move-forwarding-reference"},
+    {"bugprone-narrowing-conversions"},
+    {"bugprone-not-null-terminated-result"},
+    {"bugprone-parent-virtual-call"},
+    {"bugprone-reserved-identifier"},
+    {"bugprone-signed-char-misuse"},
+    {"bugprone-sizeof-expression"},
+    {"bugprone-string-constructor"},
+    {"bugprone-suspicious-include"},
+    {"bugprone-suspicious-missing-comma"},
+    {"bugprone-suspicious-string-compare"},
+    {"bugprone-switch-missing-default-case"},
+    {"bugprone-too-small-loop-variable"},
+    {"bugprone-unchecked-optional-access"},
+    {"bugprone-undefined-memory-manipulation"},
+    {"bugprone-unhandled-self-assignment"},
+    {"bugprone-unused-local-non-trivial-variable"},
+    {"bugprone-unused-return-value"},
+    {"bugprone-use-after-move"},
+    {"cert-dcl21-cpp"},
+    {"cert-dcl37-c"},
+    {"cert-dcl50-cpp"},
+    {"cert-dcl51-cpp"},
+    {"cert-dcl58-cpp"},
+    {"cert-env33-c"},
+    {"cert-err33-c"},
+    {"cert-err34-c"},
+    {"cert-err58-cpp"},
+    {"cert-flp30-c"},
+    {"cert-msc30-c"},
+    {"cert-msc32-c"},
+    {"cert-msc50-cpp"},
+    {"cert-msc51-cpp"},
+    {"cert-oop54-cpp"},
+    {"cert-oop57-cpp"},
+    {"clang-analyzer-core.CallAndMessage"},
+    {"clang-analyzer-core.DivideZero"},
+    {"clang-analyzer-core.NonNullParamChecker"},
+    {"clang-analyzer-core.NullDereference"},
+    {"clang-analyzer-core.UndefinedBinaryOperatorResult"},
+    {"clang-analyzer-core.uninitialized.Assign"},
+    {"clang-analyzer-cplusplus.NewDelete"},
+    {"clang-analyzer-cplusplus.NewDeleteLeaks"},
+    {"clang-analyzer-deadcode.DeadStores"},
+    {"clang-analyzer-optin.cplusplus.VirtualCall"},
+    {"clang-analyzer-security.insecureAPI.strcpy"},
+    {"clang-analyzer-unix.Malloc"},
+    {"clang-diagnostic-error"},
+    {"clang-diagnostic-unused-parameter"},
+    {"clang-diagnostic-unused-variable"},
+    {"concurrency-mt-unsafe"},
+    {"cppcoreguidelines-avoid-c-arrays"},
+    {"cppcoreguidelines-avoid-const-or-ref-data-members"},
+    {"cppcoreguidelines-avoid-do-while"},
+    {"cppcoreguidelines-avoid-goto"},
+    {"cppcoreguidelines-avoid-magic-numbers"},
+    {"cppcoreguidelines-avoid-non-const-global-variables"},
+    {"cppcoreguidelines-init-variables"},
+    {"cppcoreguidelines-macro-usage"},
+    {"cppcoreguidelines-missing-std-forward"},
+    {"cppcoreguidelines-narrowing-conversions"},
+    {"cppcoreguidelines-no-malloc"},
+    {"cppcoreguidelines-non-private-member-variables-in-classes"},
+    {"cppcoreguidelines-owning-memory"},
+    {"cppcoreguidelines-prefer-member-initializer"},
+    {"cppcoreguidelines-pro-bounds-array-to-pointer-decay"},
+    {"cppcoreguidelines-pro-bounds-constant-array-index"},
+    {"cppcoreguidelines-pro-bounds-pointer-arithmetic"},
+    {"cppcoreguidelines-pro-type-const-cast"},
+    {"cppcoreguidelines-pro-type-cstyle-cast"},
+    {"cppcoreguidelines-pro-type-member-init"},
+    {"cppcoreguidelines-pro-type-reinterpret-cast"},
+    {"cppcoreguidelines-pro-type-static-cast-downcast"},
+    {"cppcoreguidelines-pro-type-union-access"},
+    {"cppcoreguidelines-pro-type-vararg"},
+    {"cppcoreguidelines-rvalue-reference-param-not-moved"},
+    {"cppcoreguidelines-special-member-functions"},
+    {"cppcoreguidelines-use-default-member-init"},
+    {"fuchsia-default-arguments-calls"},
+    {"fuchsia-overloaded-operator"},
+    {"google-build-using-namespace"},
+    {"google-explicit-constructor"},
+    {"google-readability-braces-around-statements"},
+    {"google-readability-casting"},
+    {"google-readability-function-size", true},
+    {"google-readability-todo"},
+    {"google-runtime-int"},
+    {"hicpp-braces-around-statements"},
+    {"hicpp-explicit-conversions"},
+    {"hicpp-function-size", true},
+    {"hicpp-member-init"},
+    {"hicpp-no-array-decay"},
+    {"hicpp-signed-bitwise"},
+    {"hicpp-special-member-functions"},
+    {"hicpp-uppercase-literal-suffix"},
+    {"hicpp-use-auto"},
+    {"hicpp-vararg"},
+    {"llvm-header-guard"},
+    {"llvm-include-order"},
+    {"llvm-namespace-comment"},
+    {"llvm-qualified-auto"},
+    {"llvmlibc-callee-namespace"},
+    {"llvmlibc-implementation-in-namespace"},
+    {"llvmlibc-restrict-system-libc-headers"},
+    {"misc-const-correctness"},
+    {"misc-include-cleaner"},
+    {"misc-no-recursion"},
+    {"misc-non-private-member-variables-in-classes"},
+    {"misc-unused-parameters"},
+    {"misc-use-anonymous-namespace"},
+    {"misc-use-internal-linkage"},
+    {"modernize-avoid-c-arrays"},
+    {"modernize-concat-nested-namespaces"},
+    {"modernize-loop-convert"},
+    {"modernize-macro-to-enum"},
+    {"modernize-make-unique"},
+    {"modernize-pass-by-value"},
+    {"modernize-raw-string-literal"},
+    {"modernize-return-braced-init-list"},
+    {"modernize-use-auto"},
+    {"modernize-use-default-member-init"},
+    {"modernize-use-designated-initializers"},
+    {"modernize-use-emplace"},
+    {"modernize-use-equals-default"},
+    {"modernize-use-nodiscard"},
+    {"modernize-use-nullptr"},
+    {"modernize-use-override"},
+    {"modernize-use-std-numbers"},
+    {"modernize-use-trailing-return-type"},
+    {"modernize-use-using"},
+    {"performance-avoid-endl"},
+    {"performance-enum-size"},
+    {"performance-for-range-copy"},
+    {"performance-inefficient-string-concatenation"},
+    {"performance-move-const-arg"},
+    {"performance-no-int-to-ptr"},
+    {"performance-unnecessary-copy-initialization"},
+    {"performance-unnecessary-value-param"},
+    {"portability-simd-intrinsics"},
+    {"readability-avoid-const-params-in-decls"},
+    {"readability-avoid-nested-conditional-operator"},
+    {"readability-braces-around-statements"},
+    {"readability-convert-member-functions-to-static"},
+    {"readability-else-after-return"},
+    {"readability-function-cognitive-complexity"},
+    {"readability-function-size", true},
+    {"readability-identifier-length"},
+    {"readability-identifier-naming"},
+    {"readability-implicit-bool-conversion"},
+    {"readability-inconsistent-declaration-parameter-name"},
+    {"readability-isolate-declaration"},
+    {"readability-magic-numbers"},
+    {"readability-make-member-function-const"},
+    {"readability-math-missing-parentheses"},
+    {"readability-named-parameter"},
+    {"readability-qualified-auto"},
+    {"readability-redundant-member-init"},
+    {"readability-simplify-boolean-expr"},
+    {"readability-static-accessed-through-instance"},
+    {"readability-uppercase-literal-suffix"},
+    {"readability-use-anyofallof"},
+});
+
+inline constexpr CheckId KNOWN_CHECK_COUNT = KNOWN_CHECKS.size();
+
+namespace detail {
+
+// Slots and buckets of the perfect hash (power of two for masking)
+inline constexpr std::uint32_t CHECK_HASH_SLOTS = std::bit_ceil(KNOWN_CHECK_COUNT);
+
+// FNV-1a with a seed, finished with a multiply-xorshift mix
+constexpr auto check_hash(std::string_view name, std::uint32_t seed) -> std::uint32_t {
+    std::uint32_t hash = 2166136261U ^ (seed * 0x9E3779B9U);
+    for (char c : name) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 16777619U;
+    }
+    hash ^= hash >> 16;
+    hash *= 0x85EBCA6BU;
+    hash ^= hash >> 13;
+    return hash;
+}
+
+// Hash-and-displace table: a name's first hash picks a bucket, and the bucket's
+// displacement either names its slot directly (negative, single-entry buckets)
+// or is the seed of a second hash that places every bucket member collision-free
+struct CheckHashTable {
+    std::array<std::int32_t, CHECK_HASH_SLOTS> displacements{};
+    std::array<std::uint16_t, CHECK_HASH_SLOTS> slots{}; // check index + 1, 0 = empty
+    bool complete = false; // Every known check was placed
+};
+
+constexpr auto build_check_hash_table() -> CheckHashTable {
+    constexpr std::uint32_t MASK = CHECK_HASH_SLOTS - 1;
+    constexpr std::int32_t MAX_SEED = 1 << 16;
+
+    CheckHashTable table;
+    std::array<std::uint32_t, KNOWN_CHECK_COUNT> bucket_of{};
+    std::array<std::uint32_t, CHECK_HASH_SLOTS> bucket_sizes{};
+    for (CheckId id = 0; id < KNOWN_CHECK_COUNT; ++id) {
+        bucket_of[id] = check_hash(KNOWN_CHECKS[id].name, 0) & MASK;
+        bucket_sizes[bucket_of[id]]++;
+    }
+
+    // Place the largest buckets first, while most slots are still free
+    std::array<std::uint32_t, CHECK_HASH_SLOTS> order{};
+    for (std::uint32_t b = 0; b < CHECK_HASH_SLOTS; ++b) {
+        order[b] = b;
+    }
+    std::sort(order.begin(), order.end(), [&](std::uint32_t a, std::uint32_t b) {
+        return bucket_sizes[a] != bucket_sizes[b] ? bucket_sizes[a] > bucket_sizes[b] : a < b;
+    });
+
+    std::uint32_t next_free = 0;
+    for (auto bucket : order) {
+        if (bucket_sizes[bucket] == 0) {
+            break;
+        }
+
+        std::array<CheckId, KNOWN_CHECK_COUNT> members{};
+        std::uint32_t member_count = 0;
+        for (CheckId id = 0; id < KNOWN_CHECK_COUNT; ++id) {
+            if (bucket_of[id] == bucket) {
+                members[member_count++] = id;
+            }
+        }
+
+        if (member_count == 1) {
+            while (table.slots[next_free] != 0) {
+                ++next_free;
+            }
+            table.slots[next_free] = static_cast<std::uint16_t>(members[0] + 1);
+            table.displacements[bucket] = -static_cast<std::int32_t>(next_free) - 1;
+            continue;
+        }
+
+        // Equal names share every hash, so no seed could separate them
+        for (std::uint32_t m = 1; m < member_count; ++m) {
+            for (std::uint32_t k = 0; k < m; ++k) {
+                if (KNOWN_CHECKS[members[k]].name == KNOWN_CHECKS[members[m]].name) {
+                    return table;
+                }
+            }
+        }
+
+        std::int32_t seed = 1;
+        for (; seed < MAX_SEED; ++seed) {
+            std::array<std::uint32_t, KNOWN_CHECK_COUNT> placed{};
+            bool fits = true;
+            for (std::uint32_t m = 0; m < member_count && fits; ++m) {
+                placed[m]
+                    = check_hash(KNOWN_CHECKS[members[m]].name, static_cast<std::uint32_t>(seed))
+                      & MASK;
+                fits = table.slots[placed[m]] == 0;
+                for (std::uint32_t k = 0; k < m && fits; ++k) {
+                    fits = placed[k] != placed[m];
+                }
+            }
+            if (fits) {
+                for (std::uint32_t m = 0; m < member_count; ++m) {
+                    table.slots[placed[m]] = static_cast<std::uint16_t>(members[m] + 1);
+                }
+                table.displacements[bucket] = seed;
+                break;
+            }
+        }
+        if (seed == MAX_SEED) {
+            return table;
+        }
+    }
+
+    table.complete = true;
+    return table;
+}
+
+inline constexpr CheckHashTable CHECK_HASH_TABLE = build_check_hash_table();
+static_assert(CHECK_HASH_TABLE.complete,
+              "no displacement places a bucket of KNOWN_CHECKS; duplicate check name?");
+
+} // namespace detail
+
+// Category of any check name: the text before the first '-', except for the
+// two-word "clang-analyzer" and "clang-diagnostic" prefixes
+constexpr auto check_category(std::string_view name) -> std::string_view {
+    for (std::string_view prefix : {"clang-analyzer-", "clang-diagnostic-"}) {
+        if (name.starts_with(prefix)) {
+            return name.substr(0, prefix.size() - 1);
+        }
+    }
+    size_t dash = name.find('-');
+    return (dash == std::string_view::npos) ? name : name.substr(0, dash);
+}
+
+// Id of a compile-time known check: two hashes and one string comparison
+constexpr auto find_known_check(std::string_view name) -> std::optional<CheckId> {
+    constexpr std::uint32_t MASK = detail::CHECK_HASH_SLOTS - 1;
+    std::int32_t displacement
+        = detail::CHECK_HASH_TABLE.displacements[detail::check_hash(name, 0) & MASK];
+    std::uint32_t slot
+        = (displacement < 0)
+              ? static_cast<std::uint32_t>(-displacement - 1)
+              : detail::check_hash(name, static_cast<std::uint32_t>(displacement)) & MASK;
+
+    std::uint16_t entry = detail::CHECK_HASH_TABLE.slots[slot];
+    if (entry == 0 || KNOWN_CHECKS[entry - 1].name != name) {
+        return std::nullopt;
+    }
+    return CheckId{entry - 1U};
+}
+
+// Whether warnings of this check carry a function size note
+constexpr auto reports_function_size(std::string_view name) -> bool {
+    auto id = find_known_check(name);
+    return id && KNOWN_CHECKS[*id].reports_function_size;
+}
+
+constexpr auto known_check_info(CheckId id) -> CheckInfo {
+    const auto& check = KNOWN_CHECKS[id];
+    return CheckInfo{.name = check.name,
+                     .category = check_category(check.name),
+                     .reports_function_size = check.reports_function_size};
+}
+
+// Check ids for one session: known checks keep their compile-time ids and
+// unknown names are interned after them
+struct CheckRegistry {
+    StringPool unknown;
+};
+
+// Pure functions for CheckRegistry manipulation
+
+auto intern_check(CheckRegistry& registry, std::string_view name) -> CheckId;
+
+// Known checks plus unknown checks interned so far
+auto check_count(const CheckRegistry& registry) -> size_t;
+
+auto check_name(const CheckRegistry& registry, CheckId id) -> std::string_view;
+
+} // namespace nolint
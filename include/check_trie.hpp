@@ -0,0 +1,86 @@
+#pragma once
+
+#include "check_registry.hpp"
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace nolint {
+
+enum class NolintStyle; // Defined in ui_model.hpp
+struct WarningTable;
+
+// Per-style warning counts for one trie node
+struct StyleCounts {
+    int total = 0;
+    int nolint = 0;
+    int nolintnextline = 0;
+    int nolint_block = 0;
+    int unsuppressed = 0;
+};
+
+// Statistics table sort keys; counts sort descending, NAME ascending
+enum class StatisticsSort { TOTAL, UNSUPPRESSED, NOLINT, NOLINTNEXTLINE, NOLINT_BLOCK, NAME };
+
+constexpr size_t STATISTICS_SORT_COUNT = 6;
+
+constexpr size_t NO_TRIE_NODE = static_cast<size_t>(-1);
+
+// One check name prefix, e.g. "readability" -> "readability-identifier" ->
+// "readability-identifier-naming". Counts cover the whole subtree.
+struct CheckTrieNode {
+    std::string label; // Full prefix
+    size_t parent = NO_TRIE_NODE;
+    size_t depth = 0;            // 0 for categories
+    std::vector<size_t> children;
+    std::optional<CheckId> check; // Set when the label is a check that occurs
+    StyleCounts counts;
+    bool expanded = false;
+};
+
+// Prefix trie of the checks in a warning table. Names split at '-' and '.'
+// after the category; intermediate prefixes with a single child are merged
+// away so every level is a real choice. Decisions adjust the counts of one
+// leaf-to-root path instead of recounting the table.
+struct CheckTrie {
+    std::vector<CheckTrieNode> nodes;
+    std::vector<size_t> roots;         // Categories, sorted by label
+    std::vector<size_t> node_of_check; // CheckId -> node, NO_TRIE_NODE when absent
+    size_t warning_count = 0;          // Size of the table it was built from
+
+    // Position of every node in a full ordering per sort key, so ordering
+    // siblings is an integer comparison and switching keys re-sorts nothing.
+    // Decisions change counts and mark them stale.
+    std::array<std::vector<size_t>, STATISTICS_SORT_COUNT> ranks;
+    bool ranks_current = false;
+};
+
+// Pure functions for CheckTrie manipulation
+
+auto build_check_trie(const WarningTable& table,
+                      const std::unordered_map<size_t, NolintStyle>& decisions) -> CheckTrie;
+
+// Move one warning of `check` from the `before` to the `after` column, O(depth)
+auto apply_decision_change(CheckTrie& trie, CheckId check, NolintStyle before, NolintStyle after)
+    -> void;
+
+// Recompute ranks if decisions changed counts since they were built
+auto rank_trie_nodes(CheckTrie& trie) -> void;
+
+// Nodes shown in the statistics view: roots, plus children of expanded nodes,
+// depth first, siblings ordered by `sort` with ties by label
+auto visible_trie_rows(const CheckTrie& trie, StatisticsSort sort = StatisticsSort::TOTAL)
+    -> std::vector<size_t>;
+
+auto next_statistics_sort(StatisticsSort sort) -> StatisticsSort;
+
+// Short column name for the header ("total", "none", ...)
+auto statistics_sort_name(StatisticsSort sort) -> std::string_view;
+
+// Every check in the subtree rooted at `node`
+auto checks_under(const CheckTrie& trie, size_t node) -> std::vector<CheckId>;
+
+} // namespace nolint
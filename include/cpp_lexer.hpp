@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace nolint {
+
+// Token classes worth coloring; everything else renders as plain text
+enum class TokenKind : std::uint8_t { KEYWORD, TYPE, NUMBER, STRING, COMMENT, PREPROCESSOR };
+
+// One colored run within a line (byte offsets)
+struct TokenSpan {
+    std::uint32_t start = 0;
+    std::uint32_t length = 0;
+    TokenKind kind = TokenKind::KEYWORD;
+};
+
+// Constructs that carry over to the next line
+struct LexState {
+    bool in_block_comment = false;
+    bool in_raw_string = false;
+    bool in_preprocessor = false; // Previous directive line ended with '\'
+    std::string raw_delimiter;    // Closing sequence, e.g. )xyz"
+};
+
+// Pure functions for lexing
+
+// Color one line of C++ given the state left by the previous line. This is a
+// highlighter, not a compiler front end: it knows comments, string/char/raw
+// literals, numbers, keywords, builtin types and directives, and nothing more.
+auto lex_line(std::string_view line, LexState& state) -> std::vector<TokenSpan>;
+
+} // namespace nolint
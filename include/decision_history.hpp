@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace nolint {
+
+enum class NolintStyle; // Defined in ui_model.hpp
+
+// One decision edit: the style a warning had before and after
+struct DecisionChange {
+    size_t warning_index = 0; // Index into UIModel::warnings
+    NolintStyle before;
+    NolintStyle after;
+};
+
+// One undoable user action. Nodes are immutable and linked, so a history is a
+// persistent stack: pushing shares every older node, and copying the UIModel
+// copies two pointers instead of the history. The change list is shared too, so
+// moving an action between the undo and redo stacks never copies it.
+struct HistoryNode {
+    std::shared_ptr<const std::vector<DecisionChange>> changes;
+    size_t cursor_position = 0; // current_index when the action happened
+    size_t depth = 1;           // Number of nodes in this stack
+    std::shared_ptr<const HistoryNode> next;
+};
+
+struct DecisionHistory {
+    std::shared_ptr<const HistoryNode> undo_stack;
+    std::shared_ptr<const HistoryNode> redo_stack;
+};
+
+// Undo levels kept; each push past this drops the oldest level
+constexpr size_t MAX_UNDO_LEVELS = 500;
+
+// Pure functions for DecisionHistory manipulation
+
+// Record a new action (no-op for an empty change list). Clears the redo stack.
+auto push_action(DecisionHistory history, std::vector<DecisionChange> changes,
+                 size_t cursor_position) -> DecisionHistory;
+
+// Move the newest undo action onto the redo stack. Returns the moved node
+// (nullptr if there is nothing to undo) so the caller can revert its changes.
+auto pop_undo(DecisionHistory& history) -> std::shared_ptr<const HistoryNode>;
+
+// Move the newest redo action back onto the undo stack (nullptr if none)
+auto pop_redo(DecisionHistory& history) -> std::shared_ptr<const HistoryNode>;
+
+auto undo_depth(const DecisionHistory& history) -> size_t;
+auto redo_depth(const DecisionHistory& history) -> size_t;
+
+} // namespace nolint
@@ -23,6 +23,10 @@ struct FileContext {
 // Read file context around a warning location
 auto read_file_context(const Warning& warning, int context_lines = 3) -> FileContext;
 
+// Same, from lines already in memory (e.g. a SourceCache entry)
+auto read_file_context(const std::vector<std::string>& all_lines, const Warning& warning,
+                       int context_lines = 3) -> FileContext;
+
 // Build preview of what the suppression would look like
 auto build_suppression_preview(const Warning& warning, NolintStyle style) -> std::optional<std::string>;
 
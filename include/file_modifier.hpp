@@ -2,6 +2,7 @@
 
 #include "ui_model.hpp"
 #include "annotated_file.hpp"
+#include "progress.hpp"
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -23,6 +24,12 @@ public:
                         const std::unordered_map<size_t, NolintStyle>& decisions,
                         bool dry_run = false) -> ModificationResult;
     
+    // Count processed files into `progress` while applying (nullptr = off)
+    auto set_progress(ProgressCounters* progress) -> void { progress_ = progress; }
+
+    // Print a line per modified file (off while a refreshing status line is shown)
+    auto set_verbose(bool verbose) -> void { verbose_ = verbose; }
+
     // Preview what a file would look like after modifications
     auto preview_file_changes(const std::string& file_path,
                              const std::vector<Warning>& warnings,
@@ -30,6 +37,9 @@ public:
                              -> std::vector<std::string>;
 
 private:
+    ProgressCounters* progress_ = nullptr;
+    bool verbose_ = true;
+
     // Group warnings by file for efficient processing
     auto group_warnings_by_file(const std::vector<Warning>& warnings,
                                const std::unordered_map<size_t, NolintStyle>& decisions) 
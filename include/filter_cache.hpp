@@ -0,0 +1,61 @@
+#pragma once
+
+#include "navigation.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace nolint {
+
+// One remembered filter result with the navigation indexes built for it. The
+// indices and indexes are shared, so a cache hit restores a filter without
+// decoding, matching or sorting anything. The decided bitset (one bit per
+// position) is moved out to the model on a hit and back when the filter is left.
+struct FilterCacheEntry {
+    std::string key; // Normalized query
+    std::shared_ptr<const std::vector<size_t>> indices;
+    std::shared_ptr<const RunIndex> runs;
+    std::shared_ptr<const LocationIndex> locations; // nullptr once warnings moved lines
+    size_t current_index = 0;    // Position to restore when the filter is applied again
+    std::uint64_t last_used = 0; // LRU clock value
+    PositionBitset decided;      // Decided bitset left behind when the filter was last shown
+    std::uint64_t decisions_version = 0; // UIModel::decisions_version `decided` matches
+};
+
+// Small LRU cache of recent filter results. Capacity is a handful of filters,
+// so lookups are a linear scan and the struct stays cheap to copy.
+struct FilterCache {
+    std::vector<FilterCacheEntry> entries;
+    size_t capacity = 8;
+    std::uint64_t clock = 0;
+    size_t warning_count = 0; // Size of the warning set the entries were computed for
+};
+
+// Pure functions for FilterCache manipulation
+
+// Normalize a query so equivalent filters share an entry (matching is case-insensitive)
+auto normalize_filter_key(const std::string& filter) -> std::string;
+
+// Drop every entry if the warning set changed since they were computed
+auto invalidate_filter_cache(FilterCache& cache, size_t warning_count) -> void;
+
+// Find an entry and mark it most recently used (nullptr on miss)
+auto lookup_filter(FilterCache& cache, const std::string& key) -> FilterCacheEntry*;
+
+// Insert or replace an entry (keyed by entry.key), evicting the least recently
+// used one when full
+auto store_filter(FilterCache& cache, FilterCacheEntry entry) -> void;
+
+// Remember the cursor position and decided bitset for a cached filter, so returning
+// to it restores both (no-op if the filter is not cached)
+auto remember_filter_position(FilterCache& cache, const std::string& key, size_t current_index,
+                              PositionBitset decided = {}, std::uint64_t decisions_version = 0)
+    -> void;
+
+// Drop cached location indexes (after warnings moved to other lines); they are
+// rebuilt the next time their filter is applied
+auto forget_filter_locations(FilterCache& cache) -> void;
+
+} // namespace nolint
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "ui_model.hpp"
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace nolint {
+
+// Search queries starting with this character use fuzzy matching
+constexpr char FUZZY_QUERY_PREFIX = '~';
+
+// Number of best matches fully ordered by score; the rest keep warning order
+constexpr size_t DEFAULT_RANKED_COUNT = 1000;
+
+// True for "~pattern" queries
+auto is_fuzzy_query(const std::string& query) -> bool;
+
+// fzf-style subsequence score of `lower_pattern` in `text` (higher is better),
+// or std::nullopt if the pattern is not a subsequence. Rewards matches at word
+// boundaries, camelCase humps and consecutive runs; penalizes gaps.
+auto fuzzy_score(std::string_view text, std::string_view lower_pattern) -> std::optional<int>;
+
+// Indices of warnings whose "file_path type message" contains `pattern` as a
+// subsequence. The best `ranked_count` come first by descending score; the
+// remaining matches follow in warning order.
+auto fuzzy_filter_warnings(const WarningTable& table, const std::string& pattern,
+                           size_t ranked_count = DEFAULT_RANKED_COUNT) -> std::vector<size_t>;
+
+// The best `count` fuzzy matches and how many warnings match in total
+struct FuzzyPreview {
+    size_t match_count = 0;
+    std::vector<size_t> top; // Descending score, earlier warning first on ties
+};
+
+// Top-K only variant of fuzzy_filter_warnings for previews: scores every warning
+// but orders just the best `count` and leaves the rest unsorted and discarded
+auto fuzzy_top_matches(const WarningTable& table, const std::string& pattern, size_t count)
+    -> FuzzyPreview;
+
+} // namespace nolint
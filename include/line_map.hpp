@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace nolint {
+
+// Where each line of an old version of a file ended up in a new version.
+// Unchanged lines follow their text; deleted or rewritten lines move to the
+// line that now stands in their place.
+struct LineMap {
+    std::vector<int> new_lines; // new_lines[i]: 1-based new line of old line i + 1
+    int line_delta = 0;         // Shift for lines past the old end
+    size_t changed_lines = 0;   // Old lines with no identical line in the new version
+};
+
+// Edit distance beyond which the changed middle of a file is mapped by
+// proportion instead of diffed
+constexpr size_t MAX_DIFF_EDITS = 2048;
+
+// Pure functions for LineMap manipulation
+
+// Diff two versions of a file (common prefix/suffix, then Myers on the rest)
+auto map_lines(const std::vector<std::string>& old_lines, const std::vector<std::string>& new_lines)
+    -> LineMap;
+
+// New 1-based line for an old 1-based line
+auto remap_line(const LineMap& map, int line) -> int;
+
+// True when every line kept its number
+auto is_identity(const LineMap& map) -> bool;
+
+} // namespace nolint
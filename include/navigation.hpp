@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace nolint {
+
+// Fixed-size bitset over positions in filtered_warning_indices.
+// Stored as 64-bit words so scans can skip a whole word per step.
+struct PositionBitset {
+    std::vector<std::uint64_t> words;
+    size_t size = 0;
+};
+
+// Start positions of consecutive runs in filtered_warning_indices that share
+// a file or a check type. Both tables are sorted, so jumps are binary searches.
+struct RunIndex {
+    std::vector<size_t> file_run_starts;
+    std::vector<size_t> type_run_starts;
+    size_t position_count = 0; // Size of filtered_warning_indices the tables describe
+};
+
+// Warning line paired with its position in filtered_warning_indices
+struct LineEntry {
+    int line = 0;
+    size_t position = 0;
+};
+
+// Per-file line index over the filtered warnings, each vector sorted by line
+struct LocationIndex {
+    std::unordered_map<std::string, std::vector<LineEntry>> lines_by_file;
+    size_t position_count = 0; // Size of filtered_warning_indices the index describes
+};
+
+// A warning (index into UIModel::warnings) at a source line
+struct LineWarning {
+    int line = 0;
+    size_t warning_index = 0;
+};
+
+// Every warning grouped by file and sorted by line, over the whole warning set.
+// Files are WarningTable path ids; file f owns entries[file_starts[f], file_starts[f + 1]).
+struct FileLineIndex {
+    std::vector<size_t> file_starts;
+    std::vector<LineWarning> entries;
+};
+
+// Parsed go-to command: either a 1-based warning number or a file location
+struct GotoTarget {
+    std::optional<size_t> warning_number; // ":1234" form
+    std::string file_path;                // "path:line" form
+    int line = 0;                         // 0 when only a path was given
+};
+
+struct WarningTable;
+
+// Pure functions for PositionBitset manipulation
+
+// Create a bitset with every bit cleared
+auto make_position_bitset(size_t size) -> PositionBitset;
+
+// Set or clear a single bit (out-of-range positions are ignored)
+auto set_position(PositionBitset& bits, size_t position, bool value) -> void;
+
+// Read a single bit (out-of-range positions read as cleared)
+auto test_position(const PositionBitset& bits, size_t position) -> bool;
+
+// First cleared bit at or after `from`, scanning 64 bits at a time
+auto find_next_clear(const PositionBitset& bits, size_t from) -> std::optional<size_t>;
+
+// Last cleared bit at or before `from`, scanning 64 bits at a time
+auto find_prev_clear(const PositionBitset& bits, size_t from) -> std::optional<size_t>;
+
+// Start of the first run beginning after `position`
+auto find_next_run_start(const std::vector<size_t>& run_starts, size_t position)
+    -> std::optional<size_t>;
+
+// Start of the last run beginning before `position` (the current run's start when inside it)
+auto find_prev_run_start(const std::vector<size_t>& run_starts, size_t position)
+    -> std::optional<size_t>;
+
+// Parse ":1234", "1234", "path", "path:line" or "path:line:col"
+auto parse_goto_command(const std::string& command) -> std::optional<GotoTarget>;
+
+// Look up a file's lines by exact path, falling back to a path-suffix match
+auto find_file_lines(const LocationIndex& index, const std::string& file_path)
+    -> const std::vector<LineEntry>*;
+
+// Position of the warning closest to `line`, preferring later lines on ties
+auto find_nearest_line(const std::vector<LineEntry>& lines, int line) -> std::optional<size_t>;
+
+// Pure functions for FileLineIndex manipulation
+
+// Bucket every table row by path id, then by line (stable, so same-line warnings keep order)
+auto build_file_line_index(const WarningTable& table) -> FileLineIndex;
+
+// Warnings of one file with first_line <= line <= last_line: two binary searches
+auto warnings_in_lines(const FileLineIndex& index, std::uint32_t path_id, int first_line,
+                       int last_line) -> std::span<const LineWarning>;
+
+// Re-read one file's lines from `table` after they changed and re-sort only that file
+auto refresh_file_lines(FileLineIndex& index, const WarningTable& table, std::uint32_t path_id)
+    -> void;
+
+} // namespace nolint
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace nolint {
+
+// Run `process(begin, end)` over contiguous chunks of [0, count) and return the
+// per-chunk results in chunk order. Work below `min_chunk` items per thread runs
+// inline on the calling thread.
+template <typename Result, typename Process>
+auto process_in_chunks(size_t count, size_t min_chunk, Process process) -> std::vector<Result> {
+    size_t worker_count
+        = std::min<size_t>(std::max(1U, std::thread::hardware_concurrency()), count / min_chunk);
+    if (worker_count <= 1) {
+        std::vector<Result> results;
+        results.push_back(process(size_t{0}, count));
+        return results;
+    }
+
+    std::vector<Result> results(worker_count);
+    std::vector<std::thread> workers;
+    workers.reserve(worker_count);
+    size_t chunk_size = (count + worker_count - 1) / worker_count;
+
+    for (size_t w = 0; w < worker_count; ++w) {
+        size_t begin = std::min(count, w * chunk_size);
+        size_t end = std::min(count, begin + chunk_size);
+        workers.emplace_back(
+            [&results, &process, w, begin, end] { results[w] = process(begin, end); });
+    }
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    return results;
+}
+
+// Run `process(i)` for every i in [0, count) on up to `worker_count` threads
+// (the calling thread included) that pull indices from a shared counter, so a
+// slow item holds up one worker instead of a whole chunk. For I/O, where time
+// per item varies far more than for parsing.
+template <typename Process>
+auto process_each(size_t count, size_t worker_count, Process process) -> void {
+    std::atomic<size_t> next{0};
+    auto drain = [&next, &process, count] {
+        for (size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+            process(i);
+        }
+    };
+
+    worker_count = std::min(worker_count, count);
+    std::vector<std::thread> workers;
+    workers.reserve(worker_count > 0 ? worker_count - 1 : 0);
+    for (size_t w = 1; w < worker_count; ++w) {
+        workers.emplace_back(drain);
+    }
+    drain();
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+} // namespace nolint
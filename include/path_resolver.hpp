@@ -0,0 +1,68 @@
+#pragma once
+
+#include "string_pool.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+
+namespace nolint {
+
+// One canonical spelling per source file. clang-tidy output mixes absolute
+// paths, paths relative to several build directories and symlinked trees, so
+// one file can arrive under many spellings. Each spelling is resolved once:
+// stat() gives the file's (device, inode), the first spelling seen for an
+// inode pays for realpath(), and later spellings of that inode reuse its id.
+// Missing files are remembered too (negative cache) and keep their lexically
+// normalized spelling. Canonical paths under the working directory are kept
+// relative to it.
+//
+// Relative spellings are looked up under `base_directory` (the build directory
+// clang-tidy ran in) when one is given, otherwise under the working directory.
+class PathResolver {
+public:
+    explicit PathResolver(const std::filesystem::path& base_directory = {});
+
+    // Dense id shared by every spelling of the same file
+    auto file_id(const std::string& path) -> std::uint32_t;
+
+    // Canonical spelling of a file id
+    auto canonical_path(std::uint32_t id) const -> const std::string& {
+        return canonical_.names[id];
+    }
+
+    // Canonical spelling of `path`
+    auto resolve(const std::string& path) -> const std::string& {
+        return canonical_path(file_id(path));
+    }
+
+    // Distinct files seen so far
+    auto file_count() const -> size_t { return canonical_.names.size(); }
+
+    // Filesystem lookups made so far (one per distinct spelling)
+    auto stat_calls() const -> size_t { return stat_calls_; }
+
+private:
+    struct FileKey {
+        std::uint64_t device = 0;
+        std::uint64_t inode = 0;
+        auto operator==(const FileKey&) const -> bool = default;
+    };
+    struct FileKeyHash {
+        auto operator()(const FileKey& key) const -> size_t {
+            return std::hash<std::uint64_t>{}(key.inode * 31 + key.device);
+        }
+    };
+
+    auto display_path(const std::string& absolute) const -> std::string;
+
+    std::string working_directory_;       // Canonical, with a trailing '/'
+    std::filesystem::path base_directory_; // Absolute; empty = working directory
+    std::unordered_map<std::string, std::uint32_t> spellings_;
+    std::unordered_map<FileKey, std::uint32_t, FileKeyHash> inodes_;
+    StringPool canonical_;
+    size_t stat_calls_ = 0;
+};
+
+} // namespace nolint
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace nolint {
+
+// One node of the prefix trie: a character edge per child, and the rule whose
+// FROM ends here, if any
+struct PrefixTrieNode {
+    std::vector<std::pair<char, std::uint32_t>> children;
+    std::optional<std::uint32_t> rule;
+};
+
+// --map-prefix FROM=TO rules compiled into a character trie, so rewriting a
+// path is one walk that finds the longest matching FROM
+struct PrefixMap {
+    std::vector<PrefixTrieNode> nodes{PrefixTrieNode{}}; // nodes[0] is the root
+    std::vector<std::string> replacements;                // TO of each rule
+};
+
+// Pure functions for PrefixMap manipulation
+
+// Split "FROM=TO"; std::nullopt when there is no '=' or FROM is empty. A leading
+// "~/" in TO is expanded from $HOME, since the shell does not expand it after '='.
+auto parse_prefix_rule(std::string_view rule) -> std::optional<std::pair<std::string, std::string>>;
+
+// Add a rule; a later rule with the same FROM replaces the earlier one
+auto add_prefix_rule(PrefixMap& map, std::string_view from, std::string_view to) -> void;
+
+// `path` with its longest matching FROM replaced by TO, or std::nullopt when no
+// rule applies. FROM must end on a path component boundary, so /work/src does
+// not match /work/srcs/x.cpp.
+auto map_prefix(const PrefixMap& map, std::string_view path) -> std::optional<std::string>;
+
+} // namespace nolint
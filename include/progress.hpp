@@ -0,0 +1,88 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <thread>
+
+namespace nolint {
+
+// How progress is reported on stderr
+enum class ProgressFormat {
+    NONE,
+    LINE, // Single refreshing status line for terminals
+    JSON  // One JSON object per line for CI logs and tooling
+};
+
+// Counters bumped by the parser and file modifier while they run. Totals are
+// 0 when unknown (e.g. piped input). Relaxed atomics: readers only need a
+// recent value, not ordering with other memory.
+struct ProgressCounters {
+    std::atomic<std::uint64_t> bytes_done{0};
+    std::atomic<std::uint64_t> bytes_total{0};
+    std::atomic<std::uint64_t> warnings_done{0};
+    std::atomic<std::uint64_t> files_done{0};
+    std::atomic<std::uint64_t> files_total{0};
+};
+
+// Plain copy of the counters at one instant
+struct ProgressSnapshot {
+    std::uint64_t bytes_done = 0;
+    std::uint64_t bytes_total = 0;
+    std::uint64_t warnings_done = 0;
+    std::uint64_t files_done = 0;
+    std::uint64_t files_total = 0;
+    double elapsed_seconds = 0.0;
+};
+
+auto take_snapshot(const ProgressCounters& counters, double elapsed_seconds) -> ProgressSnapshot;
+
+// Percent complete from bytes, else files; -1 when no total is known
+auto progress_percent(const ProgressSnapshot& snapshot) -> double;
+
+// Seconds remaining at the current rate, or -1 when it cannot be estimated
+auto progress_eta_seconds(const ProgressSnapshot& snapshot) -> double;
+
+// "parse  42.0% | 120.5 MB/s | 35000 warnings (9000/s) | ETA 3s"
+auto format_progress_line(const std::string& phase, const ProgressSnapshot& snapshot)
+    -> std::string;
+
+// {"event":"progress","phase":"parse",...}
+auto format_progress_json(const std::string& phase, const ProgressSnapshot& snapshot,
+                          bool finished) -> std::string;
+
+// Parse "line", "json" or "none" (as given to --progress=); std::nullopt otherwise
+auto parse_progress_format(const std::string& value) -> std::optional<ProgressFormat>;
+
+// Reports one phase's counters from a background thread until destroyed.
+// With ProgressFormat::NONE it does nothing.
+class ProgressReporter {
+public:
+    ProgressReporter(std::string phase, const ProgressCounters& counters, ProgressFormat format,
+                     std::ostream& output);
+    ~ProgressReporter();
+
+    ProgressReporter(const ProgressReporter&) = delete;
+    auto operator=(const ProgressReporter&) -> ProgressReporter& = delete;
+
+private:
+    auto run() -> void;
+    auto report(bool finished) -> void;
+
+    std::string phase_;
+    const ProgressCounters& counters_;
+    ProgressFormat format_;
+    std::ostream& output_;
+    std::chrono::steady_clock::time_point start_;
+    std::mutex mutex_;
+    std::condition_variable stop_signal_;
+    bool stopping_ = false;
+    std::thread worker_;
+};
+
+} // namespace nolint
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "ui_model.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <istream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace nolint {
+
+// One slice of a run split across machines: shard index + 1 of count (as "i/N")
+struct ShardSpec {
+    std::uint32_t index = 0; // 0-based
+    std::uint32_t count = 1;
+};
+
+// What one shard did to one file
+struct ShardFileResult {
+    std::string path;
+    bool modified = false;
+    size_t suppressions = 0;
+};
+
+// What one shard did, written with --shard-result for merge-shards
+struct ShardResult {
+    ShardSpec shard;
+    size_t warnings = 0;
+    std::vector<ShardFileResult> files;
+};
+
+// Several shard results combined; files sorted by path
+struct MergedShards {
+    std::uint32_t shard_count = 0;                // N of the first result
+    std::vector<std::uint32_t> mismatched_counts; // Other Ns seen, ascending
+    std::vector<std::uint32_t> missing_shards;    // 0-based indices with no result
+    std::vector<std::uint32_t> duplicate_shards;
+    size_t warnings = 0;
+    std::vector<ShardFileResult> files;
+    std::vector<std::string> conflicts; // Paths claimed by more than one shard
+};
+
+// Pure functions for sharding
+
+// Parse "i/N" with 1 <= i <= N
+auto parse_shard_spec(std::string_view text) -> std::optional<ShardSpec>;
+
+// "i/N"
+auto format_shard_spec(ShardSpec shard) -> std::string;
+
+// Shard owning a file: stable_hash of its root-relative path modulo `count`, so
+// every machine assigns every file the same way and each shard owns whole files
+auto shard_of_path(std::string_view relative_path, std::uint32_t count) -> std::uint32_t;
+
+// `path` relative to `root` with '/' separators (relative paths are taken from
+// the current directory first), or the normalized absolute path if it lies
+// outside `root`. Checkouts in different places then hash files alike.
+auto shard_relative_path(std::string_view path, const std::filesystem::path& root)
+    -> std::string;
+
+// Warnings in files owned by `shard`, in input order; paths hash relative to `root`
+auto select_shard(const std::vector<Warning>& warnings, ShardSpec shard,
+                  const std::filesystem::path& root) -> std::vector<Warning>;
+
+// Nearest directory at or above `start` holding a .git entry (the git toplevel),
+// or empty if there is none. Reads the file system.
+auto find_repository_root(const std::filesystem::path& start) -> std::filesystem::path;
+
+// JSON lines: one {"event":"file",...} per file, then {"event":"shard",...}
+auto format_shard_result(const ShardResult& result) -> std::string;
+
+// Read what format_shard_result wrote; std::nullopt if the summary line is missing
+// or any line is malformed
+auto parse_shard_result(std::istream& input) -> std::optional<ShardResult>;
+
+// Combine shard results with one sort over all files. Missing and repeated
+// shards are judged against the first result's N; results with another N are
+// listed in mismatched_counts and not counted as shards.
+auto merge_shard_results(const std::vector<ShardResult>& results) -> MergedShards;
+
+// JSON lines: every file, then {"event":"merged",...}
+auto format_merged_shards(const MergedShards& merged) -> std::string;
+
+} // namespace nolint
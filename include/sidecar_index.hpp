@@ -0,0 +1,53 @@
+#pragma once
+
+#include "source_cache.hpp"
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+namespace nolint {
+
+// What a sidecar must match to be looked at: the file's path, size and
+// modification time. A stable_hash of the indexed lines is recorded when the
+// sidecar is written and checked while the lines are rebuilt on load.
+struct SidecarKey {
+    std::string path;
+    std::uint64_t size = 0;
+    std::int64_t modified = 0; // file_time_type ticks since its epoch
+};
+
+// Format version; bump when the layout changes so old sidecars are ignored
+constexpr std::uint32_t SIDECAR_VERSION = 1;
+
+// Pure functions for sidecar indexes.
+//
+// A sidecar persists one SourceFile's line offsets, the token spans of its
+// lexed prefix and the lexer state after it, so a later session can split
+// and highlight the file without scanning or lexing it again. The layout is a
+// fixed header followed by the path, the raw-string delimiter and three
+// 4-byte-aligned arrays (line offsets, per-line token starts, TokenSpans), read
+// back through mmap.
+
+// $XDG_CACHE_HOME/nolint/index, else ~/.cache/nolint/index (empty if neither is known)
+auto default_sidecar_directory() -> std::filesystem::path;
+
+// Key for a file as last read
+auto make_sidecar_key(const std::string& path, std::uintmax_t size,
+                      std::filesystem::file_time_type modified) -> SidecarKey;
+
+// Where the sidecar for `path` lives inside `directory`
+auto sidecar_path(const std::filesystem::path& directory, const std::string& path)
+    -> std::filesystem::path;
+
+// Fill `file` (lines, tokens, token_count, state) from a sidecar matching `key`.
+// Returns false, leaving `file` untouched, when there is none, it is stale, or
+// any line or token span falls outside `content`.
+auto load_sidecar_index(const std::filesystem::path& directory, const SidecarKey& key,
+                        std::string_view content, SourceFile& file) -> bool;
+
+// Write `file`'s lines and lexed prefix for `key` (atomically, via rename)
+auto save_sidecar_index(const std::filesystem::path& directory, const SidecarKey& key,
+                        const SourceFile& file) -> bool;
+
+} // namespace nolint
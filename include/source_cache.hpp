@@ -0,0 +1,115 @@
+#pragma once
+
+#include "cpp_lexer.hpp"
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace nolint {
+
+// One source file's lines and, lazily, the token spans of a prefix of them.
+// Lexing only ever extends the prefix, so a line is lexed once no matter how
+// often it is drawn.
+struct SourceFile {
+    std::vector<std::string> lines;
+    std::vector<std::vector<TokenSpan>> tokens; // tokens[i] for each lexed line i
+    size_t token_count = 0;                     // Spans across all of tokens
+    LexState state;                             // State after the last lexed line
+    std::uintmax_t size = 0;
+    std::filesystem::file_time_type modified;
+    bool sidecar_current = false; // Sidecar on disk already holds this lexed prefix
+};
+
+// Lex lines until the first `line_count` lines have spans
+auto ensure_lexed(SourceFile& file, size_t line_count) -> void;
+
+// Spans of a 0-based line, lexing up to it first (empty past the end)
+auto line_tokens(SourceFile& file, size_t line_index) -> const std::vector<TokenSpan>&;
+
+// Approximate heap bytes held by a cached file: text, line strings and token spans
+auto resident_bytes(const SourceFile& file) -> size_t;
+
+// Counters for --progress and the exit summary
+struct SourceCacheStats {
+    std::uint64_t hits = 0; // Lookups of a different file than the last one (not redraws)
+    std::uint64_t misses = 0; // Reads from disk, including reloads of changed files
+    std::uint64_t evictions = 0;
+    std::uint64_t sidecar_loads = 0; // Misses served from a sidecar index
+    size_t resident_bytes = 0;
+    size_t budget_bytes = 0; // 0 = unbounded
+    size_t files = 0;
+};
+
+// "cache  hits 950 | misses 50 (95.0% hit) | evicted 12 | 48.2 MB / 64.0 MB in 310 files"
+auto format_cache_stats_line(const SourceCacheStats& stats) -> std::string;
+
+// {"event":"cache","hits":950,...}
+auto format_cache_stats_json(const SourceCacheStats& stats) -> std::string;
+
+// Source files read for display, kept across frames. A file is re-read when
+// its size or modification time changes. With a byte budget, the least
+// recently used files are evicted once the budget is exceeded; pinned files
+// (those with pending edits) are only evicted after every unpinned one, and
+// the file just requested never is. With a sidecar directory, files are split
+// and highlighted from sidecar indexes left by earlier sessions, and evicted or
+// remaining files write theirs back.
+class SourceCache {
+public:
+    explicit SourceCache(size_t budget_bytes = 0, std::filesystem::path sidecar_directory = {})
+        : budget_bytes_(budget_bytes), sidecar_directory_(std::move(sidecar_directory)) {}
+    ~SourceCache();
+
+    SourceCache(const SourceCache&) = delete;
+    auto operator=(const SourceCache&) -> SourceCache& = delete;
+
+    // Cached file, or nullptr if it cannot be read
+    auto get(const std::string& path) -> std::shared_ptr<SourceFile>;
+
+    // Read every listed file that is missing or stale as one batch, so the
+    // views find them resident. Counted as misses, and subject to the budget.
+    auto prefetch(const std::vector<std::string>& paths) -> void;
+
+    // Forget one file so the next get() reads it again
+    auto invalidate(const std::string& path) -> void;
+
+    // Keep a file resident ahead of unpinned ones (it need not be cached yet)
+    auto pin(const std::string& path) -> void { pinned_.insert(path); }
+    auto unpin(const std::string& path) -> void { pinned_.erase(path); }
+
+    auto stats() const -> SourceCacheStats;
+
+private:
+    struct Entry {
+        std::shared_ptr<SourceFile> file;
+        std::list<std::string>::iterator recency; // Position in lru_
+        size_t bytes = 0;                         // Last accounted resident_bytes
+    };
+
+    auto load(const std::string& path, std::uintmax_t size,
+              std::filesystem::file_time_type modified, std::string_view content)
+        -> std::shared_ptr<SourceFile>;
+    auto insert(const std::string& path, std::shared_ptr<SourceFile> file) -> void;
+    auto persist(const std::string& path, const SourceFile& file) -> void;
+    auto erase(std::unordered_map<std::string, Entry>::iterator it) -> void;
+    auto evict_over_budget(const std::string& keep) -> void;
+
+    size_t budget_bytes_;
+    std::filesystem::path sidecar_directory_; // Empty = no sidecars
+    size_t resident_bytes_ = 0;
+    std::unordered_map<std::string, Entry> files_;
+    std::list<std::string> lru_; // Most recently used first
+    std::unordered_set<std::string> pinned_;
+    std::string last_lookup_; // Redraws look up the same file again; count it once
+    std::uint64_t hits_ = 0;
+    std::uint64_t misses_ = 0;
+    std::uint64_t evictions_ = 0;
+    std::uint64_t sidecar_loads_ = 0;
+};
+
+} // namespace nolint
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace nolint {
+
+// 64-bit FNV-1a. Unlike std::hash it is the same on every platform, build and
+// run, so it can key data that outlives the process or crosses machines.
+// Pass a previous result as `hash` to continue hashing across pieces.
+constexpr auto stable_hash(std::string_view text, std::uint64_t hash = 14695981039346656037ULL)
+    -> std::uint64_t {
+    for (char c : text) {
+        hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+} // namespace nolint
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace nolint {
+
+// Dense ids for repeated strings (file paths, unknown check names). Ids are
+// assigned in first-seen order and index into `names`.
+struct StringPool {
+    std::vector<std::string> names;
+    std::unordered_map<std::string, std::uint32_t> ids;
+};
+
+// Pure functions for StringPool manipulation
+
+// Id for `name`, adding it to the pool on first sight
+auto intern(StringPool& pool, std::string_view name) -> std::uint32_t;
+
+// Id for `name` if it is already in the pool
+auto find_interned(const StringPool& pool, std::string_view name) -> std::optional<std::uint32_t>;
+
+} // namespace nolint
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+namespace nolint {
+
+// ASCII lowercase copy of a query (done once per search, not per warning)
+auto fold_case(std::string_view text) -> std::string;
+
+// Case-insensitive substring search over the original bytes, no copies.
+// `lower_needle` must already be folded with fold_case. Uses an SSE2
+// first/last-byte prefilter when available, scalar search otherwise.
+auto contains_case_insensitive(std::string_view haystack, std::string_view lower_needle) -> bool;
+
+// Position of the first byte at or after `from` that folds to `lower_byte`,
+// or std::string_view::npos. Scans 16 bytes per step with SSE2 when available.
+auto find_folded_byte(std::string_view haystack, size_t from, char lower_byte) -> size_t;
+
+} // namespace nolint
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "ui_model.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace nolint {
+
+// How `nolint split` divides warnings between reviewers
+enum class SplitMode {
+    DIRECTORY, // Whole directories per reviewer, directories spread to even out counts
+    COUNT      // Equal consecutive runs of warnings in input order
+};
+
+// One decision in a journal
+struct JournalEntry {
+    std::uint64_t fingerprint = 0; // warning_fingerprint of the decided warning
+    NolintStyle style = NolintStyle::NONE;
+};
+
+// Decisions keyed by warning fingerprint, sorted by fingerprint with no repeats,
+// so journals from independent sessions merge in one pass
+using DecisionJournal = std::vector<JournalEntry>;
+
+// A journal's decisions for one set of warnings
+struct JournalMatch {
+    std::unordered_map<size_t, NolintStyle> decisions; // By warning index
+    size_t matched_entries = 0; // Journal entries that matched at least one warning
+};
+
+// Several journals combined
+struct MergedJournal {
+    DecisionJournal journal;
+    std::vector<std::uint64_t> conflicts; // Fingerprints decided differently, ascending
+};
+
+// Pure functions for splitting triage between reviewers and merging their journals
+
+// Identity of a warning across sessions and machines: stable_hash of its path,
+// location, check and message as reported
+auto warning_fingerprint(const Warning& warning) -> std::uint64_t;
+
+// Fingerprint of every warning, taken once at ingest. Editing a file moves its
+// warnings' lines but not their identity, so journals use these throughout.
+auto warning_fingerprints(const std::vector<Warning>& warnings) -> std::vector<std::uint64_t>;
+
+// "directory" or "count"
+auto parse_split_mode(std::string_view value) -> std::optional<SplitMode>;
+
+// Warning indices for each of `reviewers` sessions, each in input order. Every
+// warning lands in exactly one session.
+auto split_reviewers(const std::vector<Warning>& warnings, size_t reviewers, SplitMode mode)
+    -> std::vector<std::vector<size_t>>;
+
+// clang-tidy output for the given warnings that WarningParser reads back as the
+// same warnings (function size notes included)
+auto format_warning_lines(const std::vector<Warning>& warnings, const std::vector<size_t>& indices)
+    -> std::string;
+
+// Journal of a session's decisions, given each warning's ingest fingerprint.
+// Warnings that share a fingerprint (a header reported by several translation
+// units) keep the first warning's decision.
+auto make_journal(const std::vector<std::uint64_t>& fingerprints,
+                  const std::unordered_map<size_t, NolintStyle>& decisions) -> DecisionJournal;
+
+// Text form: a header line, then "<16 hex digits> <STYLE>" per entry
+auto format_journal(const DecisionJournal& journal) -> std::string;
+
+// Read what format_journal wrote; std::nullopt on a malformed line. Entries out
+// of order are sorted, and a repeated fingerprint keeps its last entry.
+auto parse_journal(std::istream& input) -> std::optional<DecisionJournal>;
+
+// k-way merge of sorted journals in one pass. Journals that agree merge
+// silently; a warning decided differently becomes NONE (left unsuppressed) and
+// is listed in conflicts, so the result never depends on argument order.
+auto merge_journals(const std::vector<DecisionJournal>& journals) -> MergedJournal;
+
+// Decisions for the warnings with these fingerprints taken from a journal;
+// warnings it doesn't mention stay undecided. matched_entries below the
+// journal's size means some decisions found no warning.
+auto apply_journal(const std::vector<std::uint64_t>& fingerprints, const DecisionJournal& journal)
+    -> JournalMatch;
+
+} // namespace nolint
@@ -1,6 +1,14 @@
 #pragma once
 
+#include "check_trie.hpp"
+#include "decision_history.hpp"
+#include "filter_cache.hpp"
+#include "line_map.hpp"
+#include "navigation.hpp"
+#include "warning_table.hpp"
+#include <memory>
 #include <optional>
+#include <span>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -26,16 +34,6 @@ enum class NolintStyle {
     NOLINT_BLOCK    // Block: // NOLINTBEGIN(type) ... // NOLINTEND(type)
 };
 
-// Statistics for a warning type
-struct WarningTypeStats {
-    std::string type;
-    int total_count = 0;
-    int nolint_count = 0;
-    int nolintnextline_count = 0;
-    int nolint_block_count = 0;
-    int unsuppressed_count = 0;
-};
-
 // Input events we handle
 enum class InputEvent {
     QUIT,
@@ -57,18 +55,43 @@ enum class InputEvent {
     VIM_K,         // k - move up
     VIM_G,         // lowercase g (for gg command)
     VIM_CAPITAL_G, // capital G (go to end)
+    NEXT_UNDECIDED, // n - jump to next warning without a decision
+    PREV_UNDECIDED, // N - jump to previous warning without a decision
+    NEXT_FILE,      // ] - jump to first warning of the next file
+    PREV_FILE,      // [ - jump to first warning of the current/previous file
+    NEXT_CHECK,     // } - jump to first warning of the next check type run
+    PREV_CHECK,     // { - jump to first warning of the current/previous check type run
+    GOTO,           // : - open the go-to prompt
+    UNDO,           // u - revert the last decision change
+    REDO,           // r - reapply the last undone decision change
+    SET_NONE,           // 0 - remove the suppression (statistics view: whole selected group)
+    SET_NOLINT,         // 1 - NOLINT (statistics view: whole selected group)
+    SET_NOLINTNEXTLINE, // 2 - NOLINTNEXTLINE (statistics view: whole selected group)
+    SET_NOLINT_BLOCK,   // 3 - NOLINT_BLOCK where function size is known
+    CYCLE_SORT,         // s - next sort column in statistics view
     UNKNOWN
 };
 
 // Complete UI state (immutable model)
 struct UIModel {
     // Core data
-    std::vector<Warning> warnings;
-    std::vector<size_t> filtered_warning_indices; // Indices of warnings that match current filter
+    std::vector<Warning> warnings; // Replace through replace_warnings, not by assignment
+    std::uint64_t warnings_generation = 0; // Bumped whenever warnings is replaced
+    std::uint64_t indexed_generation = 0;  // warnings_generation the table and indexes describe
+    std::shared_ptr<const WarningTable> table; // Columnar copy of warnings for full-table passes
+    std::shared_ptr<const FileLineIndex> line_index; // All warnings by file and line
+    // Indices of warnings that match the current filter, shared with the filter cache
+    std::shared_ptr<const std::vector<size_t>> filtered_warning_indices
+        = std::make_shared<const std::vector<size_t>>();
     size_t current_index = 0;                     // Index in filtered_warning_indices, not warnings
+    PositionBitset decided_positions;             // Bit i set when filtered warning i is decided
+    std::shared_ptr<const RunIndex> runs;         // File/type run starts in filtered order
+    std::shared_ptr<const LocationIndex> locations; // Per-file sorted lines for go-to lookups
 
     // User decisions
     std::unordered_map<size_t, NolintStyle> decisions; // warning index -> style
+    std::uint64_t decisions_version = 0; // Bumped by every decision change after setup
+    DecisionHistory history;                           // Undo/redo of decision changes
 
     // File tracking
     std::unordered_set<std::string> modified_files; // Files that will be changed
@@ -80,10 +103,16 @@ struct UIModel {
     bool dry_run = false;        // Preview mode - don't actually save files
     bool in_search_mode = false; // True when user is entering search filter
     std::string search_filter;
+    FilterCache filter_cache;   // Recent filter results and per-filter cursor positions
+    std::string status_message; // Transient feedback (e.g. failed go-to), cleared on next input
 
     // Statistics page state
-    size_t statistics_selected_index = 0;      // Which warning type is selected in statistics view
-    std::vector<std::string> statistics_types; // Ordered list of warning types for selection
+    size_t statistics_selected_index = 0; // Which row is selected in statistics view
+    std::vector<size_t> statistics_rows;  // Visible check_trie nodes, in display order
+    CheckTrie check_trie;                 // Check categories with counts kept current by decisions
+    StatisticsSort statistics_sort = StatisticsSort::TOTAL;
+    size_t statistics_scroll_offset = 0; // First statistics row on screen
+    size_t statistics_page_rows = 20;    // Rows that fit on screen, set by the view
 
     // Full function view state
     bool in_function_view = false;       // True when viewing full function
@@ -91,15 +120,15 @@ struct UIModel {
     bool expecting_second_g = false;     // For 'gg' command detection
 
     // Helper methods
-    auto total_warnings() const -> size_t { return filtered_warning_indices.size(); }
+    auto total_warnings() const -> size_t { return filtered_warning_indices->size(); }
     auto has_warnings() const -> bool { return !warnings.empty(); }
 
     auto current_warning() const -> const Warning& {
-        return warnings[filtered_warning_indices[current_index]];
+        return warnings[(*filtered_warning_indices)[current_index]];
     }
 
     auto current_warning_original_index() const -> size_t {
-        return filtered_warning_indices[current_index];
+        return (*filtered_warning_indices)[current_index];
     }
 
     auto get_decision(size_t original_warning_index) const -> NolintStyle {
@@ -113,14 +142,58 @@ struct UIModel {
     }
 };
 
-// Filter warnings based on search string
-auto filter_warnings(const std::vector<Warning>& warnings, const std::string& filter)
-    -> std::vector<size_t>;
-
-// Calculate statistics for all warning types with NOLINT status
-auto calculate_warning_statistics(const std::vector<Warning>& warnings,
-                                  const std::unordered_map<size_t, NolintStyle>& decisions)
-    -> std::vector<WarningTypeStats>;
+// Filter warnings based on search string, matched case-insensitively against
+// "file_path type message". Each distinct path and check name is searched once
+// rather than once per warning.
+auto filter_warnings(const WarningTable& table, const std::string& filter) -> std::vector<size_t>;
+
+// Build the decided bitset aligned with filtered_warning_indices
+auto build_decided_positions(const std::vector<size_t>& filtered_warning_indices,
+                             const std::unordered_map<size_t, NolintStyle>& decisions)
+    -> PositionBitset;
+
+// Build file and check type run boundaries for the filtered order
+auto build_run_index(const WarningTable& table, const std::vector<size_t>& filtered_warning_indices)
+    -> RunIndex;
+
+// Build the per-file line index used to resolve go-to locations
+auto build_location_index(const std::vector<Warning>& warnings,
+                          const std::vector<size_t>& filtered_warning_indices) -> LocationIndex;
+
+// Jump to ":N" (Nth filtered warning) or "path:line" (nearest warning at that location)
+auto goto_location(UIModel model, const std::string& command) -> UIModel;
+
+// Swap in a different warning list and reapply the current filter. Every index
+// derived from the old list (table, line and navigation indexes, filter cache,
+// statistics) is rebuilt, even when the new list has the same length.
+// Decisions are kept as they are, by warning index.
+auto replace_warnings(UIModel model, std::vector<Warning> warnings) -> UIModel;
+
+// Swap in a whole set of decisions (e.g. loaded from a journal) and mark every
+// decided bitset and statistics count derived from the old ones as stale.
+auto replace_decisions(UIModel model, std::unordered_map<size_t, NolintStyle> decisions)
+    -> UIModel;
+
+// Apply a search filter and rebuild everything derived from filtered_warning_indices.
+// Recently used filters are served from filter_cache and restore their cursor position.
+// "~pattern" filters use fuzzy matching and order the results by score.
+auto apply_filter(UIModel model, const std::string& filter) -> UIModel;
+
+// Warnings in the current warning's file with first_line <= line <= last_line
+// (including the current one), for annotating the context window. Empty until
+// apply_filter has built the line index.
+auto neighbouring_warnings(const UIModel& model, int first_line, int last_line)
+    -> std::span<const LineWarning>;
+
+// Move one file's warnings to the lines `map` gives them after the file was
+// edited outside the session. Decisions stay with their warnings; only that
+// file's entries in the line and location indexes are touched.
+auto rebase_file_warnings(UIModel model, const std::string& file_path, const LineMap& map)
+    -> UIModel;
+
+// Apply `style` to every warning whose check is in the subtree of `node` as one
+// undoable action. NOLINT_BLOCK skips warnings without a known function size.
+auto apply_bulk_decision(UIModel model, size_t node, NolintStyle style) -> UIModel;
 
 // Pure update function - the heart of Model-View-Update pattern
 auto update(UIModel model, InputEvent event) -> UIModel;
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "line_map.hpp"
+#include "path_resolver.hpp"
+#include "ui_model.hpp"
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace nolint {
+
+// One entry of compile_commands.json
+struct CompileCommand {
+    std::string directory;              // Working directory of the compile
+    std::string file;                   // Source file, possibly relative to directory
+    std::vector<std::string> arguments; // From "arguments", or "command" split like sh
+    std::string output;                 // "output" when present
+};
+
+// Which translation units have to be rerun for a set of modified files
+struct UnitSelection {
+    std::vector<size_t> units;                // Indices into the compile commands, one per source
+    std::vector<std::string> uncovered_files; // Modified files no unit was found to include
+    size_t missing_depfiles = 0;              // Units whose headers are unknown (no depfile)
+};
+
+// Outcome of re-running clang-tidy after applying suppressions
+struct VerifyReport {
+    bool success = false; // compile_commands.json was read
+    std::string error_message;
+    size_t translation_units = 0;
+    std::vector<std::string> failed_units;    // Sources clang-tidy failed on (signal, exit != 0)
+    std::vector<std::string> uncovered_files; // Modified files that could not be checked
+    std::vector<Warning> survivors;           // Suppressed warnings clang-tidy still reports
+};
+
+// How to run clang-tidy for verification
+struct VerifyOptions {
+    std::filesystem::path build_directory; // Holds compile_commands.json (-p)
+    std::string clang_tidy = "clang-tidy";
+    size_t worker_count = 1;
+};
+
+// Pure functions for post-apply verification
+
+// Parse a compile_commands.json document; std::nullopt if it is not a JSON
+// array of objects with "directory" and "file"
+auto parse_compile_commands(std::string_view json) -> std::optional<std::vector<CompileCommand>>;
+
+// Split a command line the way sh would (quotes and backslashes, no expansion)
+auto split_command_line(std::string_view command) -> std::vector<std::string>;
+
+// Depfiles the compiler may have written for a command: the -MF argument, else
+// the object file with its extension replaced by .d and with .d appended
+auto depfile_candidates(const CompileCommand& command) -> std::vector<std::string>;
+
+// Prerequisites listed in a Make-syntax depfile, in order of appearance
+auto parse_depfile(std::string_view text) -> std::vector<std::string>;
+
+// Every warning given a suppression in a modified file, moved to the line it
+// occupies after the edit according to that file's LineMap
+auto verification_targets(const std::vector<Warning>& warnings,
+                          const std::unordered_map<size_t, NolintStyle>& decisions,
+                          const std::unordered_map<std::string, LineMap>& line_maps)
+    -> std::vector<Warning>;
+
+// Targets that clang-tidy reported again at the same file, line and check
+auto surviving_targets(const std::vector<Warning>& targets, const std::vector<Warning>& rerun)
+    -> std::vector<Warning>;
+
+// I/O
+
+// Units whose source is a modified file or whose depfile lists one. Depfiles are
+// read in one batch and every path goes through `paths`, so each spelling of a
+// shared header is resolved once.
+auto select_translation_units(const std::vector<CompileCommand>& commands,
+                              const std::vector<std::string>& modified_files, PathResolver& paths)
+    -> UnitSelection;
+
+// Rerun clang-tidy, limited to the targets' checks, on the units that include a
+// modified file (in parallel) and report which targets survive
+auto verify_suppressions(const VerifyOptions& options, const std::vector<Warning>& targets,
+                         const std::vector<std::string>& modified_files) -> VerifyReport;
+
+} // namespace nolint
@@ -1,36 +1,66 @@
 #pragma once
 
+#include "path_resolver.hpp"
+#include "prefix_map.hpp"
+#include "progress.hpp"
 #include "ui_model.hpp"
+#include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
-#include <optional>
-#include <regex>
 
 namespace nolint {
 
+// A warning line located by the first parse phase. Offsets within the line
+// are relative to line_offset; nothing is decoded or copied yet.
+struct DiagnosticSpan {
+    size_t line_offset = 0;
+    size_t line_length = 0;
+    size_t path_length = 0;
+    size_t message_offset = 0;
+    size_t message_length = 0;
+    size_t type_offset = 0;
+    size_t type_length = 0;
+};
+
 class WarningParser {
 public:
     // Parse clang-tidy output into warnings
     auto parse(const std::string& clang_tidy_output) -> std::vector<Warning>;
-    
+
     // Parse from input stream
     auto parse(std::istream& input) -> std::vector<Warning>;
 
+    // Report bytes consumed and warnings found to `progress` while parsing (nullptr = off)
+    auto set_progress(ProgressCounters* progress) -> void { progress_ = progress; }
+
+    // Rewrite every file path to its canonical spelling after decoding (nullptr = off)
+    auto set_path_resolver(PathResolver* resolver) -> void { resolver_ = resolver; }
+
+    // Replace path prefixes (e.g. a container's /work/src) before canonicalizing (nullptr = off)
+    auto set_prefix_map(const PrefixMap* prefix_map) -> void { prefix_map_ = prefix_map; }
+
+    // Phase 1: find every line of the form
+    //   file.cpp:line:col: warning: message [warning-type]
+    // with one pass of substring searches for "warning:", recording spans only
+    auto scan(std::string_view output) -> std::vector<DiagnosticSpan>;
+
+    // Phase 2: build Warnings from spans, including the function size from a
+    // following "note: N lines including ..." for readability-function-size.
+    // Spans are independent, so large inputs are decoded in parallel chunks.
+    auto decode(std::string_view output, const std::vector<DiagnosticSpan>& spans)
+        -> std::vector<Warning>;
+
 private:
-    // Regex pattern for clang-tidy warnings
-    // Format: file.cpp:line:col: warning: message [warning-type]
-    const std::regex warning_pattern_{
-        R"(^([^:]+):(\d+):(\d+):\s+warning:\s+(.+?)\s+\[([^\]]+)\]$)"
-    };
-    
-    // Regex pattern for note lines about function size
-    // Format: file.cpp:line:col: note: 35 lines including whitespace and comments...
-    const std::regex note_pattern_{
-        R"(^[^:]+:\d+:\d+:\s+note:\s+(\d+)\s+lines\s+including.*$)"
-    };
-    
-    // Parse a single line that might be a warning
-    auto parse_line(const std::string& line) -> std::optional<Warning>;
+    ProgressCounters* progress_ = nullptr;
+    PathResolver* resolver_ = nullptr;
+    const PrefixMap* prefix_map_ = nullptr;
 };
 
-} // namespace nolint
\ No newline at end of file
+// Match one line against the warning format (spans relative to the line)
+auto match_warning_line(std::string_view line) -> std::optional<DiagnosticSpan>;
+
+// Function size from a note line about readability-function-size, if it is one
+auto match_function_size_note(std::string_view line) -> std::optional<int>;
+
+} // namespace nolint
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "check_registry.hpp"
+#include "string_pool.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace nolint {
+
+struct Warning;
+
+// Warnings stored column by column. Paths are interned, check names map to
+// CheckIds (compile-time ids for known checks), and
+// messages are packed into one buffer, so full-table passes (statistics,
+// filtering, run detection) walk a few contiguous arrays instead of chasing
+// three heap strings per warning. Row i matches warnings[i] it was built from.
+struct WarningTable {
+    StringPool paths;
+    CheckRegistry checks;
+    std::vector<std::uint32_t> path_ids;
+    std::vector<CheckId> type_ids;
+    std::vector<int> lines;
+    std::vector<int> columns;
+    std::vector<int> function_lines;     // NO_FUNCTION_LINES when absent
+    std::vector<size_t> message_offsets; // size() + 1 entries into message_text
+    std::string message_text;
+
+    auto size() const -> size_t { return path_ids.size(); }
+};
+
+constexpr int NO_FUNCTION_LINES = -1;
+
+// Read-only view of one table row with the same fields as Warning
+struct WarningRow {
+    const WarningTable* table = nullptr;
+    size_t index = 0;
+
+    auto file_path() const -> const std::string& {
+        return table->paths.names[table->path_ids[index]];
+    }
+    auto type() const -> std::string_view {
+        return check_name(table->checks, table->type_ids[index]);
+    }
+    auto line_number() const -> int { return table->lines[index]; }
+    auto column() const -> int { return table->columns[index]; }
+    auto message() const -> std::string_view {
+        return std::string_view(table->message_text)
+            .substr(table->message_offsets[index],
+                    table->message_offsets[index + 1] - table->message_offsets[index]);
+    }
+    auto function_lines() const -> std::optional<int> {
+        int lines = table->function_lines[index];
+        return (lines == NO_FUNCTION_LINES) ? std::nullopt : std::optional<int>(lines);
+    }
+};
+
+// Pure functions for WarningTable manipulation
+
+// Build the columnar form of `warnings`
+auto build_warning_table(const std::vector<Warning>& warnings) -> WarningTable;
+
+auto warning_row(const WarningTable& table, size_t index) -> WarningRow;
+
+} // namespace nolint
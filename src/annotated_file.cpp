@@ -1,10 +1,41 @@
 #include "annotated_file.hpp"
 #include <algorithm>
+#include <cerrno>
+#include <fcntl.h>
+#include <filesystem>
 #include <fstream>
 #include <sstream>
+#include <sys/stat.h>
+#include <unistd.h>
 
 namespace nolint {
 
+namespace {
+
+// Write all of `content` to `fd`; data reaches the device before this returns
+auto write_and_sync(int fd, const std::string& content) -> bool {
+    bool ok = true;
+    for (size_t done = 0; ok && done < content.size();) {
+        auto count = ::write(fd, content.data() + done, content.size() - done);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        ok = count > 0;
+        done += ok ? static_cast<size_t>(count) : 0;
+    }
+    return ok && ::fsync(fd) == 0;
+}
+
+// Mode open(O_CREAT, 0666) would give a new file. umask() can only be read by
+// setting it, so it is read once at startup, before any thread could create a file.
+const mode_t NEW_FILE_MODE = [] {
+    mode_t mask = ::umask(0);
+    ::umask(mask);
+    return static_cast<mode_t>(0666 & ~mask);
+}();
+
+} // namespace
+
 auto create_annotated_file(const std::vector<std::string>& lines) -> AnnotatedFile {
     AnnotatedFile file;
     file.lines.reserve(lines.size());
@@ -133,17 +164,69 @@ auto render_annotated_file(const AnnotatedFile& file) -> std::vector<std::string
 }
 
 auto save_annotated_file(const AnnotatedFile& file, const std::string& file_path) -> bool {
-    std::ofstream output_file(file_path);
-    if (!output_file) {
-        return false;
+    return write_lines_atomically(render_annotated_file(file), file_path);
+}
+
+auto write_lines_atomically(const std::vector<std::string>& lines, const std::string& file_path)
+    -> bool {
+    namespace fs = std::filesystem;
+
+    std::string content;
+    for (const auto& line : lines) {
+        content += line;
+        content += '\n';
     }
 
-    auto rendered_lines = render_annotated_file(file);
-    for (const auto& line : rendered_lines) {
-        output_file << line << '\n';
+    // Save through symlinks: replace the file the link points at, not the link
+    std::error_code error;
+    fs::path target = file_path;
+    if (fs::is_symlink(fs::symlink_status(target, error))) {
+        target = fs::canonical(target, error);
+        if (error) {
+            return false;
+        }
+    }
+
+    struct stat original {};
+    bool exists = ::stat(target.c_str(), &original) == 0;
+
+    // A rename would give this path a new inode and split it from its other hard
+    // links, so hard-linked files are rewritten in place instead
+    if (exists && original.st_nlink > 1) {
+        int fd = ::open(target.c_str(), O_WRONLY | O_TRUNC | O_CLOEXEC);
+        if (fd < 0) {
+            return false;
+        }
+        bool ok = write_and_sync(fd, content);
+        return (::close(fd) == 0) && ok;
     }
 
-    return output_file.good();
+    // A unique temporary beside the target: concurrent saves of one file never
+    // share it, and the final rename stays on one filesystem
+    std::string temp_name = ".";
+    temp_name += target.filename().string();
+    temp_name += ".nolint.XXXXXX";
+    auto pattern = target.parent_path() / temp_name;
+    std::string temp_path = pattern.string();
+    int fd = ::mkstemp(temp_path.data());
+    if (fd < 0) {
+        return false;
+    }
+    ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+
+    // mkstemp creates the file 0600; keep the original's mode (umask applied for new files)
+    bool ok = ::fchmod(fd, exists ? (original.st_mode & 07777) : NEW_FILE_MODE) == 0;
+    ok = ok && write_and_sync(fd, content);
+    ok = (::close(fd) == 0) && ok;
+    if (ok) {
+        fs::rename(temp_path, target, error);
+        ok = !error;
+    }
+    if (!ok) {
+        std::error_code ignored;
+        fs::remove(temp_path, ignored);
+    }
+    return ok;
 }
 
 auto extract_indentation(const std::string& line) -> std::string {
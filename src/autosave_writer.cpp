@@ -0,0 +1,243 @@
+#include "autosave_writer.hpp"
+#include "annotated_file.hpp"
+#include "batch_io.hpp"
+#include <algorithm>
+
+namespace nolint {
+
+namespace {
+
+auto same_decisions(const FileDecisions& a, const FileDecisions& b) -> bool {
+    return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](const auto& x, const auto& y) {
+        return x.second == y.second && x.first.line_number == y.first.line_number
+               && x.first.type == y.first.type && x.first.function_lines == y.first.function_lines;
+    });
+}
+
+// A file that cannot be read (missing, a directory) is never written or reverted
+auto read_lines(const std::string& file_path) -> std::optional<std::vector<std::string>> {
+    auto contents = read_files({file_path}, 1);
+    if (!contents.front()) {
+        return std::nullopt;
+    }
+    return split_lines(*contents.front());
+}
+
+} // namespace
+
+auto group_warning_indices_by_file(const std::vector<Warning>& warnings)
+    -> std::unordered_map<std::string, std::vector<size_t>> {
+    std::unordered_map<std::string, std::vector<size_t>> grouped;
+    for (size_t i = 0; i < warnings.size(); ++i) {
+        grouped[warnings[i].file_path].push_back(i);
+    }
+    return grouped;
+}
+
+auto collect_file_decisions(const std::vector<Warning>& warnings,
+                            const std::unordered_map<size_t, NolintStyle>& decisions,
+                            const std::vector<size_t>& file_warning_indices) -> FileDecisions {
+    FileDecisions file_decisions;
+    for (size_t index : file_warning_indices) {
+        auto decision_it = decisions.find(index);
+        if (decision_it != decisions.end() && decision_it->second != NolintStyle::NONE) {
+            file_decisions.emplace_back(warnings[index], decision_it->second);
+        }
+    }
+    return file_decisions;
+}
+
+AutosaveWriter::AutosaveWriter(std::chrono::milliseconds coalesce_delay)
+    : coalesce_delay_(coalesce_delay), worker_([this] { run(); }) {}
+
+AutosaveWriter::~AutosaveWriter() {
+    {
+        std::lock_guard lock(mutex_);
+        stopping_ = true;
+        flush_requested_ = true;
+    }
+    wake_.notify_all();
+    worker_.join();
+}
+
+auto AutosaveWriter::submit(const std::string& file_path, FileDecisions decisions) -> void {
+    {
+        std::lock_guard lock(mutex_);
+        pending_[file_path]
+            = Pending{std::move(decisions), std::chrono::steady_clock::now() + coalesce_delay_};
+    }
+    wake_.notify_all();
+}
+
+auto AutosaveWriter::flush() -> Result {
+    std::unique_lock lock(mutex_);
+    wait_until_idle(lock);
+
+    // Files written back to their original contents (all decisions cleared, or
+    // restored before an external edit) are no longer modified
+    Result result = result_;
+    std::erase_if(result.written_files, [this](const std::string& file_path) {
+        auto state_it = files_.find(file_path);
+        return state_it == files_.end() || !state_it->second->written;
+    });
+    return result;
+}
+
+auto AutosaveWriter::revert() -> Result {
+    // File states are only touched by the caller while the worker is idle, and
+    // the lock stays held so no write can start in between
+    std::unique_lock lock(mutex_);
+    wait_until_idle(lock);
+    Result reverted;
+    for (auto& [file_path, state] : files_) {
+        if (!state->written) {
+            continue;
+        }
+        if (write_lines_atomically(*state->original_lines, file_path)) {
+            state->written = false;
+            state->written_decisions.clear();
+            reverted.written_files.push_back(file_path);
+        } else {
+            reverted.failed_files.push_back(file_path);
+        }
+    }
+    return reverted;
+}
+
+auto AutosaveWriter::restore_original(const std::string& file_path)
+    -> std::optional<std::vector<std::string>> {
+    std::unique_lock lock(mutex_);
+    wait_until_idle(lock);
+    auto state_it = files_.find(file_path);
+    if (state_it == files_.end()) {
+        return std::nullopt;
+    }
+    auto& state = *state_it->second;
+    if (state.written && write_lines_atomically(*state.original_lines, file_path)) {
+        state.written = false;
+        state.written_decisions.clear();
+    }
+    return state.original_lines;
+}
+
+auto AutosaveWriter::rebase(const std::string& file_path) -> void {
+    std::unique_lock lock(mutex_);
+    wait_until_idle(lock);
+    files_.erase(file_path);
+}
+
+auto AutosaveWriter::wait_until_idle(std::unique_lock<std::mutex>& lock) -> void {
+    flush_requested_ = true;
+    wake_.notify_all();
+    idle_.wait(lock, [this] { return pending_.empty() && !busy_; });
+    flush_requested_ = false;
+}
+
+auto AutosaveWriter::run() -> void {
+    std::unique_lock lock(mutex_);
+
+    while (true) {
+        wake_.wait(lock, [this] { return stopping_ || !pending_.empty() || flush_requested_; });
+
+        if (pending_.empty()) {
+            idle_.notify_all();
+            if (stopping_) {
+                return;
+            }
+            // Flush with nothing pending - wait for the next submission
+            wake_.wait(lock, [this] { return stopping_ || !pending_.empty(); });
+            continue;
+        }
+
+        // Wait for the earliest deadline unless a flush wants everything now
+        auto now = std::chrono::steady_clock::now();
+        auto earliest = std::min_element(pending_.begin(), pending_.end(),
+                                         [](const auto& a, const auto& b) {
+                                             return a.second.due < b.second.due;
+                                         });
+        if (!flush_requested_ && earliest->second.due > now) {
+            wake_.wait_until(lock, earliest->second.due);
+            continue;
+        }
+
+        // Take every due entry (all of them when flushing) and write outside the lock
+        std::vector<std::pair<std::string, FileDecisions>> batch;
+        for (auto it = pending_.begin(); it != pending_.end();) {
+            if (flush_requested_ || it->second.due <= now) {
+                batch.emplace_back(it->first, std::move(it->second.decisions));
+                it = pending_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        busy_ = true;
+        lock.unlock();
+        for (const auto& [file_path, decisions] : batch) {
+            write_file(file_path, decisions);
+        }
+        lock.lock();
+        busy_ = false;
+
+        if (pending_.empty()) {
+            idle_.notify_all();
+        }
+    }
+}
+
+auto AutosaveWriter::write_file(const std::string& file_path, const FileDecisions& decisions)
+    -> void {
+    // The map is shared with callers waiting for idle; the state itself is only
+    // touched here while busy_ is set, through a pointer an erase cannot dangle
+    std::shared_ptr<FileState> shared_state;
+    bool inserted = false;
+    {
+        std::lock_guard lock(mutex_);
+        auto [state_it, added] = files_.try_emplace(file_path);
+        if (added) {
+            state_it->second = std::make_shared<FileState>();
+        }
+        shared_state = state_it->second;
+        inserted = added;
+    }
+    auto& state = *shared_state;
+    if (inserted) {
+        state.original_lines = read_lines(file_path);
+    }
+
+    if (!state.original_lines) {
+        std::lock_guard lock(mutex_);
+        if (std::find(result_.failed_files.begin(), result_.failed_files.end(), file_path)
+            == result_.failed_files.end()) {
+            result_.failed_files.push_back(file_path);
+        }
+        return;
+    }
+
+    // Coalesced toggles that end where they started need no write
+    if (same_decisions(decisions, state.written_decisions)
+        && (state.written || decisions.empty())) {
+        return;
+    }
+
+    auto annotated_file = create_annotated_file(*state.original_lines);
+    for (const auto& [warning, style] : decisions) {
+        annotated_file = apply_decision(annotated_file, warning, style);
+    }
+
+    bool saved = save_annotated_file(annotated_file, file_path);
+
+    std::lock_guard lock(mutex_);
+    if (saved) {
+        state.written = !decisions.empty();
+        state.written_decisions = decisions;
+        if (std::find(result_.written_files.begin(), result_.written_files.end(), file_path)
+            == result_.written_files.end()) {
+            result_.written_files.push_back(file_path);
+        }
+    } else {
+        result_.failed_files.push_back(file_path);
+    }
+}
+
+} // namespace nolint
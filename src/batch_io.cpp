@@ -0,0 +1,64 @@
+#include "batch_io.hpp"
+#include "annotated_file.hpp"
+#include "parallel_chunks.hpp"
+#include <filesystem>
+#include <fstream>
+
+namespace nolint {
+
+auto split_lines(std::string_view content) -> std::vector<std::string> {
+    std::vector<std::string> lines;
+    size_t pos = 0;
+    while (pos < content.size()) {
+        size_t end = content.find('\n', pos);
+        if (end == std::string_view::npos) {
+            end = content.size();
+        }
+        lines.emplace_back(content.substr(pos, end - pos));
+        pos = end + 1;
+    }
+    return lines;
+}
+
+auto read_files(const std::vector<std::string>& paths, size_t worker_count)
+    -> std::vector<std::optional<std::string>> {
+    std::vector<std::optional<std::string>> contents(paths.size());
+    process_each(paths.size(), worker_count, [&paths, &contents](size_t i) {
+        // Directories open fine and report a huge size, so only regular files
+        // are read; an exception here would terminate the worker thread
+        std::error_code error;
+        if (!std::filesystem::is_regular_file(paths[i], error)) {
+            return;
+        }
+        try {
+            std::ifstream input(paths[i], std::ios::binary | std::ios::ate);
+            auto size = input ? static_cast<std::streamoff>(input.tellg()) : -1;
+            if (size < 0) {
+                return;
+            }
+            std::string content(static_cast<size_t>(size), '\0');
+            input.seekg(0);
+            input.read(content.data(), static_cast<std::streamsize>(content.size()));
+            content.resize(static_cast<size_t>(input.gcount()));
+            contents[i] = std::move(content);
+        } catch (const std::exception&) {
+            contents[i].reset();
+        }
+    });
+    return contents;
+}
+
+auto write_files(const std::vector<FileWrite>& writes, ProgressCounters* progress,
+                 size_t worker_count) -> std::vector<bool> {
+    // vector<bool> packs bits, so workers write bytes and we convert at the end
+    std::vector<char> written(writes.size(), 0);
+    process_each(writes.size(), worker_count, [&writes, &written, progress](size_t i) {
+        written[i] = write_lines_atomically(writes[i].lines, writes[i].path) ? 1 : 0;
+        if (progress != nullptr) {
+            progress->files_done.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+    return {written.begin(), written.end()};
+}
+
+} // namespace nolint
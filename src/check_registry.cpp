@@ -0,0 +1,23 @@
+#include "check_registry.hpp"
+
+namespace nolint {
+
+auto intern_check(CheckRegistry& registry, std::string_view name) -> CheckId {
+    if (auto known = find_known_check(name)) {
+        return *known;
+    }
+    return KNOWN_CHECK_COUNT + intern(registry.unknown, name);
+}
+
+auto check_count(const CheckRegistry& registry) -> size_t {
+    return KNOWN_CHECK_COUNT + registry.unknown.names.size();
+}
+
+auto check_name(const CheckRegistry& registry, CheckId id) -> std::string_view {
+    if (id < KNOWN_CHECK_COUNT) {
+        return KNOWN_CHECKS[id].name;
+    }
+    return registry.unknown.names[id - KNOWN_CHECK_COUNT];
+}
+
+} // namespace nolint
@@ -0,0 +1,264 @@
+#include "check_trie.hpp"
+#include "ui_model.hpp"
+#include <algorithm>
+#include <map>
+#include <numeric>
+
+namespace nolint {
+
+namespace {
+
+auto style_count(StyleCounts& counts, NolintStyle style) -> int& {
+    switch (style) {
+    case NolintStyle::NOLINT:
+        return counts.nolint;
+    case NolintStyle::NOLINTNEXTLINE:
+        return counts.nolintnextline;
+    case NolintStyle::NOLINT_BLOCK:
+        return counts.nolint_block;
+    case NolintStyle::NONE:
+        break;
+    }
+    return counts.unsuppressed;
+}
+
+auto sort_value(const StyleCounts& counts, StatisticsSort sort) -> int {
+    switch (sort) {
+    case StatisticsSort::TOTAL:
+        return counts.total;
+    case StatisticsSort::UNSUPPRESSED:
+        return counts.unsuppressed;
+    case StatisticsSort::NOLINT:
+        return counts.nolint;
+    case StatisticsSort::NOLINTNEXTLINE:
+        return counts.nolintnextline;
+    case StatisticsSort::NOLINT_BLOCK:
+        return counts.nolint_block;
+    case StatisticsSort::NAME:
+        break;
+    }
+    return 0;
+}
+
+// Strict ordering of nodes for one sort key
+auto node_before(const CheckTrie& trie, StatisticsSort sort, size_t a, size_t b) -> bool {
+    const auto& left = trie.nodes[a];
+    const auto& right = trie.nodes[b];
+    int left_value = sort_value(left.counts, sort);
+    int right_value = sort_value(right.counts, sort);
+    if (left_value != right_value) {
+        return left_value > right_value;
+    }
+    return left.label < right.label;
+}
+
+// Label prefixes from category to full name: "a-b.c-d" -> "a", "a-b", "a-b.c", "a-b.c-d"
+auto label_prefixes(std::string_view name) -> std::vector<std::string_view> {
+    std::string_view category = check_category(name);
+    std::vector<std::string_view> prefixes = {category};
+    for (size_t pos = category.size() + 1; pos < name.size(); ++pos) {
+        if (name[pos] == '-' || name[pos] == '.') {
+            prefixes.push_back(name.substr(0, pos));
+        }
+    }
+    if (name.size() > category.size()) {
+        prefixes.push_back(name);
+    }
+    return prefixes;
+}
+
+// Unmerged trie built first, keyed by label
+struct DraftNode {
+    std::optional<CheckId> check;
+    std::vector<std::string> children;
+};
+
+auto copy_merged(CheckTrie& trie, const std::map<std::string, DraftNode>& draft,
+                 const std::string& label, size_t parent, size_t depth) -> size_t {
+    const std::string* current = &label;
+    const DraftNode* node = &draft.at(*current);
+    if (depth > 0) {
+        while (!node->check && node->children.size() == 1) {
+            current = &node->children.front();
+            node = &draft.at(*current);
+        }
+    }
+
+    size_t index = trie.nodes.size();
+    CheckTrieNode copy;
+    copy.label = *current;
+    copy.parent = parent;
+    copy.depth = depth;
+    copy.check = node->check;
+    trie.nodes.push_back(std::move(copy));
+    if (node->check) {
+        trie.node_of_check[*node->check] = index;
+    }
+
+    for (const auto& child : node->children) {
+        size_t child_index = copy_merged(trie, draft, child, index, depth + 1);
+        trie.nodes[index].children.push_back(child_index);
+    }
+    return index;
+}
+
+} // namespace
+
+auto build_check_trie(const WarningTable& table,
+                      const std::unordered_map<size_t, NolintStyle>& decisions) -> CheckTrie {
+    std::vector<StyleCounts> per_check(check_count(table.checks));
+    for (auto type_id : table.type_ids) {
+        per_check[type_id].total++;
+        per_check[type_id].unsuppressed++;
+    }
+    for (const auto& [index, style] : decisions) {
+        if (index < table.size()) {
+            auto& counts = per_check[table.type_ids[index]];
+            style_count(counts, NolintStyle::NONE)--;
+            style_count(counts, style)++;
+        }
+    }
+
+    // Draft every prefix, linking each to the one before it
+    std::map<std::string, DraftNode> draft;
+    std::vector<std::string> roots;
+    for (CheckId id = 0; id < per_check.size(); ++id) {
+        if (per_check[id].total == 0) {
+            continue;
+        }
+        auto prefixes = label_prefixes(check_name(table.checks, id));
+        for (size_t level = 0; level < prefixes.size(); ++level) {
+            auto [it, inserted] = draft.try_emplace(std::string(prefixes[level]));
+            if (inserted && level == 0) {
+                roots.push_back(it->first);
+            } else if (inserted) {
+                draft[std::string(prefixes[level - 1])].children.push_back(it->first);
+            }
+        }
+        draft[std::string(prefixes.back())].check = id;
+    }
+
+    CheckTrie trie;
+    trie.warning_count = table.size();
+    trie.node_of_check.assign(per_check.size(), NO_TRIE_NODE);
+    for (auto& [label, node] : draft) {
+        std::sort(node.children.begin(), node.children.end());
+    }
+    std::sort(roots.begin(), roots.end());
+    for (const auto& root : roots) {
+        trie.roots.push_back(copy_merged(trie, draft, root, NO_TRIE_NODE, 0));
+    }
+
+    // Each check contributes to its own node and every ancestor
+    for (CheckId id = 0; id < per_check.size(); ++id) {
+        for (size_t node = trie.node_of_check[id]; node != NO_TRIE_NODE;
+             node = trie.nodes[node].parent) {
+            auto& counts = trie.nodes[node].counts;
+            counts.total += per_check[id].total;
+            counts.nolint += per_check[id].nolint;
+            counts.nolintnextline += per_check[id].nolintnextline;
+            counts.nolint_block += per_check[id].nolint_block;
+            counts.unsuppressed += per_check[id].unsuppressed;
+        }
+    }
+
+    rank_trie_nodes(trie);
+    return trie;
+}
+
+auto apply_decision_change(CheckTrie& trie, CheckId check, NolintStyle before, NolintStyle after)
+    -> void {
+    if (before == after || check >= trie.node_of_check.size()) {
+        return;
+    }
+    for (size_t node = trie.node_of_check[check]; node != NO_TRIE_NODE;
+         node = trie.nodes[node].parent) {
+        style_count(trie.nodes[node].counts, before)--;
+        style_count(trie.nodes[node].counts, after)++;
+    }
+    trie.ranks_current = false;
+}
+
+auto rank_trie_nodes(CheckTrie& trie) -> void {
+    if (trie.ranks_current) {
+        return;
+    }
+
+    std::vector<size_t> order(trie.nodes.size());
+    for (size_t key = 0; key < STATISTICS_SORT_COUNT; ++key) {
+        auto sort = static_cast<StatisticsSort>(key);
+        std::iota(order.begin(), order.end(), size_t{0});
+        std::sort(order.begin(), order.end(),
+                  [&trie, sort](size_t a, size_t b) { return node_before(trie, sort, a, b); });
+
+        trie.ranks[key].resize(order.size());
+        for (size_t position = 0; position < order.size(); ++position) {
+            trie.ranks[key][order[position]] = position;
+        }
+    }
+    trie.ranks_current = true;
+}
+
+auto visible_trie_rows(const CheckTrie& trie, StatisticsSort sort) -> std::vector<size_t> {
+    const auto& rank = trie.ranks[static_cast<size_t>(sort)];
+    auto before = [&trie, &rank, sort](size_t a, size_t b) {
+        return trie.ranks_current ? rank[a] < rank[b] : node_before(trie, sort, a, b);
+    };
+
+    std::vector<size_t> rows;
+    std::vector<size_t> pending = trie.roots;
+    std::sort(pending.begin(), pending.end(), before);
+    std::reverse(pending.begin(), pending.end());
+
+    while (!pending.empty()) {
+        size_t node = pending.back();
+        pending.pop_back();
+        rows.push_back(node);
+
+        if (trie.nodes[node].expanded) {
+            auto children = trie.nodes[node].children;
+            std::sort(children.begin(), children.end(), before);
+            pending.insert(pending.end(), children.rbegin(), children.rend());
+        }
+    }
+
+    return rows;
+}
+
+auto next_statistics_sort(StatisticsSort sort) -> StatisticsSort {
+    return static_cast<StatisticsSort>((static_cast<size_t>(sort) + 1) % STATISTICS_SORT_COUNT);
+}
+
+auto statistics_sort_name(StatisticsSort sort) -> std::string_view {
+    switch (sort) {
+    case StatisticsSort::TOTAL:
+        return "total";
+    case StatisticsSort::UNSUPPRESSED:
+        return "none";
+    case StatisticsSort::NOLINT:
+        return "NOLINT";
+    case StatisticsSort::NOLINTNEXTLINE:
+        return "NEXTLINE";
+    case StatisticsSort::NOLINT_BLOCK:
+        return "BLOCK";
+    case StatisticsSort::NAME:
+        break;
+    }
+    return "name";
+}
+
+auto checks_under(const CheckTrie& trie, size_t node) -> std::vector<CheckId> {
+    std::vector<CheckId> checks;
+    std::vector<size_t> pending = {node};
+    while (!pending.empty()) {
+        const auto& current = trie.nodes[pending.back()];
+        pending.pop_back();
+        if (current.check) {
+            checks.push_back(*current.check);
+        }
+        pending.insert(pending.end(), current.children.begin(), current.children.end());
+    }
+    return checks;
+}
+
+} // namespace nolint
@@ -0,0 +1,173 @@
+#include "cpp_lexer.hpp"
+#include <algorithm>
+#include <array>
+#include <cctype>
+
+namespace nolint {
+
+namespace {
+
+// Sorted for binary search
+constexpr auto KEYWORDS = std::to_array<std::string_view>({
+    "alignas", "alignof", "break", "case", "catch", "class", "co_await", "co_return", "co_yield",
+    "concept", "const", "const_cast", "consteval", "constexpr", "constinit", "continue", "decltype",
+    "default", "delete", "do", "dynamic_cast", "else", "enum", "explicit", "export", "extern",
+    "false", "final", "for", "friend", "goto", "if", "inline", "mutable", "namespace", "new",
+    "noexcept", "nullptr", "operator", "override", "private", "protected", "public",
+    "reinterpret_cast", "requires", "return", "sizeof", "static", "static_assert", "static_cast",
+    "struct", "switch", "template", "this", "thread_local", "throw", "true", "try", "typedef",
+    "typeid", "typename", "union", "using", "virtual", "volatile", "while",
+});
+
+constexpr auto TYPES = std::to_array<std::string_view>({
+    "auto", "bool", "char", "char16_t", "char32_t", "char8_t", "double", "float", "int", "int16_t",
+    "int32_t", "int64_t", "int8_t", "long", "ptrdiff_t", "short", "signed", "size_t", "uint16_t",
+    "uint32_t", "uint64_t", "uint8_t", "unsigned", "void", "wchar_t",
+});
+
+static_assert(std::is_sorted(KEYWORDS.begin(), KEYWORDS.end()));
+static_assert(std::is_sorted(TYPES.begin(), TYPES.end()));
+
+auto is_identifier_start(char c) -> bool {
+    return std::isalpha(static_cast<unsigned char>(c)) != 0 || c == '_';
+}
+
+auto is_identifier_char(char c) -> bool {
+    return std::isalnum(static_cast<unsigned char>(c)) != 0 || c == '_';
+}
+
+auto push_span(std::vector<TokenSpan>& spans, size_t start, size_t end, TokenKind kind) -> void {
+    if (end > start) {
+        spans.push_back(TokenSpan{.start = static_cast<std::uint32_t>(start),
+                                  .length = static_cast<std::uint32_t>(end - start),
+                                  .kind = kind});
+    }
+}
+
+// End of a quoted literal starting at `pos` (the opening quote), honoring escapes
+auto skip_quoted(std::string_view line, size_t pos) -> size_t {
+    char quote = line[pos];
+    for (size_t i = pos + 1; i < line.size(); ++i) {
+        if (line[i] == '\\') {
+            ++i;
+        } else if (line[i] == quote) {
+            return i + 1;
+        }
+    }
+    return line.size(); // Unterminated: color to end of line
+}
+
+// Finish an open block comment or raw string; returns where code resumes
+auto continue_multiline(std::string_view line, LexState& state, std::vector<TokenSpan>& spans)
+    -> size_t {
+    if (state.in_block_comment) {
+        size_t close = line.find("*/");
+        size_t end = (close == std::string_view::npos) ? line.size() : close + 2;
+        push_span(spans, 0, end, TokenKind::COMMENT);
+        state.in_block_comment = (close == std::string_view::npos);
+        return end;
+    }
+    if (state.in_raw_string) {
+        size_t close = line.find(state.raw_delimiter);
+        size_t end
+            = (close == std::string_view::npos) ? line.size() : close + state.raw_delimiter.size();
+        push_span(spans, 0, end, TokenKind::STRING);
+        state.in_raw_string = (close == std::string_view::npos);
+        return end;
+    }
+    return 0;
+}
+
+} // namespace
+
+auto lex_line(std::string_view line, LexState& state) -> std::vector<TokenSpan> {
+    std::vector<TokenSpan> spans;
+
+    // Directives (and their '\' continuations) are one span
+    size_t first = line.find_first_not_of(" \t");
+    bool directive = state.in_preprocessor
+                     || (!state.in_block_comment && !state.in_raw_string
+                         && first != std::string_view::npos && line[first] == '#');
+    if (directive) {
+        push_span(spans, 0, line.size(), TokenKind::PREPROCESSOR);
+        state.in_preprocessor = !line.empty() && line.back() == '\\';
+        return spans;
+    }
+
+    size_t pos = continue_multiline(line, state, spans);
+    while (pos < line.size()) {
+        char c = line[pos];
+        char next = (pos + 1 < line.size()) ? line[pos + 1] : '\0';
+
+        if (c == '/' && next == '/') {
+            push_span(spans, pos, line.size(), TokenKind::COMMENT);
+            break;
+        }
+        if (c == '/' && next == '*') {
+            size_t close = line.find("*/", pos + 2);
+            size_t end = (close == std::string_view::npos) ? line.size() : close + 2;
+            push_span(spans, pos, end, TokenKind::COMMENT);
+            state.in_block_comment = (close == std::string_view::npos);
+            pos = end;
+            continue;
+        }
+        if (c == 'R' && next == '"') {
+            size_t open = line.find('(', pos + 2);
+            if (open != std::string_view::npos) {
+                state.raw_delimiter.assign(1, ')');
+                state.raw_delimiter += line.substr(pos + 2, open - pos - 2);
+                state.raw_delimiter += '"';
+                size_t close = line.find(state.raw_delimiter, open + 1);
+                size_t end = (close == std::string_view::npos)
+                                 ? line.size()
+                                 : close + state.raw_delimiter.size();
+                push_span(spans, pos, end, TokenKind::STRING);
+                state.in_raw_string = (close == std::string_view::npos);
+                pos = end;
+                continue;
+            }
+        }
+        if (c == '"' || c == '\'') {
+            // A quote between digits is a digit separator, handled with numbers
+            size_t end = skip_quoted(line, pos);
+            push_span(spans, pos, end, TokenKind::STRING);
+            pos = end;
+            continue;
+        }
+        if (std::isdigit(static_cast<unsigned char>(c)) != 0
+            || (c == '.' && std::isdigit(static_cast<unsigned char>(next)) != 0)) {
+            size_t end = pos + 1;
+            while (end < line.size()
+                   && (is_identifier_char(line[end]) || line[end] == '.'
+                       || (line[end] == '\'' && end + 1 < line.size()
+                           && std::isxdigit(static_cast<unsigned char>(line[end + 1])) != 0)
+                       || ((line[end] == '+' || line[end] == '-')
+                           && (line[end - 1] == 'e' || line[end - 1] == 'E'
+                               || line[end - 1] == 'p' || line[end - 1] == 'P')))) {
+                ++end;
+            }
+            push_span(spans, pos, end, TokenKind::NUMBER);
+            pos = end;
+            continue;
+        }
+        if (is_identifier_start(c)) {
+            size_t end = pos + 1;
+            while (end < line.size() && is_identifier_char(line[end])) {
+                ++end;
+            }
+            std::string_view word = line.substr(pos, end - pos);
+            if (std::binary_search(KEYWORDS.begin(), KEYWORDS.end(), word)) {
+                push_span(spans, pos, end, TokenKind::KEYWORD);
+            } else if (std::binary_search(TYPES.begin(), TYPES.end(), word)) {
+                push_span(spans, pos, end, TokenKind::TYPE);
+            }
+            pos = end;
+            continue;
+        }
+        ++pos;
+    }
+
+    return spans;
+}
+
+} // namespace nolint
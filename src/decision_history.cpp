@@ -0,0 +1,100 @@
+#include "decision_history.hpp"
+
+namespace nolint {
+
+namespace {
+
+auto stack_depth(const std::shared_ptr<const HistoryNode>& stack) -> size_t {
+    return stack ? stack->depth : 0;
+}
+
+auto push_node(std::shared_ptr<const HistoryNode> stack,
+               std::shared_ptr<const std::vector<DecisionChange>> changes, size_t cursor_position)
+    -> std::shared_ptr<const HistoryNode> {
+    auto node = std::make_shared<HistoryNode>();
+    node->changes = std::move(changes);
+    node->cursor_position = cursor_position;
+    node->depth = stack_depth(stack) + 1;
+    node->next = std::move(stack);
+    return node;
+}
+
+// Rebuild the newest `keep` nodes of a stack. Shared nodes are immutable, so the
+// tail cannot simply be cut off; the nodes are relinked, their changes are shared.
+auto truncate_stack(const std::shared_ptr<const HistoryNode>& stack, size_t keep)
+    -> std::shared_ptr<const HistoryNode> {
+    std::vector<const HistoryNode*> kept;
+    for (const HistoryNode* node = stack.get(); node != nullptr && kept.size() < keep;
+         node = node->next.get()) {
+        kept.push_back(node);
+    }
+
+    std::shared_ptr<const HistoryNode> rebuilt;
+    for (auto it = kept.rbegin(); it != kept.rend(); ++it) {
+        rebuilt = push_node(std::move(rebuilt), (*it)->changes, (*it)->cursor_position);
+    }
+    return rebuilt;
+}
+
+// Release a stack iteratively: destroying a long linked list through nested
+// shared_ptr destructors would recurse once per node.
+auto release_stack(std::shared_ptr<const HistoryNode> stack) -> void {
+    while (stack && stack.use_count() == 1) {
+        auto next = stack->next;
+        stack = std::move(next);
+    }
+}
+
+// Move the top node of `from` onto `to`
+auto transfer_top(std::shared_ptr<const HistoryNode>& from,
+                  std::shared_ptr<const HistoryNode>& to) -> std::shared_ptr<const HistoryNode> {
+    if (!from) {
+        return nullptr;
+    }
+
+    auto top = from;
+    from = top->next;
+    to = push_node(std::move(to), top->changes, top->cursor_position);
+    return top;
+}
+
+} // namespace
+
+auto push_action(DecisionHistory history, std::vector<DecisionChange> changes,
+                 size_t cursor_position) -> DecisionHistory {
+    if (changes.empty()) {
+        return history;
+    }
+
+    release_stack(std::move(history.redo_stack));
+    history.redo_stack = nullptr;
+    history.undo_stack = push_node(
+        std::move(history.undo_stack),
+        std::make_shared<const std::vector<DecisionChange>>(std::move(changes)), cursor_position);
+
+    if (history.undo_stack->depth > MAX_UNDO_LEVELS) {
+        auto old_stack = std::move(history.undo_stack);
+        history.undo_stack = truncate_stack(old_stack, MAX_UNDO_LEVELS);
+        release_stack(std::move(old_stack));
+    }
+
+    return history;
+}
+
+auto pop_undo(DecisionHistory& history) -> std::shared_ptr<const HistoryNode> {
+    return transfer_top(history.undo_stack, history.redo_stack);
+}
+
+auto pop_redo(DecisionHistory& history) -> std::shared_ptr<const HistoryNode> {
+    return transfer_top(history.redo_stack, history.undo_stack);
+}
+
+auto undo_depth(const DecisionHistory& history) -> size_t {
+    return stack_depth(history.undo_stack);
+}
+
+auto redo_depth(const DecisionHistory& history) -> size_t {
+    return stack_depth(history.redo_stack);
+}
+
+} // namespace nolint
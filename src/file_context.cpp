@@ -21,6 +21,13 @@ auto read_file_context(const Warning& warning, int context_lines) -> FileContext
         all_lines.push_back(line);
     }
 
+    return read_file_context(all_lines, warning, context_lines);
+}
+
+auto read_file_context(const std::vector<std::string>& all_lines, const Warning& warning,
+                       int context_lines) -> FileContext {
+    FileContext context;
+
     if (warning.line_number < 1 || warning.line_number > static_cast<int>(all_lines.size())) {
         context.error_message
             = "Line number " + std::to_string(warning.line_number) + " out of range";
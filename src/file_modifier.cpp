@@ -1,5 +1,6 @@
 #include "file_modifier.hpp"
 #include "annotated_file.hpp"
+#include "batch_io.hpp"
 #include <filesystem>
 #include <iostream>
 
@@ -13,16 +14,40 @@ auto FileModifier::apply_decisions(const std::vector<Warning>& warnings,
 
     // Group warnings by file
     auto grouped = group_warnings_by_file(warnings, decisions);
+    if (progress_ != nullptr) {
+        progress_->files_total.store(grouped.size(), std::memory_order_relaxed);
+    }
 
+    // Read every file up front as one batch instead of one blocking read per file
+    std::vector<std::string> paths;
+    paths.reserve(grouped.size());
     for (const auto& [file_path, file_warnings] : grouped) {
+        paths.push_back(file_path);
+    }
+    auto contents = read_files(paths);
+
+    std::vector<FileWrite> writes;
+    for (size_t i = 0; i < paths.size(); ++i) {
+        const auto& file_path = paths[i];
+        if (!contents[i]) {
+            result.failed_files.push_back(file_path);
+            result.success = false;
+            result.error_message = "Error processing " + file_path + ": cannot read file";
+            if (progress_ != nullptr) {
+                progress_->files_done.fetch_add(1, std::memory_order_relaxed);
+            }
+            continue;
+        }
+
         try {
-            // Load the file into AnnotatedFile
-            auto annotated_file = load_annotated_file(file_path);
+            auto annotated_file = create_annotated_file(split_lines(*contents[i]));
+            contents[i].reset();
 
             // Apply all decisions for this file
-            for (const auto& [warning, style] : file_warnings) {
+            for (const auto& [warning, style] : grouped[file_path]) {
                 annotated_file = apply_decision(annotated_file, warning, style);
             }
+            auto rendered = render_annotated_file(annotated_file);
 
             if (dry_run) {
                 // Just track that we would modify this file
@@ -30,30 +55,42 @@ auto FileModifier::apply_decisions(const std::vector<Warning>& warnings,
                 std::cout << "DRY RUN: Would modify " << file_path << "\n";
 
                 // Show preview of changes
-                auto rendered = render_annotated_file(annotated_file);
                 std::cout << "Preview of " << file_path << ":\n";
-                for (size_t i = 0; i < std::min(rendered.size(), size_t(10)); ++i) {
-                    std::cout << "  " << (i + 1) << ": " << rendered[i] << "\n";
+                for (size_t line = 0; line < std::min(rendered.size(), size_t(10)); ++line) {
+                    std::cout << "  " << (line + 1) << ": " << rendered[line] << "\n";
                 }
                 if (rendered.size() > 10) {
                     std::cout << "  ... (" << (rendered.size() - 10) << " more lines)\n";
                 }
                 std::cout << "\n";
-            } else {
-                // Actually save the file
-                if (save_annotated_file(annotated_file, file_path)) {
-                    result.modified_files.push_back(file_path);
-                    std::cout << "Modified: " << file_path << "\n";
-                } else {
-                    result.failed_files.push_back(file_path);
-                    result.success = false;
-                    std::cerr << "Failed to save: " << file_path << "\n";
+                if (progress_ != nullptr) {
+                    progress_->files_done.fetch_add(1, std::memory_order_relaxed);
                 }
+            } else {
+                writes.push_back(FileWrite{.path = file_path, .lines = std::move(rendered)});
             }
         } catch (const std::exception& e) {
             result.failed_files.push_back(file_path);
             result.success = false;
             result.error_message = "Error processing " + file_path + ": " + e.what();
+            if (progress_ != nullptr) {
+                progress_->files_done.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Then write them all as one batch (write, fsync, rename per file)
+    auto written = write_files(writes, progress_);
+    for (size_t i = 0; i < writes.size(); ++i) {
+        if (written[i]) {
+            result.modified_files.push_back(writes[i].path);
+            if (verbose_) {
+                std::cout << "Modified: " << writes[i].path << "\n";
+            }
+        } else {
+            result.failed_files.push_back(writes[i].path);
+            result.success = false;
+            std::cerr << "Failed to save: " << writes[i].path << "\n";
         }
     }
 
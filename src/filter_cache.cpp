@@ -0,0 +1,70 @@
+#include "filter_cache.hpp"
+#include <algorithm>
+#include <cctype>
+
+namespace nolint {
+
+auto normalize_filter_key(const std::string& filter) -> std::string {
+    std::string key = filter;
+    std::transform(key.begin(), key.end(), key.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return key;
+}
+
+auto invalidate_filter_cache(FilterCache& cache, size_t warning_count) -> void {
+    if (cache.warning_count != warning_count) {
+        cache.entries.clear();
+        cache.warning_count = warning_count;
+    }
+}
+
+auto lookup_filter(FilterCache& cache, const std::string& key) -> FilterCacheEntry* {
+    auto it = std::find_if(cache.entries.begin(), cache.entries.end(),
+                           [&key](const FilterCacheEntry& entry) { return entry.key == key; });
+    if (it == cache.entries.end()) {
+        return nullptr;
+    }
+
+    it->last_used = ++cache.clock;
+    return &*it;
+}
+
+auto store_filter(FilterCache& cache, FilterCacheEntry entry) -> void {
+    entry.last_used = ++cache.clock;
+
+    if (auto* existing = lookup_filter(cache, entry.key)) {
+        *existing = std::move(entry);
+        return;
+    }
+
+    if (cache.entries.size() >= cache.capacity && !cache.entries.empty()) {
+        auto oldest = std::min_element(
+            cache.entries.begin(), cache.entries.end(),
+            [](const FilterCacheEntry& a, const FilterCacheEntry& b) {
+                return a.last_used < b.last_used;
+            });
+        *oldest = std::move(entry);
+        return;
+    }
+
+    cache.entries.push_back(std::move(entry));
+}
+
+auto remember_filter_position(FilterCache& cache, const std::string& key, size_t current_index,
+                              PositionBitset decided, std::uint64_t decisions_version) -> void {
+    auto it = std::find_if(cache.entries.begin(), cache.entries.end(),
+                           [&key](const FilterCacheEntry& entry) { return entry.key == key; });
+    if (it != cache.entries.end()) {
+        it->current_index = current_index;
+        it->decided = std::move(decided);
+        it->decisions_version = decisions_version;
+    }
+}
+
+auto forget_filter_locations(FilterCache& cache) -> void {
+    for (auto& entry : cache.entries) {
+        entry.locations.reset();
+    }
+}
+
+} // namespace nolint
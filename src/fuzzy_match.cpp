@@ -0,0 +1,224 @@
+#include "fuzzy_match.hpp"
+#include "parallel_chunks.hpp"
+#include "text_search.hpp"
+#include <algorithm>
+
+namespace nolint {
+
+namespace {
+
+// Scoring constants modelled on fzf's v1 algorithm
+constexpr int SCORE_MATCH = 16;
+constexpr int SCORE_GAP_START = -3;
+constexpr int SCORE_GAP_EXTENSION = -1;
+constexpr int BONUS_BOUNDARY = 8;
+constexpr int BONUS_CAMEL = 7;
+constexpr int BONUS_CONSECUTIVE = 4;
+constexpr int BONUS_FIRST_CHAR_MULTIPLIER = 2;
+
+// Warnings per worker below which threading costs more than it saves
+constexpr size_t PARALLEL_FUZZY_CHUNK = 1 << 15;
+
+struct ScoredIndex {
+    int score = 0;
+    size_t index = 0;
+};
+
+auto is_lower(char c) -> bool { return c >= 'a' && c <= 'z'; }
+auto is_upper(char c) -> bool { return c >= 'A' && c <= 'Z'; }
+auto fold(char c) -> char { return is_upper(c) ? static_cast<char>(c + ('a' - 'A')) : c; }
+
+auto is_separator(char c) -> bool {
+    return c == '/' || c == '-' || c == '_' || c == ' ' || c == '.' || c == ':';
+}
+
+// Bonus for matching at position i based on the character before it
+auto position_bonus(std::string_view text, size_t i) -> int {
+    if (i == 0 || is_separator(text[i - 1])) {
+        return BONUS_BOUNDARY;
+    }
+    if (is_lower(text[i - 1]) && is_upper(text[i])) {
+        return BONUS_CAMEL;
+    }
+    return 0;
+}
+
+// Pattern position reached after greedily matching `field` from `pattern_pos`.
+// Each step is a SIMD byte search, so non-matches cost a few vector scans
+// instead of a scoring pass.
+auto advance_subsequence(std::string_view field, std::string_view lower_pattern,
+                         size_t pattern_pos) -> size_t {
+    size_t from = 0;
+    while (pattern_pos < lower_pattern.size()) {
+        size_t found = find_folded_byte(field, from, lower_pattern[pattern_pos]);
+        if (found == std::string_view::npos) {
+            break;
+        }
+        from = found + 1;
+        ++pattern_pos;
+    }
+    return pattern_pos;
+}
+
+// Score rows [begin, end). Cheap rejection first: the pattern must be a
+// subsequence of path, check and message read back to back, and the path part
+// is looked up per interned path (`path_progress`) rather than rescanned.
+auto score_range(const WarningTable& table, const std::string& lower_pattern,
+                 const std::vector<size_t>& path_progress, size_t begin, size_t end)
+    -> std::vector<ScoredIndex> {
+    std::vector<ScoredIndex> matches;
+    bool pattern_has_space = lower_pattern.find(' ') != std::string::npos;
+    std::string searchable_text; // Reused across rows
+
+    for (size_t i = begin; i < end; ++i) {
+        auto row = warning_row(table, i);
+        if (!pattern_has_space) {
+            size_t pattern_pos = path_progress[table.path_ids[i]];
+            pattern_pos = advance_subsequence(row.type(), lower_pattern, pattern_pos);
+            pattern_pos = advance_subsequence(row.message(), lower_pattern, pattern_pos);
+            if (pattern_pos < lower_pattern.size()) {
+                continue;
+            }
+        }
+
+        searchable_text.clear();
+        searchable_text.append(row.file_path()).append(1, ' ');
+        searchable_text.append(row.type()).append(1, ' ');
+        searchable_text.append(row.message());
+        if (auto score = fuzzy_score(searchable_text, lower_pattern)) {
+            matches.push_back(ScoredIndex{.score = *score, .index = i});
+        }
+    }
+
+    return matches;
+}
+
+// Every warning matching `pattern`, scored in parallel chunks and in warning order
+auto score_matches(const WarningTable& table, const std::string& pattern)
+    -> std::vector<ScoredIndex> {
+    std::string lower_pattern = fold_case(pattern);
+
+    std::vector<size_t> path_progress(table.paths.names.size());
+    for (size_t id = 0; id < path_progress.size(); ++id) {
+        path_progress[id] = advance_subsequence(table.paths.names[id], lower_pattern, 0);
+    }
+
+    auto chunk_results = process_in_chunks<std::vector<ScoredIndex>>(
+        table.size(), PARALLEL_FUZZY_CHUNK,
+        [&table, &lower_pattern, &path_progress](size_t begin, size_t end) {
+            return score_range(table, lower_pattern, path_progress, begin, end);
+        });
+
+    std::vector<ScoredIndex> matches;
+    for (auto& chunk : chunk_results) {
+        matches.insert(matches.end(), chunk.begin(), chunk.end());
+    }
+    return matches;
+}
+
+// Best score first, earlier warning first on ties
+auto by_rank(const ScoredIndex& a, const ScoredIndex& b) -> bool {
+    return a.score != b.score ? a.score > b.score : a.index < b.index;
+}
+
+} // namespace
+
+auto is_fuzzy_query(const std::string& query) -> bool {
+    return !query.empty() && query.front() == FUZZY_QUERY_PREFIX;
+}
+
+auto fuzzy_score(std::string_view text, std::string_view lower_pattern) -> std::optional<int> {
+    if (lower_pattern.empty()) {
+        return 0;
+    }
+
+    // Forward pass: earliest position where the whole pattern has been seen
+    size_t pattern_pos = 0;
+    size_t end = 0;
+    for (size_t i = 0; i < text.size(); ++i) {
+        if (fold(text[i]) == lower_pattern[pattern_pos]) {
+            if (++pattern_pos == lower_pattern.size()) {
+                end = i;
+                break;
+            }
+        }
+    }
+    if (pattern_pos < lower_pattern.size()) {
+        return std::nullopt;
+    }
+
+    // Backward pass: tightest start for a match ending at `end`
+    size_t start = end;
+    pattern_pos = lower_pattern.size();
+    for (size_t i = end + 1; i-- > 0;) {
+        if (fold(text[i]) == lower_pattern[pattern_pos - 1]) {
+            if (--pattern_pos == 0) {
+                start = i;
+                break;
+            }
+        }
+    }
+
+    // Score the window [start, end]
+    int score = 0;
+    int consecutive = 0;
+    bool in_gap = false;
+    pattern_pos = 0;
+    for (size_t i = start; i <= end && pattern_pos < lower_pattern.size(); ++i) {
+        if (fold(text[i]) == lower_pattern[pattern_pos]) {
+            int bonus = position_bonus(text, i);
+            if (consecutive > 0) {
+                bonus = std::max(bonus, BONUS_CONSECUTIVE);
+            }
+            if (pattern_pos == 0) {
+                bonus *= BONUS_FIRST_CHAR_MULTIPLIER;
+            }
+            score += SCORE_MATCH + bonus;
+            ++consecutive;
+            in_gap = false;
+            ++pattern_pos;
+        } else {
+            score += in_gap ? SCORE_GAP_EXTENSION : SCORE_GAP_START;
+            consecutive = 0;
+            in_gap = true;
+        }
+    }
+
+    return score;
+}
+
+auto fuzzy_filter_warnings(const WarningTable& table, const std::string& pattern,
+                           size_t ranked_count) -> std::vector<size_t> {
+    auto matches = score_matches(table, pattern);
+
+    // Only the top K need a full ordering; the rest go back to warning order
+    size_t ranked = std::min(ranked_count, matches.size());
+    std::nth_element(matches.begin(), matches.begin() + ranked, matches.end(), by_rank);
+    std::sort(matches.begin(), matches.begin() + ranked, by_rank);
+    std::sort(matches.begin() + ranked, matches.end(),
+              [](const ScoredIndex& a, const ScoredIndex& b) { return a.index < b.index; });
+
+    std::vector<size_t> indices;
+    indices.reserve(matches.size());
+    for (const auto& match : matches) {
+        indices.push_back(match.index);
+    }
+    return indices;
+}
+
+auto fuzzy_top_matches(const WarningTable& table, const std::string& pattern, size_t count)
+    -> FuzzyPreview {
+    auto matches = score_matches(table, pattern);
+
+    size_t ranked = std::min(count, matches.size());
+    std::partial_sort(matches.begin(), matches.begin() + ranked, matches.end(), by_rank);
+
+    FuzzyPreview preview{.match_count = matches.size(), .top = {}};
+    preview.top.reserve(ranked);
+    for (size_t i = 0; i < ranked; ++i) {
+        preview.top.push_back(matches[i].index);
+    }
+    return preview;
+}
+
+} // namespace nolint
@@ -0,0 +1,162 @@
+#include "line_map.hpp"
+#include <algorithm>
+#include <optional>
+#include <span>
+
+namespace nolint {
+
+namespace {
+
+using Lines = std::span<const std::string>;
+
+// Matched (old, new) index pairs of a shortest edit script, in order, or
+// std::nullopt when more than MAX_DIFF_EDITS edits are needed. trace[d] keeps
+// the furthest x reached on diagonals -d..d before round d, for backtracking.
+auto myers_matches(Lines a, Lines b) -> std::optional<std::vector<std::pair<int, int>>> {
+    const int n = static_cast<int>(a.size());
+    const int m = static_cast<int>(b.size());
+    const int max_edits = std::min(n + m, static_cast<int>(MAX_DIFF_EDITS));
+
+    std::vector<int> v(static_cast<size_t>(2 * max_edits + 3), 0);
+    const int offset = max_edits + 1;
+    auto at = [&](int k) -> int& { return v[static_cast<size_t>(k + offset)]; };
+
+    std::vector<std::vector<int>> trace;
+    int edits = -1;
+    for (int d = 0; d <= max_edits && edits < 0; ++d) {
+        trace.emplace_back(v.begin() + offset - d, v.begin() + offset + d + 1);
+        for (int k = -d; k <= d; k += 2) {
+            int x = (k == -d || (k != d && at(k - 1) < at(k + 1))) ? at(k + 1) : at(k - 1) + 1;
+            int y = x - k;
+            while (x < n && y < m && a[static_cast<size_t>(x)] == b[static_cast<size_t>(y)]) {
+                ++x;
+                ++y;
+            }
+            at(k) = x;
+            if (x >= n && y >= m) {
+                edits = d;
+                break;
+            }
+        }
+    }
+    if (edits < 0) {
+        return std::nullopt;
+    }
+
+    std::vector<std::pair<int, int>> matches;
+    int x = n;
+    int y = m;
+    for (int d = edits; d >= 0; --d) {
+        const auto& prev = trace[static_cast<size_t>(d)];
+        auto prev_at = [&](int k) { return prev[static_cast<size_t>(k + d)]; };
+        int k = x - y;
+        int prev_x = 0;
+        int prev_y = 0;
+        if (d > 0) {
+            int prev_k = (k == -d || (k != d && prev_at(k - 1) < prev_at(k + 1))) ? k + 1 : k - 1;
+            prev_x = prev_at(prev_k);
+            prev_y = prev_x - prev_k;
+        }
+        while (x > prev_x && y > prev_y) {
+            --x;
+            --y;
+            matches.emplace_back(x, y);
+        }
+        x = prev_x;
+        y = prev_y;
+    }
+    std::reverse(matches.begin(), matches.end());
+    return matches;
+}
+
+} // namespace
+
+auto map_lines(const std::vector<std::string>& old_lines, const std::vector<std::string>& new_lines)
+    -> LineMap {
+    LineMap map;
+    map.new_lines.resize(old_lines.size());
+    map.line_delta = static_cast<int>(new_lines.size()) - static_cast<int>(old_lines.size());
+
+    // Edits are usually local, so only the middle needs diffing
+    size_t prefix = 0;
+    while (prefix < old_lines.size() && prefix < new_lines.size()
+           && old_lines[prefix] == new_lines[prefix]) {
+        ++prefix;
+    }
+    size_t suffix = 0;
+    while (suffix < old_lines.size() - prefix && suffix < new_lines.size() - prefix
+           && old_lines[old_lines.size() - 1 - suffix]
+                  == new_lines[new_lines.size() - 1 - suffix]) {
+        ++suffix;
+    }
+
+    for (size_t i = 0; i < prefix; ++i) {
+        map.new_lines[i] = static_cast<int>(i) + 1;
+    }
+    for (size_t i = old_lines.size() - suffix; i < old_lines.size(); ++i) {
+        map.new_lines[i] = static_cast<int>(i) + 1 + map.line_delta;
+    }
+
+    Lines old_middle(old_lines.data() + prefix, old_lines.size() - prefix - suffix);
+    Lines new_middle(new_lines.data() + prefix, new_lines.size() - prefix - suffix);
+    if (old_middle.empty()) {
+        return map;
+    }
+
+    // Removed lines land on the lines that replaced them, one for one, or on the next
+    // surviving line when nothing did; clamped to the file
+    const int base = static_cast<int>(prefix) + 1;
+    const int last_line = std::max(1, static_cast<int>(new_lines.size()));
+    auto place = [&](size_t old_index, size_t new_offset) {
+        map.new_lines[prefix + old_index]
+            = std::min(base + static_cast<int>(new_offset), last_line);
+    };
+
+    auto matches = myers_matches(old_middle, new_middle);
+    if (!matches) {
+        // Rewritten wholesale: scale positions across the middle
+        for (size_t i = 0; i < old_middle.size(); ++i) {
+            place(i, i * new_middle.size() / old_middle.size());
+        }
+        map.changed_lines = old_middle.size();
+        return map;
+    }
+
+    size_t next_old = 0;
+    size_t next_new = 0;
+    auto place_removed = [&](size_t old_end, size_t new_end) {
+        size_t inserted = new_end - next_new;
+        for (size_t j = 0; next_old < old_end; ++j, ++next_old) {
+            place(next_old, next_new + std::min(j, inserted > 0 ? inserted - 1 : 0));
+            ++map.changed_lines;
+        }
+    };
+    for (auto [old_index, new_index] : *matches) {
+        place_removed(static_cast<size_t>(old_index), static_cast<size_t>(new_index));
+        place(next_old++, static_cast<size_t>(new_index));
+        next_new = static_cast<size_t>(new_index) + 1;
+    }
+    place_removed(old_middle.size(), new_middle.size());
+    return map;
+}
+
+auto remap_line(const LineMap& map, int line) -> int {
+    if (line >= 1 && static_cast<size_t>(line) <= map.new_lines.size()) {
+        return map.new_lines[static_cast<size_t>(line - 1)];
+    }
+    return (line < 1) ? line : line + map.line_delta;
+}
+
+auto is_identity(const LineMap& map) -> bool {
+    if (map.line_delta != 0) {
+        return false;
+    }
+    for (size_t i = 0; i < map.new_lines.size(); ++i) {
+        if (map.new_lines[i] != static_cast<int>(i) + 1) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace nolint
@@ -1,6 +1,14 @@
 // Final version with automatic piped input detection and /dev/tty redirect
+#include "autosave_writer.hpp"
+#include "batch_io.hpp"
 #include "file_context.hpp"
 #include "file_modifier.hpp"
+#include "fuzzy_match.hpp"
+#include "shard.hpp"
+#include "sidecar_index.hpp"
+#include "source_cache.hpp"
+#include "triage.hpp"
+#include "verify.hpp"
 #include "ui_model.hpp"
 #include "warning_parser.hpp"
 
@@ -10,10 +18,14 @@
 #include <ftxui/dom/elements.hpp>
 
 #include <algorithm>
+#include <cerrno>
+#include <cstdlib>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <memory>
 #include <sys/stat.h>
+#include <thread>
 #include <unistd.h>
 
 struct Config {
@@ -21,6 +33,24 @@ struct Config {
     bool use_stdin = true;
     bool dry_run = false;
     bool interactive = true;
+    bool autosave = false;
+    nolint::PrefixMap path_prefixes; // --map-prefix FROM=TO rules
+    size_t cache_mb = 0;             // Source cache budget, 0 = unbounded
+    std::filesystem::path index_cache = nolint::default_sidecar_directory(); // Empty = off
+    std::optional<nolint::ShardSpec> shard; // --shard i/N: only files this shard owns
+    std::string shard_result_path;          // --shard-result: where to write what was done
+    std::filesystem::path shard_root; // --shard-root: paths hash relative to it (default: git top)
+    std::string journal_path; // --journal: decisions loaded at start, written on save
+    size_t reviewers = 0;     // nolint split --reviewers N
+    nolint::SplitMode split_mode = nolint::SplitMode::DIRECTORY;
+    std::filesystem::path output_dir = "."; // Where nolint split writes reviewer sessions
+    bool verify = false;                    // Rerun clang-tidy on touched units after saving
+    std::filesystem::path build_dir;        // -p: directory with compile_commands.json
+    // Refreshing status line on a terminal, silent otherwise unless --progress=json.
+    // Saving lists each file instead unless --progress was given.
+    nolint::ProgressFormat progress
+        = isatty(fileno(stderr)) ? nolint::ProgressFormat::LINE : nolint::ProgressFormat::NONE;
+    bool progress_requested = false; // --progress given: also print cache stats on exit
 };
 
 auto parse_args(int argc, char* argv[]) -> Config {
@@ -35,11 +65,99 @@ auto parse_args(int argc, char* argv[]) -> Config {
             config.dry_run = true;
         } else if (arg == "--non-interactive") {
             config.interactive = false;
+        } else if (arg == "--autosave") {
+            config.autosave = true;
+        } else if (arg == "--map-prefix" && i + 1 < argc) {
+            auto rule = nolint::parse_prefix_rule(argv[++i]);
+            if (!rule) {
+                std::cerr << "Error: --map-prefix expects FROM=TO, got '" << argv[i] << "'\n";
+                std::exit(1);
+            }
+            nolint::add_prefix_rule(config.path_prefixes, rule->first, rule->second);
+        } else if (arg == "--cache-mb" && i + 1 < argc) {
+            char* end = nullptr;
+            config.cache_mb = std::strtoul(argv[++i], &end, 10);
+            if (end == argv[i] || *end != '\0') {
+                std::cerr << "Error: --cache-mb expects a number of megabytes, got '" << argv[i]
+                          << "'\n";
+                std::exit(1);
+            }
+        } else if (arg == "--index-cache" && i + 1 < argc) {
+            config.index_cache = argv[++i];
+        } else if (arg == "--no-index-cache") {
+            config.index_cache.clear();
+        } else if (arg == "--shard" && i + 1 < argc) {
+            config.shard = nolint::parse_shard_spec(argv[++i]);
+            if (!config.shard) {
+                std::cerr << "Error: --shard expects i/N with 1 <= i <= N, got '" << argv[i]
+                          << "'\n";
+                std::exit(1);
+            }
+        } else if (arg == "--shard-result" && i + 1 < argc) {
+            config.shard_result_path = argv[++i];
+        } else if (arg == "--shard-root" && i + 1 < argc) {
+            config.shard_root = argv[++i];
+        } else if (arg == "--journal" && i + 1 < argc) {
+            config.journal_path = argv[++i];
+        } else if (arg == "--reviewers" && i + 1 < argc) {
+            char* end = nullptr;
+            config.reviewers = std::strtoul(argv[++i], &end, 10);
+            if (end == argv[i] || *end != '\0' || config.reviewers == 0) {
+                std::cerr << "Error: --reviewers expects a positive number, got '" << argv[i]
+                          << "'\n";
+                std::exit(1);
+            }
+        } else if (arg == "--by" && i + 1 < argc) {
+            auto mode = nolint::parse_split_mode(argv[++i]);
+            if (!mode) {
+                std::cerr << "Error: --by expects directory or count, got '" << argv[i] << "'\n";
+                std::exit(1);
+            }
+            config.split_mode = *mode;
+        } else if (arg == "--output-dir" && i + 1 < argc) {
+            config.output_dir = argv[++i];
+        } else if (arg == "--verify") {
+            config.verify = true;
+        } else if (arg == "-p" && i + 1 < argc) {
+            config.build_dir = argv[++i];
+        } else if (arg == "--progress") {
+            config.progress = nolint::ProgressFormat::LINE;
+            config.progress_requested = true;
+        } else if (arg.rfind("--progress=", 0) == 0) {
+            auto format = nolint::parse_progress_format(arg.substr(11));
+            if (!format) {
+                std::cerr << "Error: --progress expects line, json or none, got '"
+                          << arg.substr(11) << "'\n";
+                std::exit(1);
+            }
+            config.progress = *format;
+            config.progress_requested = true;
         } else if (arg == "-h" || arg == "--help") {
             std::cout << "Usage: nolint [options]\n";
             std::cout << "  -i, --input <file>     Read warnings from file\n";
             std::cout << "      --dry-run          Preview changes without modifying files\n";
             std::cout << "      --non-interactive  Apply default NOLINT style to all warnings\n";
+            std::cout << "      --autosave         Write each file in the background once you move "
+                         "past it\n";
+            std::cout << "      --progress[=line|json|none]  Report parse/save throughput on "
+                         "stderr\n";
+            std::cout << "      --map-prefix FROM=TO  Read paths under FROM from TO instead "
+                         "(repeatable)\n";
+            std::cout << "      --cache-mb <n>     Keep at most n MB of source files in memory\n";
+            std::cout << "      --index-cache <dir>  Keep per-file line/token indexes here "
+                         "(default ~/.cache/nolint/index)\n";
+            std::cout << "      --no-index-cache   Do not read or write index sidecars\n";
+            std::cout << "      --shard i/N        Only process files owned by shard i of N\n";
+            std::cout << "      --shard-result <file>  With --non-interactive, write this "
+                         "shard's per-file results as JSON lines\n";
+            std::cout << "      --shard-root <dir> Assign files by their path relative to dir "
+                         "(default: git toplevel)\n";
+            std::cout << "      --journal <file>   Load decisions from this journal and write "
+                         "them back on save\n";
+            std::cout << "  -p <dir>               Build directory: relative warning paths are "
+                         "resolved against it (default: working directory)\n";
+            std::cout << "      --verify -p <dir>  After saving, rerun clang-tidy on the units "
+                         "that include a modified file\n";
             std::cout << "  -h, --help             Show this help\n";
             std::cout << "\nExamples:\n";
             std::cout << "  clang-tidy src/*.cpp | nolint                    # Automatic piped "
@@ -47,10 +165,26 @@ auto parse_args(int argc, char* argv[]) -> Config {
             std::cout << "  nolint -i warnings.txt                          # File input\n";
             std::cout << "  clang-tidy src/*.cpp | nolint --dry-run          # Preview only\n";
             std::cout << "  clang-tidy src/*.cpp | nolint --non-interactive  # Batch mode\n";
+            std::cout << "  nolint merge-shards shard-*.jsonl               # Combine shard "
+                         "results\n";
+            std::cout << "  nolint split --reviewers 4 -i warnings.txt      # One session per "
+                         "reviewer\n";
+            std::cout << "  nolint merge a.journal b.journal > all.journal  # Combine "
+                         "decisions\n";
             std::exit(0);
         }
     }
 
+    if (config.verify && config.build_dir.empty()) {
+        std::cerr << "Error: --verify needs -p <build dir> (where compile_commands.json is)\n";
+        std::exit(1);
+    }
+    // Interactive sessions never write a shard result, so merge-shards would miss the shard
+    if (!config.shard_result_path.empty() && config.interactive) {
+        std::cerr << "Error: --shard-result needs --non-interactive\n";
+        std::exit(1);
+    }
+
     return config;
 }
 
@@ -95,7 +229,7 @@ auto describe_input_type(InputType type) -> std::string {
 }
 
 // UI mode selector
-enum UIMode { MAIN_UI = 0, SEARCH_UI = 1 };
+enum UIMode { MAIN_UI = 0, SEARCH_UI = 1, GOTO_UI = 2 };
 
 // Helper function to create balanced NOLINT_BLOCK preview
 struct BalancedContext {
@@ -103,22 +237,12 @@ struct BalancedContext {
     std::string error_message;
 };
 
-auto create_balanced_nolint_block_preview(const nolint::Warning& warning, int function_lines,
-                                          int context_lines = 2) -> BalancedContext {
+auto create_balanced_nolint_block_preview(const nolint::Warning& warning,
+                                          const std::vector<std::string>& all_lines,
+                                          int function_lines, int context_lines = 2)
+    -> BalancedContext {
     BalancedContext result;
 
-    std::ifstream file(warning.file_path);
-    if (!file.is_open()) {
-        result.error_message = "Could not open file: " + warning.file_path;
-        return result;
-    }
-
-    std::vector<std::string> all_lines;
-    std::string line;
-    while (std::getline(file, line)) {
-        all_lines.push_back(line);
-    }
-
     if (warning.line_number < 1 || warning.line_number > static_cast<int>(all_lines.size())) {
         result.error_message = "Line number out of range";
         return result;
@@ -235,6 +359,10 @@ auto handle_smart_input(const Config& config) -> InputResult {
     using namespace nolint;
     InputResult result;
     WarningParser parser;
+    // One spelling per file, so each is read and written once
+    PathResolver paths(config.build_dir);
+    parser.set_path_resolver(&paths);
+    parser.set_prefix_map(&config.path_prefixes);
 
     if (config.use_stdin) {
         auto input_type = detect_input_type();
@@ -250,13 +378,43 @@ auto handle_smart_input(const Config& config) -> InputResult {
 
         // STEP 1: Read ALL stdin data immediately (before FTXUI starts)
         std::string all_input;
-        std::string line;
-        while (std::getline(std::cin, line)) {
-            all_input += line + "\n";
+        {
+            ProgressCounters read_progress;
+            struct stat stdin_stat;
+            if (fstat(fileno(stdin), &stdin_stat) == 0 && S_ISREG(stdin_stat.st_mode)) {
+                read_progress.bytes_total = static_cast<std::uint64_t>(stdin_stat.st_size);
+            }
+            ProgressReporter reporter("read", read_progress, config.progress, std::cerr);
+
+            // One buffer filled straight from the descriptor, handed to the span scan as is
+            constexpr size_t READ_CHUNK = 1 << 20;
+            all_input.reserve(read_progress.bytes_total + 1);
+            size_t used = 0;
+            while (true) {
+                all_input.resize(std::max(all_input.capacity(), used + READ_CHUNK));
+                ssize_t count
+                    = ::read(fileno(stdin), all_input.data() + used, all_input.size() - used);
+                if (count < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (count <= 0) {
+                    break;
+                }
+                used += static_cast<size_t>(count);
+                read_progress.bytes_done.fetch_add(static_cast<std::uint64_t>(count),
+                                                   std::memory_order_relaxed);
+            }
+            all_input.resize(used);
         }
 
         // Parse warnings from the input
-        result.warnings = parser.parse(all_input);
+        ProgressCounters parse_progress;
+        parse_progress.bytes_total = all_input.size();
+        parser.set_progress(&parse_progress);
+        {
+            ProgressReporter reporter("parse", parse_progress, config.progress, std::cerr);
+            result.warnings = parser.parse(all_input);
+        }
 
         // STEP 2: Redirect stdin to /dev/tty for keyboard input
         if (config.interactive && !result.warnings.empty()) {
@@ -276,13 +434,302 @@ auto handle_smart_input(const Config& config) -> InputResult {
             result.status_message = "Error: Cannot open file " + config.input_file;
             return result;
         }
-        result.warnings = parser.parse(file);
+        ProgressCounters parse_progress;
+        std::error_code size_error;
+        auto input_size = std::filesystem::file_size(config.input_file, size_error);
+        if (!size_error) {
+            parse_progress.bytes_total = input_size;
+        }
+        parser.set_progress(&parse_progress);
+        {
+            ProgressReporter reporter("parse", parse_progress, config.progress, std::cerr);
+            result.warnings = parser.parse(file);
+        }
         result.status_message = "Loaded warnings from " + config.input_file;
     }
 
     return result;
 }
 
+// Apply decisions through FileModifier while reporting save throughput
+auto apply_with_progress(const std::vector<nolint::Warning>& warnings,
+                         const std::unordered_map<size_t, nolint::NolintStyle>& decisions,
+                         const Config& config) -> nolint::FileModifier::ModificationResult {
+    using namespace nolint;
+
+    ProgressCounters save_progress;
+    FileModifier modifier;
+    modifier.set_progress(&save_progress);
+    // Per-file lines would break up a refreshing status line, so an explicit
+    // --progress=line replaces them; by default they stay and no line is drawn
+    bool status_line = config.progress == ProgressFormat::LINE;
+    modifier.set_verbose(!(status_line && config.progress_requested));
+    auto format = status_line && !config.progress_requested ? ProgressFormat::NONE
+                                                            : config.progress;
+
+    ProgressReporter reporter("save", save_progress, format, std::cerr);
+    return modifier.apply_decisions(warnings, decisions, config.dry_run);
+}
+
+// Record what this shard did for `nolint merge-shards`; false if the file can't be written
+auto write_shard_result(const Config& config, const std::vector<nolint::Warning>& warnings,
+                        const std::unordered_map<size_t, nolint::NolintStyle>& decisions,
+                        const nolint::FileModifier::ModificationResult& result) -> bool {
+    using namespace nolint;
+
+    // Only warnings that were decided (e.g. from --journal) became suppressions
+    std::unordered_map<std::string, size_t> suppressions;
+    for (const auto& [index, style] : decisions) {
+        if (style != NolintStyle::NONE) {
+            ++suppressions[warnings[index].file_path];
+        }
+    }
+
+    ShardResult shard_result{.shard = *config.shard, .warnings = warnings.size(), .files = {}};
+    for (const auto& path : result.modified_files) {
+        shard_result.files.push_back(
+            ShardFileResult{.path = path, .modified = true, .suppressions = suppressions[path]});
+    }
+    for (const auto& path : result.failed_files) {
+        shard_result.files.push_back(
+            ShardFileResult{.path = path, .modified = false, .suppressions = suppressions[path]});
+    }
+
+    std::ofstream out(config.shard_result_path);
+    out << format_shard_result(shard_result);
+    return static_cast<bool>(out);
+}
+
+// `nolint merge-shards FILE...`: combine --shard-result files into one report on stdout.
+// Exits 1 if results disagree on N, a shard is missing or repeated, or two shards
+// touched the same file.
+auto merge_shards_command(int argc, char* argv[]) -> int {
+    using namespace nolint;
+
+    std::vector<ShardResult> results;
+    for (int i = 2; i < argc; ++i) {
+        std::ifstream in(argv[i]);
+        auto result = in ? parse_shard_result(in) : std::nullopt;
+        if (!result) {
+            std::cerr << "Error: " << argv[i] << " is not a --shard-result file\n";
+            return 1;
+        }
+        results.push_back(std::move(*result));
+    }
+    if (results.empty()) {
+        std::cerr << "Usage: nolint merge-shards <shard-result>...\n";
+        return 1;
+    }
+
+    auto merged = merge_shard_results(results);
+    std::cout << format_merged_shards(merged);
+    for (auto count : merged.mismatched_counts) {
+        std::cerr << "Error: results split " << count << " ways mixed with "
+                  << merged.shard_count << " ways\n";
+    }
+    for (auto index : merged.missing_shards) {
+        std::cerr << "Error: no result for shard "
+                  << format_shard_spec({.index = index, .count = merged.shard_count}) << "\n";
+    }
+    for (auto index : merged.duplicate_shards) {
+        std::cerr << "Error: more than one result for shard "
+                  << format_shard_spec({.index = index, .count = merged.shard_count}) << "\n";
+    }
+    for (const auto& path : merged.conflicts) {
+        std::cerr << "Error: " << path << " was processed by more than one shard\n";
+    }
+    bool clean = merged.mismatched_counts.empty() && merged.missing_shards.empty()
+                 && merged.duplicate_shards.empty() && merged.conflicts.empty();
+    return clean ? 0 : 1;
+}
+
+// `nolint split --reviewers N [--by directory|count] [--output-dir DIR]`: write one
+// warnings file per reviewer, each triaged on its own with --journal
+auto split_command(const Config& config) -> int {
+    using namespace nolint;
+
+    if (config.reviewers == 0) {
+        std::cerr << "Usage: nolint split --reviewers <n> [--by directory|count] "
+                     "[--output-dir <dir>] [-i <warnings>]\n";
+        return 1;
+    }
+    auto input_result = handle_smart_input(config);
+    if (input_result.warnings.empty()) {
+        std::cerr << input_result.status_message << "\n";
+        return input_result.status_message.find("Error:") != std::string::npos ? 1 : 0;
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(config.output_dir, error);
+    auto sessions = split_reviewers(input_result.warnings, config.reviewers, config.split_mode);
+    for (size_t reviewer = 0; reviewer < sessions.size(); ++reviewer) {
+        auto path = config.output_dir / ("reviewer-" + std::to_string(reviewer + 1) + ".txt");
+        std::ofstream out(path);
+        out << format_warning_lines(input_result.warnings, sessions[reviewer]);
+        if (!out) {
+            std::cerr << "Error: cannot write " << path.string() << "\n";
+            return 1;
+        }
+        std::cout << "  " << path.string() << ": " << sessions[reviewer].size() << " warnings\n";
+    }
+    return 0;
+}
+
+// `nolint merge JOURNAL...`: combine reviewers' journals into one on stdout.
+// Warnings decided differently are left unsuppressed and listed on stderr.
+auto merge_journals_command(int argc, char* argv[]) -> int {
+    using namespace nolint;
+
+    std::vector<DecisionJournal> journals;
+    for (int i = 2; i < argc; ++i) {
+        std::ifstream in(argv[i]);
+        auto journal = in ? parse_journal(in) : std::nullopt;
+        if (!journal) {
+            std::cerr << "Error: " << argv[i] << " is not a decision journal\n";
+            return 1;
+        }
+        journals.push_back(std::move(*journal));
+    }
+    if (journals.empty()) {
+        std::cerr << "Usage: nolint merge <journal>...\n";
+        return 1;
+    }
+
+    auto merged = merge_journals(journals);
+    std::cout << format_journal(merged.journal);
+    std::cerr << "  Merged " << journals.size() << " journals: " << merged.journal.size()
+              << " decisions, " << merged.conflicts.size() << " conflicts left unsuppressed\n";
+    return 0;
+}
+
+// Decisions from --journal for the warnings with these ingest fingerprints (empty
+// if the journal doesn't exist yet); std::nullopt if it exists but can't be read.
+// Reports journal decisions that match no warning.
+auto read_journal_decisions(const Config& config, const std::vector<std::uint64_t>& fingerprints)
+    -> std::optional<std::unordered_map<size_t, nolint::NolintStyle>> {
+    std::ifstream in(config.journal_path);
+    if (!in) {
+        return std::unordered_map<size_t, nolint::NolintStyle>{};
+    }
+    auto journal = nolint::parse_journal(in);
+    if (!journal) {
+        return std::nullopt;
+    }
+    auto match = nolint::apply_journal(fingerprints, *journal);
+    if (match.matched_entries < journal->size()) {
+        std::cerr << "Warning: " << journal->size() - match.matched_entries << " of "
+                  << journal->size() << " decisions in " << config.journal_path
+                  << " match no warning in this input\n";
+    }
+    return std::move(match.decisions);
+}
+
+// Write the session's decisions to --journal; false if it can't be written
+auto write_journal(const Config& config, const std::vector<std::uint64_t>& fingerprints,
+                   const nolint::UIModel& model) -> bool {
+    std::ofstream out(config.journal_path);
+    out << nolint::format_journal(nolint::make_journal(fingerprints, model.decisions));
+    return static_cast<bool>(out);
+}
+
+// Contents of every file that gets a suppression, read before saving so --verify
+// can tell where each suppressed warning's line went
+auto snapshot_decided_files(const std::vector<nolint::Warning>& warnings,
+                            const std::unordered_map<size_t, nolint::NolintStyle>& decisions)
+    -> std::unordered_map<std::string, std::string> {
+    std::unordered_set<std::string> files;
+    for (const auto& [index, style] : decisions) {
+        if (style != nolint::NolintStyle::NONE) {
+            files.insert(warnings[index].file_path);
+        }
+    }
+    std::vector<std::string> paths(files.begin(), files.end());
+    auto contents = nolint::read_files(paths);
+
+    std::unordered_map<std::string, std::string> snapshot;
+    for (size_t i = 0; i < paths.size(); ++i) {
+        if (contents[i]) {
+            snapshot.emplace(paths[i], std::move(*contents[i]));
+        }
+    }
+    return snapshot;
+}
+
+// --verify: rerun clang-tidy ($CLANG_TIDY, default clang-tidy) on just the units that
+// include a modified file. Returns false if a suppressed warning is still reported.
+auto verify_after_save(const Config& config, const std::vector<nolint::Warning>& warnings,
+                       const std::unordered_map<size_t, nolint::NolintStyle>& decisions,
+                       const std::unordered_map<std::string, std::string>& before,
+                       const nolint::FileModifier::ModificationResult& result) -> bool {
+    using namespace nolint;
+
+    std::vector<std::string> modified;
+    for (const auto& path : result.modified_files) {
+        if (before.contains(path)) {
+            modified.push_back(path);
+        }
+    }
+    auto after = read_files(modified);
+    std::unordered_map<std::string, LineMap> line_maps;
+    for (size_t i = 0; i < modified.size(); ++i) {
+        if (after[i]) {
+            auto old_lines = split_lines(before.at(modified[i]));
+            line_maps.emplace(modified[i], map_lines(old_lines, split_lines(*after[i])));
+        }
+    }
+    auto targets = verification_targets(warnings, decisions, line_maps);
+    if (targets.empty()) {
+        return true;
+    }
+
+    const char* clang_tidy = std::getenv("CLANG_TIDY");
+    VerifyOptions options{.build_directory = config.build_dir,
+                          .clang_tidy = (clang_tidy != nullptr) ? clang_tidy : "clang-tidy",
+                          .worker_count = std::max(1U, std::thread::hardware_concurrency())};
+    std::cout << "\n  Verifying " << targets.size() << " suppressions...\n";
+    auto report = verify_suppressions(options, targets, modified);
+    if (!report.success) {
+        std::cerr << "Error: --verify: " << report.error_message << "\n";
+        return false;
+    }
+
+    std::cout << "  Reran clang-tidy on " << report.translation_units << " translation units\n";
+    for (const auto& file : report.uncovered_files) {
+        std::cerr << "  Not verified (no translation unit includes it): " << file << "\n";
+    }
+    for (const auto& file : report.failed_units) {
+        std::cerr << "  clang-tidy failed on " << file << " (not verified)\n";
+    }
+    for (const auto& warning : report.survivors) {
+        std::cerr << "  Still reported: " << warning.file_path << ":" << warning.line_number
+                  << " [" << warning.type << "]\n";
+    }
+    if (report.survivors.empty() && report.failed_units.empty()) {
+        std::cout << "  All checked suppressions took effect\n";
+    }
+    return report.survivors.empty() && report.failed_units.empty();
+}
+
+// Quote a path for /bin/sh
+auto shell_quote(const std::string& text) -> std::string {
+    std::string quoted = "'";
+    for (char c : text) {
+        quoted += (c == '\'') ? std::string("'\\''") : std::string(1, c);
+    }
+    return quoted + "'";
+}
+
+// Run $VISUAL or $EDITOR (vi if neither is set) on a file at a line; returns the exit status
+auto open_in_editor(const std::string& file_path, int line) -> int {
+    const char* editor = std::getenv("VISUAL");
+    if (editor == nullptr || *editor == '\0') {
+        editor = std::getenv("EDITOR");
+    }
+    std::string command = (editor != nullptr && *editor != '\0') ? editor : "vi";
+    command += " +" + std::to_string(line) + " " + shell_quote(file_path);
+    return std::system(command.c_str());
+}
+
 // Check if a brace position is inside a comment
 auto is_brace_in_comment(const std::string& line, size_t brace_pos) -> bool {
     size_t comment_pos = line.find("//");
@@ -363,27 +810,13 @@ auto extract_function_lines_fallback(const std::vector<std::string>& all_lines,
     return lines;
 }
 
-// Read all lines from a file
-auto read_all_lines(const std::string& file_path) -> std::vector<std::string> {
-    std::vector<std::string> lines;
-    std::ifstream file(file_path);
-
-    if (file) {
-        std::string line;
-        while (std::getline(file, line)) {
-            lines.push_back(line);
-        }
-    }
-    return lines;
-}
-
-// Main function to read function lines from file
-auto read_function_lines(const nolint::Warning& warning) -> std::vector<std::string> {
+// Main function to pick the function's lines out of the file
+auto read_function_lines(const nolint::Warning& warning, const std::vector<std::string>& all_lines)
+    -> std::vector<std::string> {
     if (!warning.function_lines.has_value()) {
         return {};
     }
 
-    auto all_lines = read_all_lines(warning.file_path);
     if (all_lines.empty()) {
         return {};
     }
@@ -401,8 +834,58 @@ auto read_function_lines(const nolint::Warning& warning) -> std::vector<std::str
     }
 }
 
+// Color a source line from its cached token spans; untokenized text is plain
+// (or dim, for context lines around the warning)
+auto render_code_line(const std::string& prefix, const std::string& line,
+                      const std::vector<nolint::TokenSpan>& spans, bool dim_plain)
+    -> ftxui::Element {
+    using namespace ftxui;
+    using nolint::TokenKind;
+
+    auto plain = [dim_plain](const std::string& part) {
+        return dim_plain ? text(part) | dim : text(part);
+    };
+
+    Elements parts;
+    parts.push_back(plain(prefix));
+    size_t pos = 0;
+    for (const auto& span : spans) {
+        if (span.start > pos) {
+            parts.push_back(plain(line.substr(pos, span.start - pos)));
+        }
+        auto token = text(line.substr(span.start, span.length));
+        switch (span.kind) {
+        case TokenKind::KEYWORD:
+            token = token | color(Color::Blue);
+            break;
+        case TokenKind::TYPE:
+            token = token | color(Color::Cyan);
+            break;
+        case TokenKind::NUMBER:
+            token = token | color(Color::Yellow);
+            break;
+        case TokenKind::STRING:
+            token = token | color(Color::Green);
+            break;
+        case TokenKind::COMMENT:
+            token = token | dim;
+            break;
+        case TokenKind::PREPROCESSOR:
+            token = token | color(Color::Magenta);
+            break;
+        }
+        parts.push_back(token);
+        pos = span.start + span.length;
+    }
+    if (pos < line.size()) {
+        parts.push_back(plain(line.substr(pos)));
+    }
+    return hbox(parts);
+}
+
 // Render the full function view
-auto render_function_view(const nolint::UIModel& model) -> ftxui::Element {
+auto render_function_view(const nolint::UIModel& model, nolint::SourceCache& sources)
+    -> ftxui::Element {
     using namespace ftxui;
 
     const auto& warning = model.current_warning();
@@ -412,8 +895,10 @@ auto render_function_view(const nolint::UIModel& model) -> ftxui::Element {
 
     Elements elements;
 
-    // Read the full function from file first
-    auto function_lines = read_function_lines(warning);
+    // Take the full function from the cached file first
+    auto source = sources.get(warning.file_path);
+    auto function_lines
+        = source ? read_function_lines(warning, source->lines) : std::vector<std::string>{};
 
     // Header - show actual range being displayed
     int start_line = warning.line_number;
@@ -463,12 +948,15 @@ auto render_function_view(const nolint::UIModel& model) -> ftxui::Element {
             int line_num = warning.line_number + i;
             bool is_warning_line = (i == 0); // First line is the warning line
 
-            auto line_element
-                = hbox({text(std::to_string(line_num) + ": ") | dim | size(WIDTH, EQUAL, 6),
-                        text(function_lines[i])});
-
+            auto number = text(std::to_string(line_num) + ": ") | dim | size(WIDTH, EQUAL, 6);
+            Element line_element;
             if (is_warning_line) {
-                line_element = line_element | bgcolor(Color::Blue);
+                // Token colors would clash with the highlight
+                line_element = hbox({number, text(function_lines[i])}) | bgcolor(Color::Blue);
+            } else {
+                const auto& spans = nolint::line_tokens(*source, static_cast<size_t>(line_num - 1));
+                line_element
+                    = hbox({number, render_code_line("", function_lines[i], spans, false)});
             }
 
             elements.push_back(line_element);
@@ -499,8 +987,35 @@ auto render_function_view(const nolint::UIModel& model) -> ftxui::Element {
     return vbox(elements) | border;
 }
 
+// Trailing note for a context line that carries other warnings: their checks and
+// decisions, green once every one of them is decided
+auto render_neighbour_annotation(const nolint::UIModel& model,
+                                 const std::vector<size_t>& warning_indices) -> ftxui::Element {
+    using namespace ftxui;
+    constexpr size_t MAX_LISTED = 2;
+
+    std::vector<std::string> style_names = {"NONE", "NOLINT", "NOLINTNEXTLINE", "NOLINT_BLOCK"};
+
+    std::string note = "  ◆";
+    bool all_decided = true;
+    for (size_t i = 0; i < warning_indices.size(); ++i) {
+        auto style = model.get_decision(warning_indices[i]);
+        all_decided = all_decided && style != nolint::NolintStyle::NONE;
+        if (i < MAX_LISTED) {
+            note += " " + model.warnings[warning_indices[i]].type + " ["
+                    + style_names[static_cast<int>(style)] + "]";
+        }
+    }
+    if (warning_indices.size() > MAX_LISTED) {
+        note += " +" + std::to_string(warning_indices.size() - MAX_LISTED) + " more";
+    }
+
+    return text(note) | color(all_decided ? Color::Green : Color::Yellow);
+}
+
 // Render the UI with dynamic context sizing
-auto render_ui(const nolint::UIModel& model, int context_lines = 3) -> ftxui::Element {
+auto render_ui(const nolint::UIModel& model, nolint::SourceCache& sources, int context_lines = 3)
+    -> ftxui::Element {
     using namespace ftxui;
     using nolint::NolintStyle;
 
@@ -512,38 +1027,63 @@ auto render_ui(const nolint::UIModel& model, int context_lines = 3) -> ftxui::El
 
     // Show statistics screen if toggled
     if (model.show_statistics) {
-        auto stats = calculate_warning_statistics(model.warnings, model.decisions);
-
         Elements stats_elements;
         stats_elements.push_back(text("  Warning Type Statistics") | bold | center);
         stats_elements.push_back(separator());
 
-        // Table header
-        stats_elements.push_back(hbox({text("  Warning Type") | bold | size(WIDTH, EQUAL, 42),
-                                       text(" Total") | bold | size(WIDTH, EQUAL, 10),
-                                       text(" NOLINT") | bold | size(WIDTH, EQUAL, 10),
-                                       text(" NEXTLINE") | bold | size(WIDTH, EQUAL, 12),
-                                       text(" BLOCK") | bold | size(WIDTH, EQUAL, 10),
-                                       text(" None") | bold | size(WIDTH, EQUAL, 10)})
-                                 | color(Color::Cyan));
+        // Table header; the active sort column is marked
+        using nolint::StatisticsSort;
+        auto header = [&model](const std::string& title, StatisticsSort sort) {
+            if (model.statistics_sort != sort) {
+                return " " + title;
+            }
+            return " " + title + (sort == StatisticsSort::NAME ? " ▲" : " ▼");
+        };
+        stats_elements.push_back(
+            hbox({text(" " + header("Warning Type", StatisticsSort::NAME)) | bold
+                      | size(WIDTH, EQUAL, 42),
+                  text(header("Total", StatisticsSort::TOTAL)) | bold | size(WIDTH, EQUAL, 10),
+                  text(header("NOLINT", StatisticsSort::NOLINT)) | bold | size(WIDTH, EQUAL, 10),
+                  text(header("NEXTLINE", StatisticsSort::NOLINTNEXTLINE)) | bold
+                      | size(WIDTH, EQUAL, 12),
+                  text(header("BLOCK", StatisticsSort::NOLINT_BLOCK)) | bold
+                      | size(WIDTH, EQUAL, 10),
+                  text(header("None", StatisticsSort::UNSUPPRESSED)) | bold
+                      | size(WIDTH, EQUAL, 10)})
+            | color(Color::Cyan));
 
         stats_elements.push_back(text("  " + std::string(94, '-')) | color(Color::White));
 
-        // Table rows
-        for (size_t i = 0; i < stats.size(); ++i) {
-            const auto& stat = stats[i];
+        // Only the rows inside the window are built. The offset is kept by
+        // update(); clamp it here too in case the terminal shrank since.
+        size_t row_count = model.statistics_rows.size();
+        size_t page_rows = std::max<size_t>(1, model.statistics_page_rows);
+        size_t first_row = model.statistics_scroll_offset;
+        if (model.statistics_selected_index >= first_row + page_rows) {
+            first_row = model.statistics_selected_index - page_rows + 1;
+        }
+        first_row = std::min(first_row, row_count);
+        size_t last_row = std::min(row_count, first_row + page_rows);
+
+        // Table rows: categories and prefixes, expanded with →
+        for (size_t i = first_row; i < last_row; ++i) {
+            const auto& node = model.check_trie.nodes[model.statistics_rows[i]];
+            const auto& counts = node.counts;
             bool is_selected = (i == model.statistics_selected_index);
 
-            auto row = hbox({text("  " + stat.type) | size(WIDTH, EQUAL, 42),
-                             text(" " + std::to_string(stat.total_count)) | size(WIDTH, EQUAL, 10)
+            std::string marker = node.children.empty() ? "  " : (node.expanded ? "▾ " : "▸ ");
+            std::string label = std::string(2 + 2 * node.depth, ' ') + marker + node.label;
+
+            auto row = hbox({text(label) | size(WIDTH, EQUAL, 42),
+                             text(" " + std::to_string(counts.total)) | size(WIDTH, EQUAL, 10)
                                  | color(Color::White),
-                             text(" " + std::to_string(stat.nolint_count)) | size(WIDTH, EQUAL, 10)
+                             text(" " + std::to_string(counts.nolint)) | size(WIDTH, EQUAL, 10)
                                  | color(Color::Green),
-                             text(" " + std::to_string(stat.nolintnextline_count))
+                             text(" " + std::to_string(counts.nolintnextline))
                                  | size(WIDTH, EQUAL, 12) | color(Color::Yellow),
-                             text(" " + std::to_string(stat.nolint_block_count))
+                             text(" " + std::to_string(counts.nolint_block))
                                  | size(WIDTH, EQUAL, 10) | color(Color::Magenta),
-                             text(" " + std::to_string(stat.unsuppressed_count))
+                             text(" " + std::to_string(counts.unsuppressed))
                                  | size(WIDTH, EQUAL, 10) | color(Color::Red)});
 
             if (is_selected) {
@@ -554,7 +1094,21 @@ auto render_ui(const nolint::UIModel& model, int context_lines = 3) -> ftxui::El
         }
 
         stats_elements.push_back(separator());
-        stats_elements.push_back(text("↑↓: select | Enter: filter | t/Esc: back") | dim);
+        if (row_count > page_rows) {
+            stats_elements.push_back(text("  rows " + std::to_string(first_row + 1) + "-"
+                                          + std::to_string(last_row) + " of "
+                                          + std::to_string(row_count))
+                                     | dim);
+        }
+        if (!model.status_message.empty()) {
+            stats_elements.push_back(text(model.status_message) | color(Color::Yellow));
+        }
+        stats_elements.push_back(
+            text("↑↓/PgUp/PgDn: select | ←→: collapse/expand | s: sort by "
+                 + std::string(nolint::statistics_sort_name(
+                     nolint::next_statistics_sort(model.statistics_sort)))
+                 + " | 0-3: set style for group | Enter: filter | t/Esc: back")
+            | dim);
 
         return vbox(stats_elements) | border;
     }
@@ -585,8 +1139,13 @@ auto render_ui(const nolint::UIModel& model, int context_lines = 3) -> ftxui::El
     // For NOLINT_BLOCK, use a custom balanced context instead of normal context
     if (model.current_style() == NolintStyle::NOLINT_BLOCK && warning.function_lines.has_value()) {
         // Create a balanced NOLINT_BLOCK preview with responsive context sizing
+        auto source = sources.get(warning.file_path);
         auto balanced_context
-            = create_balanced_nolint_block_preview(warning, *warning.function_lines, context_lines);
+            = source ? create_balanced_nolint_block_preview(warning, source->lines,
+                                                            *warning.function_lines, context_lines)
+                     : BalancedContext{.lines = {},
+                                       .error_message
+                                       = "Could not open file: " + warning.file_path};
         // NOLINTNEXTLINE(bugprone-branch-clone)
         if (!balanced_context.error_message.empty()) {
             elements.push_back(text(" " + balanced_context.error_message) | color(Color::Red));
@@ -598,7 +1157,11 @@ auto render_ui(const nolint::UIModel& model, int context_lines = 3) -> ftxui::El
             }
         }
     } else {
-        auto context = nolint::read_file_context(warning, context_lines);
+        auto source = sources.get(warning.file_path);
+        auto context = source ? nolint::read_file_context(source->lines, warning, context_lines)
+                              : nolint::FileContext{
+                                  .lines = {},
+                                  .error_message = "Could not open file: " + warning.file_path};
         if (!context.error_message.empty()) {
             elements.push_back(text(" " + context.error_message) | color(Color::Red));
         } else {
@@ -624,12 +1187,42 @@ auto render_ui(const nolint::UIModel& model, int context_lines = 3) -> ftxui::El
                                  // comment
             }
 
+            // Other warnings inside the window, walked in step with the lines
+            auto neighbours
+                = context.lines.empty()
+                      ? std::span<const nolint::LineWarning>{}
+                      : nolint::neighbouring_warnings(model, context.lines.front().line_number,
+                                                      context.lines.back().line_number);
+            auto next_neighbour = neighbours.begin();
+
             for (size_t i = 0; i < lines_to_show; ++i) {
                 const auto& line = context.lines[i];
                 std::string line_str = std::to_string(line.line_number) + ": " + line.text;
 
+                std::vector<size_t> line_warnings;
+                while (next_neighbour != neighbours.end()
+                       && next_neighbour->line <= line.line_number) {
+                    if (next_neighbour->line == line.line_number
+                        && next_neighbour->warning_index
+                               != model.current_warning_original_index()) {
+                        line_warnings.push_back(next_neighbour->warning_index);
+                    }
+                    ++next_neighbour;
+                }
+                if (!line.is_warning_line) {
+                    const auto& spans
+                        = nolint::line_tokens(*source, static_cast<size_t>(line.line_number - 1));
+                    auto code = render_code_line(
+                        "  " + std::to_string(line.line_number) + ": ", line.text, spans, true);
+                    elements.push_back(line_warnings.empty()
+                                           ? code
+                                           : hbox({code, render_neighbour_annotation(
+                                                             model, line_warnings)}));
+                    continue;
+                }
+
                 // Check if we need to insert NOLINTNEXTLINE before this line
-                if (insert_nolintnextline && line.is_warning_line) {
+                if (insert_nolintnextline) {
                     // Extract the indentation from the warning line
                     std::string indent;
                     for (char c : line.text) {
@@ -650,32 +1243,34 @@ auto render_ui(const nolint::UIModel& model, int context_lines = 3) -> ftxui::El
                     insert_nolintnextline = false; // Only insert once
                 }
 
-                if (line.is_warning_line) {
-                    if (model.current_style() == NolintStyle::NOLINT) {
-                        // Show the modified line with NOLINT comment in green
-                        auto preview
-                            = nolint::build_suppression_preview(warning, NolintStyle::NOLINT);
-                        if (preview) {
-                            std::string modified_line = std::to_string(line.line_number) + ": "
-                                                        + line.text + "  " + *preview;
-                            elements.push_back(text("  " + modified_line) | color(Color::Green));
-                        } else {
-                            elements.push_back(text("  " + line_str) | color(Color::Red) | bold);
-                        }
-                        // NOLINTNEXTLINE(bugprone-branch-clone)
-                    } else if (model.current_style() == NolintStyle::NOLINTNEXTLINE) {
-                        // Warning line is shown as normal since it's suppressed by NOLINTNEXTLINE
-                        elements.push_back(text("  " + line_str) | dim);
-                    } else if (model.current_style() == NolintStyle::NONE) {
-                        // Show warning line in red when no suppression
-                        elements.push_back(text("  " + line_str) | color(Color::Red) | bold);
+                // The warning line itself, drawn according to the chosen style
+                if (model.current_style() == NolintStyle::NOLINT) {
+                    // Show the modified line with NOLINT comment in green
+                    auto preview = nolint::build_suppression_preview(warning, NolintStyle::NOLINT);
+                    if (preview) {
+                        std::string modified_line = std::to_string(line.line_number) + ": "
+                                                    + line.text + "  " + *preview;
+                        elements.push_back(text("  " + modified_line) | color(Color::Green));
                     } else {
-                        // Other styles - just show line normally
-                        elements.push_back(text("  " + line_str) | dim);
+                        elements.push_back(text("  " + line_str) | color(Color::Red) | bold);
                     }
+                    // NOLINTNEXTLINE(bugprone-branch-clone)
+                } else if (model.current_style() == NolintStyle::NOLINTNEXTLINE) {
+                    // Warning line is shown as normal since it's suppressed by NOLINTNEXTLINE
+                    elements.push_back(text("  " + line_str) | dim);
+                } else if (model.current_style() == NolintStyle::NONE) {
+                    // Show warning line in red when no suppression
+                    elements.push_back(text("  " + line_str) | color(Color::Red) | bold);
                 } else {
+                    // Other styles - just show line normally
                     elements.push_back(text("  " + line_str) | dim);
                 }
+
+                // Other warnings on the current warning's own line
+                if (!line_warnings.empty()) {
+                    auto annotation = render_neighbour_annotation(model, line_warnings);
+                    elements.back() = hbox({elements.back(), annotation});
+                }
             }
         }
     }
@@ -700,18 +1295,23 @@ auto render_ui(const nolint::UIModel& model, int context_lines = 3) -> ftxui::El
     }
 
     // Build controls text
-    std::string controls = "↑↓: style | ←→: nav | /: search | t: stats";
+    std::string controls
+        = "↑↓: style | ←→: nav | n/N: undecided | []: file | {}: check | /: search | t: stats";
 
     // Add 'f: function' if current warning has function_lines
     if (warning.function_lines.has_value()) {
         controls += " | f: function";
     }
 
-    controls += " | x: save | q: quit";
+    controls += " | 0-3: set style | :: go to | e: edit | u/r: undo/redo | x: save | q: quit";
 
     elements.push_back(
         hbox({text("  " + warning_count_text) | bold, text(" | "), text(controls) | dim}));
 
+    if (!model.status_message.empty()) {
+        elements.push_back(text("  " + model.status_message) | color(Color::Yellow));
+    }
+
     return vbox(elements) | border;
 }
 
@@ -719,10 +1319,32 @@ int main(int argc, char* argv[]) {
     using namespace ftxui;
     using namespace nolint;
 
+    if (argc > 1 && std::string(argv[1]) == "merge-shards") {
+        return merge_shards_command(argc, argv);
+    }
+    if (argc > 1 && std::string(argv[1]) == "merge") {
+        return merge_journals_command(argc, argv);
+    }
+    if (argc > 1 && std::string(argv[1]) == "split") {
+        auto config = parse_args(argc - 1, argv + 1);
+        config.interactive = false; // Leave stdin alone
+        return split_command(config);
+    }
+
     auto config = parse_args(argc, argv);
 
     // Smart input handling with automatic detection
     auto input_result = handle_smart_input(config);
+    if (config.shard) {
+        // Every machine must hash the same relative paths, wherever its checkout lives
+        std::error_code error;
+        auto current = std::filesystem::current_path(error);
+        auto root = config.shard_root.empty() ? find_repository_root(current)
+                                              : std::filesystem::absolute(config.shard_root, error);
+        input_result.warnings
+            = select_shard(input_result.warnings, *config.shard, root.empty() ? current : root);
+        std::cout << "  Shard " << format_shard_spec(*config.shard) << "\n";
+    }
 
     // Show status message
     if (!input_result.status_message.empty()) {
@@ -733,6 +1355,12 @@ int main(int argc, char* argv[]) {
         if (input_result.status_message.find("Error:") != std::string::npos) {
             return 1;
         }
+        // A shard that owns no warned-about files still reports, so merge-shards sees it
+        if (config.shard && !config.shard_result_path.empty()
+            && !write_shard_result(config, {}, {}, {})) {
+            std::cerr << "Error: cannot write " << config.shard_result_path << "\n";
+            return 1;
+        }
         return 0;
     }
 
@@ -740,15 +1368,39 @@ int main(int argc, char* argv[]) {
 
     // Handle non-interactive mode
     if (!config.interactive) {
-        std::cout << "  Non-interactive mode: applying NOLINT to all warnings\n";
-
         std::unordered_map<size_t, NolintStyle> decisions;
-        for (size_t i = 0; i < input_result.warnings.size(); ++i) {
-            decisions[i] = NolintStyle::NOLINT;
+        if (!config.journal_path.empty()) {
+            // Apply a (merged) journal's decisions; warnings it doesn't mention are left alone
+            if (!std::filesystem::exists(config.journal_path)) {
+                std::cerr << "Error: Cannot open journal " << config.journal_path << "\n";
+                return 1;
+            }
+            auto journal_decisions
+                = read_journal_decisions(config, warning_fingerprints(input_result.warnings));
+            if (!journal_decisions) {
+                std::cerr << "Error: " << config.journal_path << " is not a decision journal\n";
+                return 1;
+            }
+            decisions = std::move(*journal_decisions);
+            std::cout << "  Non-interactive mode: applying " << decisions.size()
+                      << " decisions from " << config.journal_path << "\n";
+        } else {
+            std::cout << "  Non-interactive mode: applying NOLINT to all warnings\n";
+            for (size_t i = 0; i < input_result.warnings.size(); ++i) {
+                decisions[i] = NolintStyle::NOLINT;
+            }
         }
 
-        FileModifier modifier;
-        auto result = modifier.apply_decisions(input_result.warnings, decisions, config.dry_run);
+        std::unordered_map<std::string, std::string> before;
+        if (config.verify && !config.dry_run) {
+            before = snapshot_decided_files(input_result.warnings, decisions);
+        }
+        auto result = apply_with_progress(input_result.warnings, decisions, config);
+        if (config.shard && !config.shard_result_path.empty()
+            && !write_shard_result(config, input_result.warnings, decisions, result)) {
+            std::cerr << "Error: cannot write " << config.shard_result_path << "\n";
+            return 1;
+        }
 
         if (result.success) {
             std::cout << "Successfully processed " << result.modified_files.size() << " files\n";
@@ -757,6 +1409,10 @@ int main(int argc, char* argv[]) {
             return 1;
         }
 
+        if (config.verify && !config.dry_run
+            && !verify_after_save(config, input_result.warnings, decisions, before, result)) {
+            return 1;
+        }
         return 0;
     }
 
@@ -764,6 +1420,11 @@ int main(int argc, char* argv[]) {
     std::cout << "\n  Interactive mode - use arrow keys to navigate and select suppressions\n";
     if (config.dry_run) {
         std::cout << "DRY RUN MODE - no files will be modified\n";
+    } else if (config.autosave) {
+        std::cout << "AUTOSAVE MODE - files are written as you move past them\n";
+        if (config.verify) {
+            std::cout << "--verify is not applied to autosaved files\n";
+        }
     }
     if (input_result.stdin_redirected) {
         std::cout << "Keyboard input active via /dev/tty\n";
@@ -771,12 +1432,34 @@ int main(int argc, char* argv[]) {
     std::cout << "\n";
 
     // Initialize UIModel
+    // Journal identities are taken before any editor session moves warning lines
+    std::vector<std::uint64_t> fingerprints;
+    if (!config.journal_path.empty()) {
+        fingerprints = warning_fingerprints(input_result.warnings);
+    }
     UIModel model;
-    model.warnings = input_result.warnings;
+    model = replace_warnings(std::move(model), std::move(input_result.warnings));
     model.dry_run = config.dry_run;
+    if (!config.journal_path.empty()) {
+        auto journal_decisions = read_journal_decisions(config, fingerprints);
+        if (!journal_decisions) {
+            std::cerr << "Error: " << config.journal_path << " is not a decision journal\n";
+            return 1;
+        }
+        model = replace_decisions(std::move(model), std::move(*journal_decisions));
+    }
 
     // Initialize with all warnings visible (no filter)
-    model.filtered_warning_indices = filter_warnings(model.warnings, "");
+    model = apply_filter(std::move(model), "");
+
+    // Background writer for --autosave (never in dry-run mode)
+    std::unique_ptr<AutosaveWriter> autosave;
+    std::unordered_map<std::string, std::vector<size_t>> warnings_by_file;
+    std::string autosave_current_file;
+    if (config.autosave && !config.dry_run) {
+        autosave = std::make_unique<AutosaveWriter>();
+        warnings_by_file = group_warning_indices_by_file(model.warnings);
+    }
 
     auto screen = ScreenInteractive::Fullscreen();
 
@@ -784,11 +1467,37 @@ int main(int argc, char* argv[]) {
     std::string search_input_text;
     auto search_input = Input(&search_input_text, "Enter search filter...");
 
+    // Fuzzy preview for the query last rendered; frames that don't edit it reuse the result
+    std::string preview_query;
+    nolint::FuzzyPreview preview;
+
+    // Create go-to input component
+    std::string goto_input_text;
+    auto goto_input = Input(&goto_input_text, ":N or path:line");
+
+    // Source files shown in the context and function views, lexed once for highlighting
+    constexpr size_t BYTES_PER_MB = 1024 * 1024;
+    nolint::SourceCache sources(config.cache_mb * BYTES_PER_MB, config.index_cache);
+
+    // Read the first files the review will show as one batch before the first frame
+    constexpr size_t PREFETCH_FILES = 8;
+    std::vector<std::string> first_files;
+    for (auto index : *model.filtered_warning_indices) {
+        const auto& path = model.warnings[index].file_path;
+        if (first_files.empty() || first_files.back() != path) {
+            first_files.push_back(path);
+        }
+        if (first_files.size() == PREFETCH_FILES) {
+            break;
+        }
+    }
+    sources.prefetch(first_files);
+
     // Create main UI component with dynamic context sizing
-    auto main_component = Renderer([&model] {
+    auto main_component = Renderer([&model, &sources] {
         // Check if in function view mode
         if (model.in_function_view) {
-            return render_function_view(model);
+            return render_function_view(model, sources);
         }
 
         // Calculate dynamic context lines based on terminal height
@@ -807,33 +1516,67 @@ int main(int argc, char* argv[]) {
         int context_lines = std::max(
             2, (available_for_code - 1) / 2); // -1 for warning line, /2 for before+after, minimum 2
 
-        return render_ui(model, context_lines);
+        return render_ui(model, sources, context_lines);
     });
 
     // Create search UI component
-    auto search_component = Renderer(search_input, [&search_input_text] {
-        return vbox({text("Search Filter:") | bold, separator(),
-                     hbox({text("Filter: "), text(search_input_text) | color(Color::Cyan)}),
-                     text("Enter to apply, Escape to cancel") | dim})
+    auto search_component = Renderer(search_input, [&search_input_text, &preview_query, &preview,
+                                                    &model] {
+        Elements search_elements
+            = {text("Search Filter:") | bold, separator(),
+               hbox({text("Filter: "), text(search_input_text) | color(Color::Cyan)})};
+
+        // Live ranked preview while typing a fuzzy query - only the top matches are sorted
+        if (is_fuzzy_query(search_input_text) && search_input_text.size() > 1) {
+            constexpr size_t preview_count = 10;
+            if (search_input_text != preview_query) {
+                preview = fuzzy_top_matches(*model.table, search_input_text.substr(1),
+                                            preview_count);
+                preview_query = search_input_text;
+            }
+            search_elements.push_back(text(std::to_string(preview.match_count) + " matches")
+                                      | dim);
+            for (auto index : preview.top) {
+                if (index >= model.warnings.size()) {
+                    continue;
+                }
+                const auto& match = model.warnings[index];
+                search_elements.push_back(text("  " + match.file_path + ":"
+                                               + std::to_string(match.line_number) + " "
+                                               + match.type));
+            }
+        }
+
+        search_elements.push_back(
+            text("Enter to apply, Escape to cancel, ~ prefix for fuzzy match") | dim);
+        return vbox(search_elements) | border;
+    });
+
+    // Create go-to UI component
+    auto goto_component = Renderer(goto_input, [&goto_input_text] {
+        return vbox({text("Go To:") | bold, separator(),
+                     hbox({text("Location: "), text(goto_input_text) | color(Color::Cyan)}),
+                     text(":1234 for warning number, path:line for location") | dim,
+                     text("Enter to jump, Escape to cancel") | dim})
                | border;
     });
 
-    // Container component that switches between main and search UI
+    // Container component that switches between main, search and go-to UI
     int ui_selector = MAIN_UI;
-    auto component = Container::Tab({main_component, search_component}, &ui_selector);
+    auto component
+        = Container::Tab({main_component, search_component, goto_component}, &ui_selector);
 
     // Add event handler with direct state mutation (for FTXUI)
     component
-        = component | CatchEvent([&model, &screen, &search_input_text, &ui_selector](Event event) {
+        = component | CatchEvent([&model, &screen, &search_input_text, &goto_input_text,
+                                  &ui_selector, &autosave, &warnings_by_file,
+                                  &autosave_current_file, &sources](Event event) {
               // Handle search mode events
               if (ui_selector == SEARCH_UI) { // In search mode
                   if (event == Event::Return) {
                       // Apply search filter
-                      model.search_filter = search_input_text;
-                      model.filtered_warning_indices
-                          = filter_warnings(model.warnings, model.search_filter);
-                      model.current_index = 0; // Reset to first filtered result
-                      ui_selector = MAIN_UI;   // Return to main UI
+                      model = apply_filter(std::move(model), search_input_text);
+                      ui_selector = MAIN_UI; // Return to main UI
                       return true;
                   } else if (event == Event::Escape) {
                       // Cancel search
@@ -844,6 +1587,54 @@ int main(int argc, char* argv[]) {
                   // Let search input handle other events
                   return false;
               }
+              if (ui_selector == GOTO_UI) { // In go-to mode
+                  if (event == Event::Return) {
+                      model = goto_location(std::move(model), goto_input_text);
+                      ui_selector = MAIN_UI;
+                      return true;
+                  } else if (event == Event::Escape) {
+                      ui_selector = MAIN_UI;
+                      goto_input_text.clear();
+                      return true;
+                  }
+                  // Let go-to input handle other events
+                  return false;
+              }
+              // Edit the current file outside the TUI, then re-read and rebase only that file
+              if (event == Event::Character('e') && !model.show_statistics
+                  && model.total_warnings() > 0) {
+                  const auto file_path = model.current_warning().file_path;
+                  const int line = model.current_warning().line_number;
+                  // The warnings refer to the file as it was before any autosave
+                  // annotated it, so edit (and diff against) that version
+                  std::optional<std::vector<std::string>> before;
+                  if (autosave) {
+                      before = autosave->restore_original(file_path);
+                  }
+                  if (!before) {
+                      if (auto cached = sources.get(file_path)) {
+                          before = cached->lines;
+                      }
+                  }
+                  int status = 0;
+                  screen.WithRestoredIO([&] { status = open_in_editor(file_path, line); })();
+
+                  sources.invalidate(file_path);
+                  if (autosave) {
+                      autosave->rebase(file_path);
+                  }
+                  auto after = sources.get(file_path);
+                  model.status_message.clear();
+                  if (before && after) {
+                      model = rebase_file_warnings(std::move(model), file_path,
+                                                   map_lines(*before, after->lines));
+                  }
+                  if (status != 0) {
+                      model.status_message = "Editor exited with status " + std::to_string(status);
+                  }
+                  return true;
+              }
+
               // Map events to our InputEvent enum
               InputEvent input_event = InputEvent::UNKNOWN;
 
@@ -863,6 +1654,18 @@ int main(int argc, char* argv[]) {
                   input_event = InputEvent::VIM_G; // lowercase g (for gg command)
               } else if (event == Event::Character('G')) {
                   input_event = InputEvent::VIM_CAPITAL_G; // Capital G - go to bottom
+              } else if (event == Event::Character('n')) {
+                  input_event = InputEvent::NEXT_UNDECIDED;
+              } else if (event == Event::Character('N')) {
+                  input_event = InputEvent::PREV_UNDECIDED;
+              } else if (event == Event::Character(']')) {
+                  input_event = InputEvent::NEXT_FILE;
+              } else if (event == Event::Character('[')) {
+                  input_event = InputEvent::PREV_FILE;
+              } else if (event == Event::Character('}')) {
+                  input_event = InputEvent::NEXT_CHECK;
+              } else if (event == Event::Character('{')) {
+                  input_event = InputEvent::PREV_CHECK;
               } else if (event == Event::ArrowUp) {
                   input_event = InputEvent::ARROW_UP;
               } else if (event == Event::ArrowDown) {
@@ -881,6 +1684,22 @@ int main(int argc, char* argv[]) {
                   input_event = InputEvent::END;
               } else if (event == Event::Character('/')) {
                   input_event = InputEvent::SEARCH;
+              } else if (event == Event::Character(':')) {
+                  input_event = InputEvent::GOTO;
+              } else if (event == Event::Character('u')) {
+                  input_event = InputEvent::UNDO;
+              } else if (event == Event::Character('r')) {
+                  input_event = InputEvent::REDO;
+              } else if (event == Event::Character('s')) {
+                  input_event = InputEvent::CYCLE_SORT;
+              } else if (event == Event::Character('0')) {
+                  input_event = InputEvent::SET_NONE;
+              } else if (event == Event::Character('1')) {
+                  input_event = InputEvent::SET_NOLINT;
+              } else if (event == Event::Character('2')) {
+                  input_event = InputEvent::SET_NOLINTNEXTLINE;
+              } else if (event == Event::Character('3')) {
+                  input_event = InputEvent::SET_NOLINT_BLOCK;
               } else if (event == Event::Return) {
                   input_event = InputEvent::ENTER;
               } else if (event == Event::Escape) {
@@ -891,16 +1710,45 @@ int main(int argc, char* argv[]) {
                   return false;
               }
 
+              // Statistics rows that fit: terminal minus title, header, rule, footer and border
+              constexpr int STATISTICS_CHROME_LINES = 10;
+              model.statistics_page_rows = static_cast<size_t>(
+                  std::max(1, ftxui::Terminal::Size().dimy - STATISTICS_CHROME_LINES));
+
               // Use our pure update function
               auto new_model = update(model, input_event);
               model = new_model; // Mutate for FTXUI
 
+              // Files with pending edits stay cached ahead of the rest
+              if (model.total_warnings() > 0 && model.current_style() != NolintStyle::NONE) {
+                  sources.pin(model.current_warning().file_path);
+              }
+
+              // Autosave: hand a file to the background writer once the cursor leaves it
+              if (autosave && model.total_warnings() > 0) {
+                  const auto& current_file = model.current_warning().file_path;
+                  if (!autosave_current_file.empty() && autosave_current_file != current_file) {
+                      autosave->submit(autosave_current_file,
+                                       collect_file_decisions(
+                                           model.warnings, model.decisions,
+                                           warnings_by_file[autosave_current_file]));
+                      sources.unpin(autosave_current_file); // Written, nothing pending
+                  }
+                  autosave_current_file = current_file;
+              }
+
               // Handle search mode activation
               if (input_event == InputEvent::SEARCH) {
                   ui_selector = SEARCH_UI;   // Switch to search UI
                   search_input_text.clear(); // Clear previous search
               }
 
+              // Handle go-to prompt activation
+              if (input_event == InputEvent::GOTO && !model.show_statistics) {
+                  ui_selector = GOTO_UI;
+                  goto_input_text.clear();
+              }
+
               // Exit if needed
               if (model.should_exit) {
                   screen.Exit();
@@ -913,12 +1761,66 @@ int main(int argc, char* argv[]) {
     // Run the app
     screen.Loop(component);
 
+    // Only on request: the default terminal progress covers parsing
+    if (config.progress_requested && config.progress == ProgressFormat::JSON) {
+        std::cerr << format_cache_stats_json(sources.stats()) << "\n";
+    } else if (config.progress_requested && config.progress == ProgressFormat::LINE) {
+        std::cerr << format_cache_stats_line(sources.stats()) << "\n";
+    }
+
+    // The journal records the session whenever it is saved, dry runs included
+    if (!config.journal_path.empty() && model.should_save) {
+        if (!write_journal(config, fingerprints, model)) {
+            std::cerr << "Error: cannot write " << config.journal_path << "\n";
+            return 1;
+        }
+        std::cout << "\n  Wrote " << model.decisions.size() << " decisions to "
+                  << config.journal_path << "\n";
+    }
+
+    // Autosave mode: most files are already written, flush only what is still pending
+    if (autosave) {
+        if (model.should_save) {
+            std::unordered_set<std::string> decided_files;
+            for (const auto& [index, style] : model.decisions) {
+                decided_files.insert(model.warnings[index].file_path);
+            }
+            // Unchanged files are skipped by the writer
+            for (const auto& file_path : decided_files) {
+                autosave->submit(file_path, collect_file_decisions(model.warnings, model.decisions,
+                                                                   warnings_by_file[file_path]));
+            }
+
+            std::cout << "\n  Flushing autosave...\n";
+            auto result = autosave->flush();
+            std::cout << "Successfully processed " << result.written_files.size() << " files:\n";
+            for (const auto& file : result.written_files) {
+                std::cout << "  ※ " << file << "\n";
+            }
+            for (const auto& file : result.failed_files) {
+                std::cerr << "  Failed: " << file << "\n";
+            }
+            return result.failed_files.empty() ? 0 : 1;
+        }
+
+        auto reverted = autosave->revert();
+        std::cout << "\n  Exited without saving - restored " << reverted.written_files.size()
+                  << " autosaved files.\n";
+        for (const auto& file : reverted.failed_files) {
+            std::cerr << "  Failed to restore: " << file << "\n";
+        }
+        return reverted.failed_files.empty() ? 0 : 1;
+    }
+
     // Apply decisions when exiting
     if (!model.decisions.empty() && model.should_save) {
         std::cout << "\n  Applying decisions to files...\n";
 
-        FileModifier modifier;
-        auto result = modifier.apply_decisions(model.warnings, model.decisions, model.dry_run);
+        std::unordered_map<std::string, std::string> before;
+        if (config.verify && !config.dry_run) {
+            before = snapshot_decided_files(model.warnings, model.decisions);
+        }
+        auto result = apply_with_progress(model.warnings, model.decisions, config);
 
         if (result.success) {
             std::cout << "Successfully processed " << result.modified_files.size() << " files:\n";
@@ -933,6 +1835,11 @@ int main(int argc, char* argv[]) {
             }
             return 1;
         }
+
+        if (config.verify && !config.dry_run
+            && !verify_after_save(config, model.warnings, model.decisions, before, result)) {
+            return 1;
+        }
     } else {
 
         // Either no NOLINT decisions were made, or specifically not
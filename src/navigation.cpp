@@ -0,0 +1,291 @@
+#include "navigation.hpp"
+#include "warning_table.hpp"
+#include <algorithm>
+#include <bit>
+#include <cctype>
+#include <charconv>
+#include <iterator>
+
+namespace nolint {
+
+namespace {
+
+constexpr size_t BITS_PER_WORD = 64;
+
+auto is_all_digits(const std::string& text) -> bool {
+    return !text.empty() && std::all_of(text.begin(), text.end(), [](unsigned char c) {
+        return std::isdigit(c) != 0;
+    });
+}
+
+// Whole of `text` as a number; std::nullopt when it has other characters or is out of range
+template <typename Number>
+auto parse_number(const std::string& text) -> std::optional<Number> {
+    Number value{};
+    auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (error != std::errc{} || end != text.data() + text.size()) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+// True when `path` ends with `suffix` on a path component boundary
+auto ends_with_component(const std::string& path, const std::string& suffix) -> bool {
+    if (suffix.size() >= path.size()) {
+        return false;
+    }
+    return path.compare(path.size() - suffix.size(), suffix.size(), suffix) == 0
+           && path[path.size() - suffix.size() - 1] == '/';
+}
+
+} // namespace
+
+auto make_position_bitset(size_t size) -> PositionBitset {
+    size_t word_count = (size + BITS_PER_WORD - 1) / BITS_PER_WORD;
+    return PositionBitset{.words = std::vector<std::uint64_t>(word_count), .size = size};
+}
+
+auto set_position(PositionBitset& bits, size_t position, bool value) -> void {
+    if (position >= bits.size) {
+        return;
+    }
+
+    std::uint64_t mask = std::uint64_t{1} << (position % BITS_PER_WORD);
+    if (value) {
+        bits.words[position / BITS_PER_WORD] |= mask;
+    } else {
+        bits.words[position / BITS_PER_WORD] &= ~mask;
+    }
+}
+
+auto test_position(const PositionBitset& bits, size_t position) -> bool {
+    if (position >= bits.size) {
+        return false;
+    }
+    return (bits.words[position / BITS_PER_WORD] >> (position % BITS_PER_WORD)) & 1U;
+}
+
+auto find_next_clear(const PositionBitset& bits, size_t from) -> std::optional<size_t> {
+    if (from >= bits.size) {
+        return std::nullopt;
+    }
+
+    size_t word_index = from / BITS_PER_WORD;
+    // Invert so cleared bits become candidates, then drop candidates before `from`
+    std::uint64_t candidates
+        = ~bits.words[word_index] & (~std::uint64_t{0} << (from % BITS_PER_WORD));
+
+    while (true) {
+        if (candidates != 0) {
+            size_t position = word_index * BITS_PER_WORD + std::countr_zero(candidates);
+            // Padding bits past the end of the last word are always clear
+            if (position >= bits.size) {
+                return std::nullopt;
+            }
+            return position;
+        }
+
+        if (++word_index >= bits.words.size()) {
+            return std::nullopt;
+        }
+        candidates = ~bits.words[word_index];
+    }
+}
+
+auto find_prev_clear(const PositionBitset& bits, size_t from) -> std::optional<size_t> {
+    if (bits.size == 0) {
+        return std::nullopt;
+    }
+    from = std::min(from, bits.size - 1);
+
+    size_t word_index = from / BITS_PER_WORD;
+    size_t bit_index = from % BITS_PER_WORD;
+    // Keep only candidates at or below `from`
+    std::uint64_t keep = (bit_index == BITS_PER_WORD - 1)
+                             ? ~std::uint64_t{0}
+                             : (std::uint64_t{1} << (bit_index + 1)) - 1;
+    std::uint64_t candidates = ~bits.words[word_index] & keep;
+
+    while (true) {
+        if (candidates != 0) {
+            return word_index * BITS_PER_WORD + (BITS_PER_WORD - 1)
+                   - std::countl_zero(candidates);
+        }
+
+        if (word_index == 0) {
+            return std::nullopt;
+        }
+        candidates = ~bits.words[--word_index];
+    }
+}
+
+auto find_next_run_start(const std::vector<size_t>& run_starts, size_t position)
+    -> std::optional<size_t> {
+    auto it = std::upper_bound(run_starts.begin(), run_starts.end(), position);
+    if (it == run_starts.end()) {
+        return std::nullopt;
+    }
+    return *it;
+}
+
+auto find_prev_run_start(const std::vector<size_t>& run_starts, size_t position)
+    -> std::optional<size_t> {
+    auto it = std::lower_bound(run_starts.begin(), run_starts.end(), position);
+    if (it == run_starts.begin()) {
+        return std::nullopt;
+    }
+    return *std::prev(it);
+}
+
+auto parse_goto_command(const std::string& command) -> std::optional<GotoTarget> {
+    auto first = command.find_first_not_of(" \t");
+    auto last = command.find_last_not_of(" \t");
+    if (first == std::string::npos) {
+        return std::nullopt;
+    }
+    std::string text = command.substr(first, last - first + 1);
+
+    GotoTarget target;
+
+    // ":1234" or "1234" - warning number in the filtered list
+    std::string number_text = (text.front() == ':') ? text.substr(1) : text;
+    if (is_all_digits(number_text)) {
+        target.warning_number = parse_number<size_t>(number_text);
+        return target.warning_number ? std::optional(target) : std::nullopt;
+    }
+
+    // Strip trailing ":col" and ":line" components, as found in compiler diagnostics
+    std::vector<int> numbers;
+    while (numbers.size() < 2) {
+        auto colon = text.rfind(':');
+        if (colon == std::string::npos || !is_all_digits(text.substr(colon + 1))) {
+            break;
+        }
+        auto number = parse_number<int>(text.substr(colon + 1));
+        if (!number) {
+            return std::nullopt;
+        }
+        numbers.insert(numbers.begin(), *number);
+        text.erase(colon);
+    }
+
+    if (text.empty()) {
+        return std::nullopt;
+    }
+
+    target.file_path = text;
+    target.line = numbers.empty() ? 0 : numbers.front();
+    return target;
+}
+
+auto find_file_lines(const LocationIndex& index, const std::string& file_path)
+    -> const std::vector<LineEntry>* {
+    auto exact = index.lines_by_file.find(file_path);
+    if (exact != index.lines_by_file.end()) {
+        return &exact->second;
+    }
+
+    // Reports and warnings may disagree on how much of the path is spelled out.
+    // Pick the lexicographically smallest match so the result is deterministic.
+    const std::string* best_path = nullptr;
+    const std::vector<LineEntry>* best_lines = nullptr;
+    for (const auto& [path, lines] : index.lines_by_file) {
+        if (ends_with_component(path, file_path) || ends_with_component(file_path, path)) {
+            if (best_path == nullptr || path < *best_path) {
+                best_path = &path;
+                best_lines = &lines;
+            }
+        }
+    }
+    return best_lines;
+}
+
+auto find_nearest_line(const std::vector<LineEntry>& lines, int line) -> std::optional<size_t> {
+    if (lines.empty()) {
+        return std::nullopt;
+    }
+
+    auto after = std::lower_bound(lines.begin(), lines.end(), line,
+                                  [](const LineEntry& entry, int value) {
+                                      return entry.line < value;
+                                  });
+    if (after == lines.begin()) {
+        return after->position;
+    }
+
+    auto before = std::prev(after);
+    if (after == lines.end() || (line - before->line) < (after->line - line)) {
+        return before->position;
+    }
+    return after->position;
+}
+
+auto build_file_line_index(const WarningTable& table) -> FileLineIndex {
+    FileLineIndex index;
+
+    // Counting sort by path id keeps warning order within each file
+    index.file_starts.assign(table.paths.names.size() + 1, 0);
+    for (auto path_id : table.path_ids) {
+        index.file_starts[path_id + 1]++;
+    }
+    for (size_t f = 1; f < index.file_starts.size(); ++f) {
+        index.file_starts[f] += index.file_starts[f - 1];
+    }
+
+    index.entries.resize(table.size());
+    std::vector<size_t> next(index.file_starts.begin(), index.file_starts.end() - 1);
+    for (size_t i = 0; i < table.size(); ++i) {
+        index.entries[next[table.path_ids[i]]++]
+            = LineWarning{.line = table.lines[i], .warning_index = i};
+    }
+
+    auto by_line = [](const LineWarning& a, const LineWarning& b) { return a.line < b.line; };
+    for (size_t f = 0; f + 1 < index.file_starts.size(); ++f) {
+        auto file_begin = index.entries.begin() + static_cast<std::ptrdiff_t>(index.file_starts[f]);
+        auto file_end
+            = index.entries.begin() + static_cast<std::ptrdiff_t>(index.file_starts[f + 1]);
+        std::stable_sort(file_begin, file_end, by_line);
+    }
+
+    return index;
+}
+
+auto warnings_in_lines(const FileLineIndex& index, std::uint32_t path_id, int first_line,
+                       int last_line) -> std::span<const LineWarning> {
+    if (path_id + 1 >= index.file_starts.size() || first_line > last_line) {
+        return {};
+    }
+
+    auto file_begin
+        = index.entries.begin() + static_cast<std::ptrdiff_t>(index.file_starts[path_id]);
+    auto file_end
+        = index.entries.begin() + static_cast<std::ptrdiff_t>(index.file_starts[path_id + 1]);
+    auto begin = std::lower_bound(
+        file_begin, file_end, first_line,
+        [](const LineWarning& entry, int value) { return entry.line < value; });
+    auto end = std::upper_bound(
+        begin, file_end, last_line,
+        [](int value, const LineWarning& entry) { return value < entry.line; });
+
+    return {begin, end};
+}
+
+auto refresh_file_lines(FileLineIndex& index, const WarningTable& table, std::uint32_t path_id)
+    -> void {
+    if (path_id + 1 >= index.file_starts.size()) {
+        return;
+    }
+
+    auto file_begin
+        = index.entries.begin() + static_cast<std::ptrdiff_t>(index.file_starts[path_id]);
+    auto file_end
+        = index.entries.begin() + static_cast<std::ptrdiff_t>(index.file_starts[path_id + 1]);
+    for (auto it = file_begin; it != file_end; ++it) {
+        it->line = table.lines[it->warning_index];
+    }
+    std::stable_sort(file_begin, file_end, [](const LineWarning& a, const LineWarning& b) {
+        return a.line < b.line;
+    });
+}
+
+} // namespace nolint
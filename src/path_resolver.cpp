@@ -0,0 +1,64 @@
+#include "path_resolver.hpp"
+#include <filesystem>
+#include <sys/stat.h>
+
+namespace nolint {
+
+PathResolver::PathResolver(const std::filesystem::path& base_directory) {
+    std::error_code error;
+    auto cwd = std::filesystem::canonical(std::filesystem::current_path(error), error);
+    if (!error) {
+        working_directory_ = cwd.string();
+        if (working_directory_.back() != '/') {
+            working_directory_ += '/';
+        }
+    }
+    if (!base_directory.empty()) {
+        base_directory_ = std::filesystem::absolute(base_directory, error);
+    }
+}
+
+auto PathResolver::display_path(const std::string& absolute) const -> std::string {
+    if (!working_directory_.empty() && absolute.starts_with(working_directory_)) {
+        return absolute.substr(working_directory_.size());
+    }
+    return absolute;
+}
+
+auto PathResolver::file_id(const std::string& path) -> std::uint32_t {
+    if (auto it = spellings_.find(path); it != spellings_.end()) {
+        return it->second;
+    }
+
+    // Relative spellings name files under the build directory, when known
+    bool in_base = !base_directory_.empty() && std::filesystem::path(path).is_relative();
+    std::string lookup = in_base ? (base_directory_ / path).string() : path;
+
+    ++stat_calls_;
+    struct stat info {};
+    std::uint32_t id = 0;
+    if (::stat(lookup.c_str(), &info) != 0) {
+        // Missing or unreadable: remember the normalized spelling so it is not retried
+        auto normal = std::filesystem::path(lookup).lexically_normal().string();
+        if (in_base) {
+            normal = display_path(normal);
+        }
+        id = intern(canonical_, normal.empty() ? path : normal);
+    } else {
+        FileKey key{static_cast<std::uint64_t>(info.st_dev),
+                    static_cast<std::uint64_t>(info.st_ino)};
+        if (auto it = inodes_.find(key); it != inodes_.end()) {
+            id = it->second;
+        } else {
+            std::error_code error;
+            auto real = std::filesystem::canonical(lookup, error);
+            id = intern(canonical_, error ? lookup : display_path(real.string()));
+            inodes_.emplace(key, id);
+        }
+    }
+
+    spellings_.emplace(path, id);
+    return id;
+}
+
+} // namespace nolint
@@ -0,0 +1,85 @@
+#include "prefix_map.hpp"
+#include <cstdlib>
+
+namespace nolint {
+
+namespace {
+
+auto find_child(const PrefixTrieNode& node, char c) -> std::optional<std::uint32_t> {
+    for (const auto& [edge, child] : node.children) {
+        if (edge == c) {
+            return child;
+        }
+    }
+    return std::nullopt;
+}
+
+} // namespace
+
+auto parse_prefix_rule(std::string_view rule)
+    -> std::optional<std::pair<std::string, std::string>> {
+    auto equals = rule.find('=');
+    if (equals == std::string_view::npos || equals == 0) {
+        return std::nullopt;
+    }
+
+    std::string from(rule.substr(0, equals));
+    std::string to(rule.substr(equals + 1));
+    if (to.starts_with("~/")) {
+        if (const char* home = std::getenv("HOME"); home != nullptr && *home != '\0') {
+            to = home + to.substr(1);
+        }
+    }
+    return std::pair{std::move(from), std::move(to)};
+}
+
+auto add_prefix_rule(PrefixMap& map, std::string_view from, std::string_view to) -> void {
+    std::uint32_t node = 0;
+    for (char c : from) {
+        auto child = find_child(map.nodes[node], c);
+        if (!child) {
+            child = static_cast<std::uint32_t>(map.nodes.size());
+            map.nodes[node].children.emplace_back(c, *child);
+            map.nodes.emplace_back();
+        }
+        node = *child;
+    }
+
+    if (map.nodes[node].rule) {
+        map.replacements[*map.nodes[node].rule] = std::string(to);
+    } else {
+        map.nodes[node].rule = static_cast<std::uint32_t>(map.replacements.size());
+        map.replacements.emplace_back(to);
+    }
+}
+
+auto map_prefix(const PrefixMap& map, std::string_view path) -> std::optional<std::string> {
+    std::optional<std::uint32_t> best_rule;
+    size_t best_length = 0;
+
+    std::uint32_t node = 0;
+    for (size_t depth = 0;; ++depth) {
+        const auto& current = map.nodes[node];
+        bool on_boundary = depth == path.size() || path[depth] == '/'
+                           || (depth > 0 && path[depth - 1] == '/');
+        if (current.rule && depth > 0 && on_boundary) {
+            best_rule = current.rule;
+            best_length = depth;
+        }
+        if (depth == path.size()) {
+            break;
+        }
+        auto child = find_child(current, path[depth]);
+        if (!child) {
+            break;
+        }
+        node = *child;
+    }
+
+    if (!best_rule) {
+        return std::nullopt;
+    }
+    return map.replacements[*best_rule] + std::string(path.substr(best_length));
+}
+
+} // namespace nolint
@@ -0,0 +1,169 @@
+#include "progress.hpp"
+#include <cmath>
+#include <sstream>
+
+namespace nolint {
+
+namespace {
+
+auto refresh_interval(ProgressFormat format) -> std::chrono::milliseconds {
+    // JSON goes to logs, so keep it sparse
+    return format == ProgressFormat::JSON ? std::chrono::milliseconds(1000)
+                                          : std::chrono::milliseconds(200);
+}
+
+auto rate(std::uint64_t count, double seconds) -> double {
+    return seconds > 0.0 ? static_cast<double>(count) / seconds : 0.0;
+}
+
+auto format_bytes_per_second(double bytes_per_second) -> std::string {
+    std::ostringstream out;
+    out.setf(std::ios::fixed);
+    out.precision(1);
+    if (bytes_per_second >= 1024.0 * 1024.0) {
+        out << bytes_per_second / (1024.0 * 1024.0) << " MB/s";
+    } else {
+        out << bytes_per_second / 1024.0 << " KB/s";
+    }
+    return out.str();
+}
+
+} // namespace
+
+auto take_snapshot(const ProgressCounters& counters, double elapsed_seconds) -> ProgressSnapshot {
+    return ProgressSnapshot{
+        .bytes_done = counters.bytes_done.load(std::memory_order_relaxed),
+        .bytes_total = counters.bytes_total.load(std::memory_order_relaxed),
+        .warnings_done = counters.warnings_done.load(std::memory_order_relaxed),
+        .files_done = counters.files_done.load(std::memory_order_relaxed),
+        .files_total = counters.files_total.load(std::memory_order_relaxed),
+        .elapsed_seconds = elapsed_seconds};
+}
+
+auto progress_percent(const ProgressSnapshot& snapshot) -> double {
+    if (snapshot.bytes_total > 0) {
+        return 100.0 * static_cast<double>(snapshot.bytes_done)
+               / static_cast<double>(snapshot.bytes_total);
+    }
+    if (snapshot.files_total > 0) {
+        return 100.0 * static_cast<double>(snapshot.files_done)
+               / static_cast<double>(snapshot.files_total);
+    }
+    return -1.0;
+}
+
+auto progress_eta_seconds(const ProgressSnapshot& snapshot) -> double {
+    double percent = progress_percent(snapshot);
+    if (percent <= 0.0 || snapshot.elapsed_seconds <= 0.0) {
+        return -1.0;
+    }
+    return snapshot.elapsed_seconds * (100.0 - percent) / percent;
+}
+
+auto format_progress_line(const std::string& phase, const ProgressSnapshot& snapshot)
+    -> std::string {
+    std::ostringstream out;
+    out.setf(std::ios::fixed);
+    out.precision(1);
+
+    out << phase;
+    if (double percent = progress_percent(snapshot); percent >= 0.0) {
+        out << "  " << percent << "%";
+    }
+    if (snapshot.bytes_done > 0) {
+        out << " | " << format_bytes_per_second(rate(snapshot.bytes_done, snapshot.elapsed_seconds));
+    }
+    if (snapshot.warnings_done > 0) {
+        out << " | " << snapshot.warnings_done << " warnings ("
+            << std::llround(rate(snapshot.warnings_done, snapshot.elapsed_seconds)) << "/s)";
+    }
+    if (snapshot.files_total > 0 || snapshot.files_done > 0) {
+        out << " | " << snapshot.files_done;
+        if (snapshot.files_total > 0) {
+            out << "/" << snapshot.files_total;
+        }
+        out << " files (" << rate(snapshot.files_done, snapshot.elapsed_seconds) << "/s)";
+    }
+    if (double eta = progress_eta_seconds(snapshot); eta >= 0.0) {
+        out << " | ETA " << std::llround(eta) << "s";
+    }
+
+    return out.str();
+}
+
+auto format_progress_json(const std::string& phase, const ProgressSnapshot& snapshot,
+                          bool finished) -> std::string {
+    std::ostringstream out;
+    out.setf(std::ios::fixed);
+    out.precision(3);
+
+    out << R"({"event":")" << (finished ? "done" : "progress") << R"(","phase":")" << phase
+        << R"(","elapsed_s":)" << snapshot.elapsed_seconds << R"(,"bytes":)"
+        << snapshot.bytes_done << R"(,"bytes_total":)" << snapshot.bytes_total
+        << R"(,"bytes_per_s":)" << rate(snapshot.bytes_done, snapshot.elapsed_seconds)
+        << R"(,"warnings":)" << snapshot.warnings_done << R"(,"warnings_per_s":)"
+        << rate(snapshot.warnings_done, snapshot.elapsed_seconds) << R"(,"files":)"
+        << snapshot.files_done << R"(,"files_total":)" << snapshot.files_total
+        << R"(,"files_per_s":)" << rate(snapshot.files_done, snapshot.elapsed_seconds)
+        << R"(,"percent":)" << progress_percent(snapshot) << R"(,"eta_s":)"
+        << progress_eta_seconds(snapshot) << "}";
+
+    return out.str();
+}
+
+auto parse_progress_format(const std::string& value) -> std::optional<ProgressFormat> {
+    if (value == "line") {
+        return ProgressFormat::LINE;
+    }
+    if (value == "json") {
+        return ProgressFormat::JSON;
+    }
+    if (value == "none") {
+        return ProgressFormat::NONE;
+    }
+    return std::nullopt;
+}
+
+ProgressReporter::ProgressReporter(std::string phase, const ProgressCounters& counters,
+                                   ProgressFormat format, std::ostream& output)
+    : phase_(std::move(phase)), counters_(counters), format_(format), output_(output),
+      start_(std::chrono::steady_clock::now()) {
+    if (format_ != ProgressFormat::NONE) {
+        worker_ = std::thread([this] { run(); });
+    }
+}
+
+ProgressReporter::~ProgressReporter() {
+    if (!worker_.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard lock(mutex_);
+        stopping_ = true;
+    }
+    stop_signal_.notify_all();
+    worker_.join();
+    report(true);
+}
+
+auto ProgressReporter::run() -> void {
+    std::unique_lock lock(mutex_);
+    while (!stop_signal_.wait_for(lock, refresh_interval(format_), [this] { return stopping_; })) {
+        report(false);
+    }
+}
+
+auto ProgressReporter::report(bool finished) -> void {
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_;
+    auto snapshot = take_snapshot(counters_, elapsed.count());
+
+    if (format_ == ProgressFormat::JSON) {
+        output_ << format_progress_json(phase_, snapshot, finished) << "\n" << std::flush;
+    } else {
+        // Carriage return + erase line keeps a single refreshing status line
+        output_ << "\r\x1b[K" << format_progress_line(phase_, snapshot) << (finished ? "\n" : "")
+                << std::flush;
+    }
+}
+
+} // namespace nolint
@@ -0,0 +1,306 @@
+#include "shard.hpp"
+#include "stable_hash.hpp"
+#include <algorithm>
+#include <charconv>
+#include <sstream>
+
+namespace nolint {
+
+namespace {
+
+auto parse_number(std::string_view text) -> std::optional<std::uint64_t> {
+    std::uint64_t value = 0;
+    auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (error != std::errc{} || end == text.data()) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+auto json_escape(std::string_view text) -> std::string {
+    static constexpr char HEX[] = "0123456789abcdef";
+    std::string escaped;
+    escaped.reserve(text.size());
+    for (char c : text) {
+        auto byte = static_cast<unsigned char>(c);
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+            escaped += c;
+        } else if (byte < 0x20) {
+            escaped += "\\u00";
+            escaped += HEX[byte >> 4];
+            escaped += HEX[byte & 0xF];
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+// Value of "key":"..." in one of our own JSON lines (flat objects only)
+auto string_field(std::string_view line, std::string_view key) -> std::optional<std::string> {
+    std::string needle = "\"";
+    needle += key;
+    needle += "\":\"";
+    auto pos = line.find(needle);
+    if (pos == std::string_view::npos) {
+        return std::nullopt;
+    }
+
+    std::string value;
+    for (pos += needle.size(); pos < line.size(); ++pos) {
+        char c = line[pos];
+        if (c == '"') {
+            return value;
+        }
+        if (c != '\\' || pos + 1 >= line.size()) {
+            value += c;
+            continue;
+        }
+        char escaped = line[++pos];
+        if (escaped == 'u') {
+            // Only \u00XX is ever written, for control characters
+            unsigned code = 0;
+            auto digits = line.substr(pos + 1, 4);
+            auto [end, error]
+                = std::from_chars(digits.data(), digits.data() + digits.size(), code, 16);
+            if (error != std::errc{} || digits.size() != 4 || end != digits.data() + 4
+                || code > 0xFF) {
+                return std::nullopt;
+            }
+            value += static_cast<char>(code);
+            pos += 4;
+        } else {
+            value += (escaped == 'n') ? '\n' : (escaped == 't') ? '\t' : escaped;
+        }
+    }
+    return std::nullopt;
+}
+
+// Value of "key":123 in one of our own JSON lines
+auto number_field(std::string_view line, std::string_view key) -> std::optional<std::uint64_t> {
+    std::string needle = "\"";
+    needle += key;
+    needle += "\":";
+    auto pos = line.find(needle);
+    if (pos == std::string_view::npos) {
+        return std::nullopt;
+    }
+    return parse_number(line.substr(pos + needle.size()));
+}
+
+auto format_file_line(const ShardFileResult& file, std::string_view shard) -> std::string {
+    std::ostringstream out;
+    out << R"({"event":"file","shard":")" << shard << R"(","path":")" << json_escape(file.path)
+        << R"(","status":")" << (file.modified ? "modified" : "failed")
+        << R"(","suppressions":)" << file.suppressions << "}\n";
+    return out.str();
+}
+
+} // namespace
+
+auto parse_shard_spec(std::string_view text) -> std::optional<ShardSpec> {
+    auto slash = text.find('/');
+    if (slash == std::string_view::npos) {
+        return std::nullopt;
+    }
+    auto index = parse_number(text.substr(0, slash));
+    auto count = parse_number(text.substr(slash + 1));
+    if (!index || !count || *index < 1 || *index > *count || *count > UINT32_MAX
+        || text.substr(0, slash).size() != std::to_string(*index).size()
+        || text.substr(slash + 1).size() != std::to_string(*count).size()) {
+        return std::nullopt;
+    }
+    return ShardSpec{.index = static_cast<std::uint32_t>(*index - 1),
+                     .count = static_cast<std::uint32_t>(*count)};
+}
+
+auto format_shard_spec(ShardSpec shard) -> std::string {
+    return std::to_string(shard.index + 1) + "/" + std::to_string(shard.count);
+}
+
+auto shard_of_path(std::string_view relative_path, std::uint32_t count) -> std::uint32_t {
+    return (count == 0) ? 0 : static_cast<std::uint32_t>(stable_hash(relative_path) % count);
+}
+
+auto shard_relative_path(std::string_view path, const std::filesystem::path& root)
+    -> std::string {
+    std::filesystem::path absolute(path);
+    if (absolute.is_relative()) {
+        std::error_code error;
+        absolute = std::filesystem::current_path(error) / absolute;
+    }
+    absolute = absolute.lexically_normal();
+
+    auto normal_root = root.lexically_normal();
+    if (!normal_root.has_filename()) {
+        normal_root = normal_root.parent_path(); // "/repo/" -> "/repo"
+    }
+    auto relative = absolute.lexically_relative(normal_root);
+    if (relative.empty() || *relative.begin() == "..") {
+        return absolute.generic_string();
+    }
+    return relative.generic_string();
+}
+
+auto select_shard(const std::vector<Warning>& warnings, ShardSpec shard,
+                  const std::filesystem::path& root) -> std::vector<Warning> {
+    std::vector<Warning> selected;
+    const std::string* last_path = nullptr;
+    bool last_owned = false;
+    for (const auto& warning : warnings) {
+        // Warnings arrive grouped by file, so hash each run of one path once
+        if (last_path == nullptr || warning.file_path != *last_path) {
+            last_path = &warning.file_path;
+            last_owned = shard_of_path(shard_relative_path(*last_path, root), shard.count)
+                         == shard.index;
+        }
+        if (last_owned) {
+            selected.push_back(warning);
+        }
+    }
+    return selected;
+}
+
+auto find_repository_root(const std::filesystem::path& start) -> std::filesystem::path {
+    std::error_code error;
+    for (auto directory = start; !directory.empty(); directory = directory.parent_path()) {
+        if (std::filesystem::exists(directory / ".git", error)) {
+            return directory;
+        }
+        if (directory == directory.parent_path()) {
+            break;
+        }
+    }
+    return {};
+}
+
+auto format_shard_result(const ShardResult& result) -> std::string {
+    auto shard = format_shard_spec(result.shard);
+    std::string text;
+    size_t modified = 0;
+    for (const auto& file : result.files) {
+        text += format_file_line(file, shard);
+        modified += file.modified ? 1 : 0;
+    }
+
+    std::ostringstream summary;
+    summary << R"({"event":"shard","shard":")" << shard << R"(","warnings":)" << result.warnings
+            << R"(,"files":)" << result.files.size() << R"(,"modified":)" << modified
+            << R"(,"failed":)" << (result.files.size() - modified) << "}\n";
+    return text + summary.str();
+}
+
+auto parse_shard_result(std::istream& input) -> std::optional<ShardResult> {
+    ShardResult result;
+    bool have_summary = false;
+    for (std::string line; std::getline(input, line);) {
+        if (line.empty()) {
+            continue;
+        }
+        auto event = string_field(line, "event");
+        auto shard = string_field(line, "shard");
+        auto spec = shard ? parse_shard_spec(*shard) : std::nullopt;
+        if (!event || !spec) {
+            return std::nullopt;
+        }
+
+        if (*event == "file") {
+            auto path = string_field(line, "path");
+            auto status = string_field(line, "status");
+            auto suppressions = number_field(line, "suppressions");
+            if (!path || !status || !suppressions) {
+                return std::nullopt;
+            }
+            result.files.push_back(ShardFileResult{.path = *path,
+                                                   .modified = *status == "modified",
+                                                   .suppressions = *suppressions});
+        } else if (*event == "shard") {
+            auto warnings = number_field(line, "warnings");
+            if (!warnings) {
+                return std::nullopt;
+            }
+            result.shard = *spec;
+            result.warnings = *warnings;
+            have_summary = true;
+        }
+    }
+    return have_summary ? std::optional(std::move(result)) : std::nullopt;
+}
+
+auto merge_shard_results(const std::vector<ShardResult>& results) -> MergedShards {
+    MergedShards merged;
+    merged.shard_count = results.empty() ? 0 : results.front().shard.count;
+
+    std::vector<int> seen(merged.shard_count, 0);
+    for (const auto& result : results) {
+        merged.warnings += result.warnings;
+        if (result.shard.count != merged.shard_count) {
+            merged.mismatched_counts.push_back(result.shard.count);
+        } else if (seen[result.shard.index]++ == 1) {
+            merged.duplicate_shards.push_back(result.shard.index);
+        }
+        merged.files.insert(merged.files.end(), result.files.begin(), result.files.end());
+    }
+    for (std::uint32_t i = 0; i < merged.shard_count; ++i) {
+        if (seen[i] == 0) {
+            merged.missing_shards.push_back(i);
+        }
+    }
+    std::sort(merged.mismatched_counts.begin(), merged.mismatched_counts.end());
+    merged.mismatched_counts.erase(
+        std::unique(merged.mismatched_counts.begin(), merged.mismatched_counts.end()),
+        merged.mismatched_counts.end());
+
+    // Shards own disjoint files, so a path seen twice after sorting is a conflict
+    std::stable_sort(merged.files.begin(), merged.files.end(),
+                     [](const ShardFileResult& a, const ShardFileResult& b) {
+                         return a.path < b.path;
+                     });
+    for (size_t i = 1; i < merged.files.size(); ++i) {
+        if (merged.files[i].path == merged.files[i - 1].path
+            && (merged.conflicts.empty() || merged.conflicts.back() != merged.files[i].path)) {
+            merged.conflicts.push_back(merged.files[i].path);
+        }
+    }
+    return merged;
+}
+
+auto format_merged_shards(const MergedShards& merged) -> std::string {
+    std::string text;
+    size_t modified = 0;
+    for (const auto& file : merged.files) {
+        text += format_file_line(file, "merged");
+        modified += file.modified ? 1 : 0;
+    }
+
+    auto list = [](const std::vector<std::uint32_t>& shards) {
+        std::string items;
+        for (auto index : shards) {
+            items += items.empty() ? "" : ",";
+            items += std::to_string(index + 1);
+        }
+        return "[" + items + "]";
+    };
+    std::string mismatched;
+    for (auto count : merged.mismatched_counts) {
+        mismatched += mismatched.empty() ? "" : ",";
+        mismatched += std::to_string(count);
+    }
+    std::string conflicts;
+    for (const auto& path : merged.conflicts) {
+        conflicts += (conflicts.empty() ? "\"" : ",\"") + json_escape(path) + "\"";
+    }
+
+    std::ostringstream summary;
+    summary << R"({"event":"merged","shards":)" << merged.shard_count << R"(,"mismatched_counts":[)"
+            << mismatched << R"(],"missing":)"
+            << list(merged.missing_shards) << R"(,"duplicates":)"
+            << list(merged.duplicate_shards) << R"(,"warnings":)" << merged.warnings
+            << R"(,"files":)" << merged.files.size() << R"(,"modified":)" << modified
+            << R"(,"failed":)" << (merged.files.size() - modified) << R"(,"conflicts":[)"
+            << conflicts << "]}\n";
+    return text + summary.str();
+}
+
+} // namespace nolint
@@ -0,0 +1,283 @@
+#include "sidecar_index.hpp"
+#include "stable_hash.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <limits>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <type_traits>
+#include <unistd.h>
+
+namespace nolint {
+
+namespace {
+
+constexpr char SIDECAR_MAGIC[8] = {'N', 'O', 'L', 'I', 'N', 'T', 'L', 'X'};
+
+static_assert(std::is_trivially_copyable_v<TokenSpan>);
+
+struct SidecarHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t path_length;
+    std::uint64_t size;
+    std::int64_t modified;
+    std::uint64_t content_hash; // line_hash over every line, checked as lines are rebuilt
+    std::uint32_t line_count;
+    std::uint32_t lexed_lines;
+    std::uint32_t token_count;
+    std::uint32_t raw_delimiter_length;
+    std::uint8_t in_block_comment;
+    std::uint8_t in_raw_string;
+    std::uint8_t in_preprocessor;
+    std::uint8_t reserved[5];
+};
+
+constexpr auto align4(size_t offset) -> size_t { return (offset + 3) & ~size_t{3}; }
+
+// Byte offsets of the three arrays that follow the header and its strings
+struct SidecarLayout {
+    size_t line_offsets = 0;
+    size_t token_starts = 0;
+    size_t tokens = 0;
+    size_t total = 0;
+};
+
+auto layout_of(const SidecarHeader& header) -> SidecarLayout {
+    SidecarLayout layout;
+    layout.line_offsets
+        = align4(sizeof(SidecarHeader) + header.path_length + header.raw_delimiter_length);
+    layout.token_starts
+        = layout.line_offsets + (size_t{header.line_count} + 1) * sizeof(std::uint32_t);
+    layout.tokens = align4(layout.token_starts
+                           + (size_t{header.lexed_lines} + 1) * sizeof(std::uint32_t));
+    layout.total = layout.tokens + size_t{header.token_count} * sizeof(TokenSpan);
+    return layout;
+}
+
+// Read-only mapping of a whole file, unmapped on scope exit
+class MappedFile {
+public:
+    explicit MappedFile(const std::filesystem::path& path) {
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return;
+        }
+        struct stat info {};
+        if (::fstat(fd, &info) == 0 && info.st_size > 0) {
+            size_ = static_cast<size_t>(info.st_size);
+            void* data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            data_ = (data == MAP_FAILED) ? nullptr : static_cast<const char*>(data);
+        }
+        ::close(fd);
+    }
+    ~MappedFile() {
+        if (data_ != nullptr) {
+            ::munmap(const_cast<char*>(data_), size_);
+        }
+    }
+    MappedFile(const MappedFile&) = delete;
+    auto operator=(const MappedFile&) -> MappedFile& = delete;
+
+    auto data() const -> const char* { return data_; }
+    auto size() const -> size_t { return (data_ != nullptr) ? size_ : 0; }
+
+private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+// Hash of the lines so far, extended by one more line and its newline
+auto line_hash(std::uint64_t hash, std::string_view line) -> std::uint64_t {
+    return stable_hash("\n", stable_hash(line, hash));
+}
+
+template <typename T>
+auto read_array(const char* base, size_t offset, size_t count) -> std::vector<T> {
+    std::vector<T> values(count);
+    std::memcpy(values.data(), base + offset, count * sizeof(T));
+    return values;
+}
+
+} // namespace
+
+auto default_sidecar_directory() -> std::filesystem::path {
+    if (const char* cache = std::getenv("XDG_CACHE_HOME"); cache != nullptr && *cache != '\0') {
+        return std::filesystem::path(cache) / "nolint" / "index";
+    }
+    if (const char* home = std::getenv("HOME"); home != nullptr && *home != '\0') {
+        return std::filesystem::path(home) / ".cache" / "nolint" / "index";
+    }
+    return {};
+}
+
+auto make_sidecar_key(const std::string& path, std::uintmax_t size,
+                      std::filesystem::file_time_type modified) -> SidecarKey {
+    return SidecarKey{.path = path,
+                      .size = static_cast<std::uint64_t>(size),
+                      .modified = static_cast<std::int64_t>(modified.time_since_epoch().count())};
+}
+
+auto sidecar_path(const std::filesystem::path& directory, const std::string& path)
+    -> std::filesystem::path {
+    static constexpr char HEX[] = "0123456789abcdef";
+    auto hash = stable_hash(path);
+    std::string name(16, '0');
+    for (size_t i = 0; i < name.size(); ++i) {
+        name[name.size() - 1 - i] = HEX[(hash >> (4 * i)) & 0xF];
+    }
+    return directory / (name + ".nlx");
+}
+
+auto load_sidecar_index(const std::filesystem::path& directory, const SidecarKey& key,
+                        std::string_view content, SourceFile& file) -> bool {
+    MappedFile mapped(sidecar_path(directory, key.path));
+    if (mapped.size() < sizeof(SidecarHeader)) {
+        return false;
+    }
+
+    SidecarHeader header{};
+    std::memcpy(&header, mapped.data(), sizeof(header));
+    if (std::memcmp(header.magic, SIDECAR_MAGIC, sizeof(SIDECAR_MAGIC)) != 0
+        || header.version != SIDECAR_VERSION
+        || header.size != key.size
+        || header.modified != key.modified
+        || header.path_length != key.path.size()
+        || header.lexed_lines > header.line_count) {
+        return false;
+    }
+    auto layout = layout_of(header);
+    if (layout.total != mapped.size()
+        || std::string_view(mapped.data() + sizeof(header), header.path_length) != key.path) {
+        return false;
+    }
+
+    auto offsets
+        = read_array<std::uint32_t>(mapped.data(), layout.line_offsets, header.line_count + 1);
+    auto token_starts
+        = read_array<std::uint32_t>(mapped.data(), layout.token_starts, header.lexed_lines + 1);
+    if (offsets.front() != 0 || (header.line_count > 0 && offsets.back() < content.size())) {
+        return false;
+    }
+    for (size_t i = 0; i < header.line_count; ++i) {
+        size_t end = offsets[i + 1] - size_t{1};
+        if (offsets[i + 1] <= offsets[i] || end > content.size()
+            || (end < content.size() && content[end] != '\n')) {
+            return false;
+        }
+    }
+    if (token_starts.back() != header.token_count) {
+        return false;
+    }
+
+    // Rebuilding the lines touches every byte anyway, so the hash is checked in
+    // the same pass: equal size, mtime and line breaks alone can still be stale
+    std::vector<std::string> lines;
+    lines.reserve(header.line_count);
+    std::uint64_t content_hash = stable_hash("");
+    for (size_t i = 0; i < header.line_count; ++i) {
+        auto line = content.substr(offsets[i], offsets[i + 1] - offsets[i] - 1);
+        content_hash = line_hash(content_hash, line);
+        lines.emplace_back(line);
+    }
+    if (content_hash != header.content_hash) {
+        return false;
+    }
+    auto spans = read_array<TokenSpan>(mapped.data(), layout.tokens, header.token_count);
+    std::vector<std::vector<TokenSpan>> tokens(header.lexed_lines);
+    for (size_t i = 0; i < header.lexed_lines; ++i) {
+        if (token_starts[i] > token_starts[i + 1]) {
+            return false;
+        }
+        tokens[i].assign(spans.begin() + token_starts[i], spans.begin() + token_starts[i + 1]);
+        for (const auto& span : tokens[i]) {
+            if (size_t{span.start} + span.length > lines[i].size()) {
+                return false;
+            }
+        }
+    }
+
+    file.lines = std::move(lines);
+    file.tokens = std::move(tokens);
+    file.token_count = header.token_count;
+    file.state = LexState{.in_block_comment = header.in_block_comment != 0,
+                          .in_raw_string = header.in_raw_string != 0,
+                          .in_preprocessor = header.in_preprocessor != 0,
+                          .raw_delimiter = std::string(mapped.data() + sizeof(header)
+                                                           + header.path_length,
+                                                       header.raw_delimiter_length)};
+    return true;
+}
+
+auto save_sidecar_index(const std::filesystem::path& directory, const SidecarKey& key,
+                        const SourceFile& file) -> bool {
+    constexpr auto MAX_OFFSET = std::numeric_limits<std::uint32_t>::max();
+    if (key.size >= MAX_OFFSET || file.token_count >= MAX_OFFSET) {
+        return false;
+    }
+
+    SidecarHeader header{};
+    std::memcpy(header.magic, SIDECAR_MAGIC, sizeof(SIDECAR_MAGIC));
+    header.version = SIDECAR_VERSION;
+    header.path_length = static_cast<std::uint32_t>(key.path.size());
+    header.size = key.size;
+    header.modified = key.modified;
+    std::uint64_t content_hash = stable_hash("");
+    for (const auto& line : file.lines) {
+        content_hash = line_hash(content_hash, line);
+    }
+    header.content_hash = content_hash;
+    header.line_count = static_cast<std::uint32_t>(file.lines.size());
+    header.lexed_lines = static_cast<std::uint32_t>(file.tokens.size());
+    header.token_count = static_cast<std::uint32_t>(file.token_count);
+    header.raw_delimiter_length = static_cast<std::uint32_t>(file.state.raw_delimiter.size());
+    header.in_block_comment = file.state.in_block_comment ? 1 : 0;
+    header.in_raw_string = file.state.in_raw_string ? 1 : 0;
+    header.in_preprocessor = file.state.in_preprocessor ? 1 : 0;
+    auto layout = layout_of(header);
+
+    std::string buffer(layout.total, '\0');
+    std::memcpy(buffer.data(), &header, sizeof(header));
+    std::memcpy(buffer.data() + sizeof(header), key.path.data(), key.path.size());
+    std::memcpy(buffer.data() + sizeof(header) + key.path.size(), file.state.raw_delimiter.data(),
+                file.state.raw_delimiter.size());
+
+    std::uint32_t offset = 0;
+    for (size_t i = 0; i <= file.lines.size(); ++i) {
+        std::memcpy(buffer.data() + layout.line_offsets + i * sizeof(offset), &offset,
+                    sizeof(offset));
+        if (i < file.lines.size()) {
+            offset += static_cast<std::uint32_t>(file.lines[i].size() + 1);
+        }
+    }
+    std::uint32_t token_start = 0;
+    char* spans = buffer.data() + layout.tokens;
+    for (size_t i = 0; i <= file.tokens.size(); ++i) {
+        std::memcpy(buffer.data() + layout.token_starts + i * sizeof(token_start), &token_start,
+                    sizeof(token_start));
+        if (i < file.tokens.size()) {
+            std::memcpy(spans + size_t{token_start} * sizeof(TokenSpan), file.tokens[i].data(),
+                        file.tokens[i].size() * sizeof(TokenSpan));
+            token_start += static_cast<std::uint32_t>(file.tokens[i].size());
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    auto target = sidecar_path(directory, key.path);
+    auto temporary = target;
+    temporary += ".tmp" + std::to_string(::getpid());
+    {
+        std::ofstream output(temporary, std::ios::binary | std::ios::trunc);
+        if (!output.write(buffer.data(), static_cast<std::streamsize>(buffer.size()))) {
+            std::filesystem::remove(temporary, error);
+            return false;
+        }
+    }
+    std::filesystem::rename(temporary, target, error);
+    return !error;
+}
+
+} // namespace nolint
@@ -0,0 +1,252 @@
+#include "source_cache.hpp"
+#include "batch_io.hpp"
+#include "sidecar_index.hpp"
+#include <fstream>
+#include <sstream>
+
+namespace nolint {
+
+namespace {
+
+constexpr double BYTES_PER_MB = 1024.0 * 1024.0;
+
+auto hit_percent(const SourceCacheStats& stats) -> double {
+    auto lookups = stats.hits + stats.misses;
+    return (lookups == 0)
+               ? 0.0
+               : 100.0 * static_cast<double>(stats.hits) / static_cast<double>(lookups);
+}
+
+} // namespace
+
+auto ensure_lexed(SourceFile& file, size_t line_count) -> void {
+    line_count = std::min(line_count, file.lines.size());
+    if (file.tokens.size() < line_count) {
+        file.sidecar_current = false;
+    }
+    while (file.tokens.size() < line_count) {
+        file.tokens.push_back(lex_line(file.lines[file.tokens.size()], file.state));
+        file.token_count += file.tokens.back().size();
+    }
+}
+
+auto line_tokens(SourceFile& file, size_t line_index) -> const std::vector<TokenSpan>& {
+    static const std::vector<TokenSpan> no_tokens;
+    ensure_lexed(file, line_index + 1);
+    return (line_index < file.tokens.size()) ? file.tokens[line_index] : no_tokens;
+}
+
+auto resident_bytes(const SourceFile& file) -> size_t {
+    return static_cast<size_t>(file.size) + file.lines.size() * sizeof(std::string)
+           + file.tokens.size() * sizeof(std::vector<TokenSpan>)
+           + file.token_count * sizeof(TokenSpan);
+}
+
+auto format_cache_stats_line(const SourceCacheStats& stats) -> std::string {
+    std::ostringstream out;
+    out.setf(std::ios::fixed);
+    out.precision(1);
+
+    out << "cache  hits " << stats.hits << " | misses " << stats.misses << " ("
+        << hit_percent(stats) << "% hit) | evicted " << stats.evictions << " | "
+        << static_cast<double>(stats.resident_bytes) / BYTES_PER_MB << " MB";
+    if (stats.budget_bytes > 0) {
+        out << " / " << static_cast<double>(stats.budget_bytes) / BYTES_PER_MB << " MB";
+    }
+    out << " in " << stats.files << " files";
+    if (stats.sidecar_loads > 0) {
+        out << " | " << stats.sidecar_loads << " from sidecars";
+    }
+    return out.str();
+}
+
+auto format_cache_stats_json(const SourceCacheStats& stats) -> std::string {
+    std::ostringstream out;
+    out.setf(std::ios::fixed);
+    out.precision(3);
+
+    out << R"({"event":"cache","hits":)" << stats.hits << R"(,"misses":)" << stats.misses
+        << R"(,"hit_percent":)" << hit_percent(stats) << R"(,"evictions":)" << stats.evictions
+        << R"(,"sidecar_loads":)" << stats.sidecar_loads << R"(,"resident_bytes":)"
+        << stats.resident_bytes << R"(,"budget_bytes":)" << stats.budget_bytes << R"(,"files":)"
+        << stats.files << "}";
+    return out.str();
+}
+
+auto SourceCache::get(const std::string& path) -> std::shared_ptr<SourceFile> {
+    std::error_code error;
+    auto size = std::filesystem::file_size(path, error);
+    auto modified = error ? std::filesystem::file_time_type{}
+                          : std::filesystem::last_write_time(path, error);
+    auto it = files_.find(path);
+    bool repeated = path == last_lookup_;
+    if (!repeated) {
+        last_lookup_ = path;
+    }
+    if (error) {
+        if (it != files_.end()) {
+            erase(it);
+        }
+        return nullptr;
+    }
+
+    if (it != files_.end() && it->second.file->size == size
+        && it->second.file->modified == modified) {
+        if (!repeated) {
+            ++hits_;
+        }
+        auto& entry = it->second;
+        lru_.splice(lru_.begin(), lru_, entry.recency);
+
+        // Lexing since the last lookup may have grown the file
+        auto bytes = resident_bytes(*entry.file);
+        resident_bytes_ += bytes - entry.bytes;
+        entry.bytes = bytes;
+        evict_over_budget(path);
+        return entry.file;
+    }
+    if (it != files_.end()) {
+        erase(it);
+    }
+
+    std::ifstream input(path, std::ios::binary);
+    if (!input) {
+        return nullptr;
+    }
+    std::string content(static_cast<size_t>(size), '\0');
+    input.read(content.data(), static_cast<std::streamsize>(content.size()));
+    content.resize(static_cast<size_t>(input.gcount()));
+
+    auto file = load(path, size, modified, content);
+    insert(path, file);
+    return file;
+}
+
+auto SourceCache::prefetch(const std::vector<std::string>& paths) -> void {
+    struct Wanted {
+        std::string path;
+        std::uintmax_t size = 0;
+        std::filesystem::file_time_type modified;
+    };
+    std::vector<Wanted> wanted;
+    for (const auto& path : paths) {
+        std::error_code error;
+        auto size = std::filesystem::file_size(path, error);
+        auto modified = error ? std::filesystem::file_time_type{}
+                              : std::filesystem::last_write_time(path, error);
+        auto it = files_.find(path);
+        bool current = it != files_.end() && it->second.file->size == size
+                       && it->second.file->modified == modified;
+        if (!error && !current) {
+            wanted.push_back(Wanted{.path = path, .size = size, .modified = modified});
+        }
+    }
+
+    std::vector<std::string> wanted_paths;
+    for (const auto& file : wanted) {
+        wanted_paths.push_back(file.path);
+    }
+    auto contents = read_files(wanted_paths);
+    for (size_t i = 0; i < wanted.size(); ++i) {
+        if (contents[i]) {
+            if (auto it = files_.find(wanted[i].path); it != files_.end()) {
+                erase(it);
+            }
+            insert(wanted[i].path,
+                   load(wanted[i].path, wanted[i].size, wanted[i].modified, *contents[i]));
+        }
+    }
+}
+
+SourceCache::~SourceCache() {
+    for (const auto& [path, entry] : files_) {
+        persist(path, *entry.file);
+    }
+}
+
+auto SourceCache::load(const std::string& path, std::uintmax_t size,
+                       std::filesystem::file_time_type modified, std::string_view content)
+    -> std::shared_ptr<SourceFile> {
+    auto file = std::make_shared<SourceFile>();
+    file->size = size;
+    file->modified = modified;
+
+    if (!sidecar_directory_.empty()) {
+        if (load_sidecar_index(sidecar_directory_, make_sidecar_key(path, size, modified),
+                               content, *file)) {
+            file->sidecar_current = true;
+            ++sidecar_loads_;
+            return file;
+        }
+    }
+
+    file->lines = split_lines(content);
+    return file;
+}
+
+auto SourceCache::insert(const std::string& path, std::shared_ptr<SourceFile> file) -> void {
+    ++misses_;
+    lru_.push_front(path);
+    auto bytes = resident_bytes(*file);
+    files_.emplace(path, Entry{.file = std::move(file), .recency = lru_.begin(), .bytes = bytes});
+    resident_bytes_ += bytes;
+    evict_over_budget(path);
+}
+
+auto SourceCache::persist(const std::string& path, const SourceFile& file) -> void {
+    if (sidecar_directory_.empty() || file.sidecar_current) {
+        return;
+    }
+    std::error_code error;
+    if (std::filesystem::file_size(path, error) != file.size || error
+        || std::filesystem::last_write_time(path, error) != file.modified || error) {
+        return; // Changed on disk since it was read
+    }
+    save_sidecar_index(sidecar_directory_, make_sidecar_key(path, file.size, file.modified),
+                       file);
+}
+
+auto SourceCache::invalidate(const std::string& path) -> void {
+    if (auto it = files_.find(path); it != files_.end()) {
+        erase(it);
+    }
+}
+
+auto SourceCache::stats() const -> SourceCacheStats {
+    return SourceCacheStats{.hits = hits_,
+                            .misses = misses_,
+                            .evictions = evictions_,
+                            .sidecar_loads = sidecar_loads_,
+                            .resident_bytes = resident_bytes_,
+                            .budget_bytes = budget_bytes_,
+                            .files = files_.size()};
+}
+
+auto SourceCache::erase(std::unordered_map<std::string, Entry>::iterator it) -> void {
+    resident_bytes_ -= it->second.bytes;
+    lru_.erase(it->second.recency);
+    files_.erase(it);
+}
+
+auto SourceCache::evict_over_budget(const std::string& keep) -> void {
+    if (budget_bytes_ == 0) {
+        return;
+    }
+
+    // Least recently used unpinned files first, then pinned ones if still over
+    for (bool evict_pinned : {false, true}) {
+        auto recency = lru_.end();
+        while (resident_bytes_ > budget_bytes_ && recency != lru_.begin()) {
+            --recency;
+            if (*recency == keep || pinned_.contains(*recency) != evict_pinned) {
+                continue;
+            }
+            auto victim = files_.find(*recency++);
+            persist(victim->first, *victim->second.file);
+            erase(victim);
+            ++evictions_;
+        }
+    }
+}
+
+} // namespace nolint
@@ -0,0 +1,22 @@
+#include "string_pool.hpp"
+
+namespace nolint {
+
+auto intern(StringPool& pool, std::string_view name) -> std::uint32_t {
+    auto [it, inserted]
+        = pool.ids.try_emplace(std::string(name), static_cast<std::uint32_t>(pool.names.size()));
+    if (inserted) {
+        pool.names.push_back(it->first);
+    }
+    return it->second;
+}
+
+auto find_interned(const StringPool& pool, std::string_view name) -> std::optional<std::uint32_t> {
+    auto it = pool.ids.find(std::string(name));
+    if (it == pool.ids.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+} // namespace nolint
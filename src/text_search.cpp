@@ -0,0 +1,131 @@
+#include "text_search.hpp"
+#include <bit>
+#include <cstdint>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace nolint {
+
+namespace {
+
+constexpr auto fold_byte(char c) -> char {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c + ('a' - 'A')) : c;
+}
+
+// Compare `length` bytes of haystack against an already folded needle
+auto equals_folded(const char* haystack, const char* lower_needle, size_t length) -> bool {
+    for (size_t i = 0; i < length; ++i) {
+        if (fold_byte(haystack[i]) != lower_needle[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Scalar search of candidate start positions [from, last_start]
+auto search_scalar(std::string_view haystack, std::string_view lower_needle, size_t from) -> bool {
+    size_t last_start = haystack.size() - lower_needle.size();
+    for (size_t i = from; i <= last_start; ++i) {
+        if (fold_byte(haystack[i]) == lower_needle.front()
+            && equals_folded(haystack.data() + i + 1, lower_needle.data() + 1,
+                             lower_needle.size() - 1)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+#if defined(__SSE2__)
+
+constexpr size_t BLOCK_SIZE = 16;
+
+// Lowercase 16 ASCII bytes at once; bytes outside 'A'..'Z' pass through
+auto fold_block(__m128i block) -> __m128i {
+    const __m128i below_upper = _mm_set1_epi8('A' - 1);
+    const __m128i above_upper = _mm_set1_epi8('Z' + 1);
+    const __m128i case_bit = _mm_set1_epi8('a' - 'A');
+
+    __m128i is_upper
+        = _mm_and_si128(_mm_cmpgt_epi8(block, below_upper), _mm_cmplt_epi8(block, above_upper));
+    return _mm_add_epi8(block, _mm_and_si128(is_upper, case_bit));
+}
+
+auto load_block(const char* data) -> __m128i {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+}
+
+#endif
+
+} // namespace
+
+auto fold_case(std::string_view text) -> std::string {
+    std::string folded(text);
+    for (auto& c : folded) {
+        c = fold_byte(c);
+    }
+    return folded;
+}
+
+auto contains_case_insensitive(std::string_view haystack, std::string_view lower_needle) -> bool {
+    if (lower_needle.empty()) {
+        return true;
+    }
+    if (lower_needle.size() > haystack.size()) {
+        return false;
+    }
+
+    size_t from = 0;
+
+#if defined(__SSE2__)
+    // Compare the first and last needle bytes against 16 candidate starts per step;
+    // only positions where both match are verified byte by byte.
+    const size_t last_offset = lower_needle.size() - 1;
+    const __m128i first = _mm_set1_epi8(lower_needle.front());
+    const __m128i last = _mm_set1_epi8(lower_needle.back());
+
+    for (; from + last_offset + BLOCK_SIZE <= haystack.size(); from += BLOCK_SIZE) {
+        __m128i first_block = fold_block(load_block(haystack.data() + from));
+        __m128i last_block = fold_block(load_block(haystack.data() + from + last_offset));
+        __m128i both = _mm_and_si128(_mm_cmpeq_epi8(first_block, first),
+                                     _mm_cmpeq_epi8(last_block, last));
+
+        auto candidates = static_cast<std::uint32_t>(_mm_movemask_epi8(both));
+        while (candidates != 0) {
+            size_t start = from + std::countr_zero(candidates);
+            if (last_offset < 2
+                || equals_folded(haystack.data() + start + 1, lower_needle.data() + 1,
+                                 last_offset - 1)) {
+                return true;
+            }
+            candidates &= candidates - 1;
+        }
+    }
+#endif
+
+    // Remaining candidate starts that do not fill a whole block
+    return search_scalar(haystack, lower_needle, from);
+}
+
+auto find_folded_byte(std::string_view haystack, size_t from, char lower_byte) -> size_t {
+#if defined(__SSE2__)
+    const __m128i target = _mm_set1_epi8(lower_byte);
+    for (; from + BLOCK_SIZE <= haystack.size(); from += BLOCK_SIZE) {
+        __m128i block = fold_block(load_block(haystack.data() + from));
+        auto hits = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, target)));
+        if (hits != 0) {
+            return from + std::countr_zero(hits);
+        }
+    }
+#endif
+
+    for (; from < haystack.size(); ++from) {
+        if (fold_byte(haystack[from]) == lower_byte) {
+            return from;
+        }
+    }
+    return std::string_view::npos;
+}
+
+} // namespace nolint
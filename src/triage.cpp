@@ -0,0 +1,274 @@
+#include "triage.hpp"
+#include "stable_hash.hpp"
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <functional>
+#include <map>
+#include <queue>
+#include <string>
+
+namespace nolint {
+
+namespace {
+
+constexpr std::string_view JOURNAL_HEADER = "# nolint decisions v1";
+constexpr std::array<std::string_view, 4> STYLE_NAMES
+    = {"NONE", "NOLINT", "NOLINTNEXTLINE", "NOLINT_BLOCK"};
+
+auto style_name(NolintStyle style) -> std::string_view {
+    return STYLE_NAMES[static_cast<size_t>(style)];
+}
+
+auto parse_style_name(std::string_view name) -> std::optional<NolintStyle> {
+    auto found = std::find(STYLE_NAMES.begin(), STYLE_NAMES.end(), name);
+    if (found == STYLE_NAMES.end()) {
+        return std::nullopt;
+    }
+    return static_cast<NolintStyle>(found - STYLE_NAMES.begin());
+}
+
+auto by_fingerprint(const JournalEntry& a, const JournalEntry& b) -> bool {
+    return a.fingerprint < b.fingerprint;
+}
+
+auto directory_of(std::string_view path) -> std::string_view {
+    auto slash = path.rfind('/');
+    return (slash == std::string_view::npos) ? std::string_view{} : path.substr(0, slash);
+}
+
+// Longest-processing-time assignment: largest directory first, each to the
+// reviewer with the fewest warnings so far (lowest index on ties)
+auto split_by_directory(const std::vector<Warning>& warnings, size_t reviewers)
+    -> std::vector<std::vector<size_t>> {
+    std::map<std::string_view, std::vector<size_t>> directories;
+    for (size_t i = 0; i < warnings.size(); ++i) {
+        directories[directory_of(warnings[i].file_path)].push_back(i);
+    }
+
+    std::vector<const std::vector<size_t>*> largest_first;
+    for (const auto& [directory, indices] : directories) {
+        largest_first.push_back(&indices);
+    }
+    // Stable, so equal directories keep name order and the split is deterministic
+    std::stable_sort(largest_first.begin(), largest_first.end(),
+                     [](const auto* a, const auto* b) { return a->size() > b->size(); });
+
+    using Load = std::pair<size_t, size_t>; // warnings assigned, reviewer
+    std::priority_queue<Load, std::vector<Load>, std::greater<>> loads;
+    for (size_t reviewer = 0; reviewer < reviewers; ++reviewer) {
+        loads.emplace(0, reviewer);
+    }
+
+    std::vector<std::vector<size_t>> sessions(reviewers);
+    for (const auto* indices : largest_first) {
+        auto [load, reviewer] = loads.top();
+        loads.pop();
+        auto& session = sessions[reviewer];
+        session.insert(session.end(), indices->begin(), indices->end());
+        loads.emplace(load + indices->size(), reviewer);
+    }
+    for (auto& session : sessions) {
+        std::sort(session.begin(), session.end());
+    }
+    return sessions;
+}
+
+auto split_by_count(size_t warning_count, size_t reviewers) -> std::vector<std::vector<size_t>> {
+    std::vector<std::vector<size_t>> sessions(reviewers);
+    for (size_t reviewer = 0; reviewer < reviewers; ++reviewer) {
+        size_t begin = warning_count * reviewer / reviewers;
+        size_t end = warning_count * (reviewer + 1) / reviewers;
+        for (size_t i = begin; i < end; ++i) {
+            sessions[reviewer].push_back(i);
+        }
+    }
+    return sessions;
+}
+
+} // namespace
+
+auto warning_fingerprint(const Warning& warning) -> std::uint64_t {
+    std::string key = warning.file_path;
+    key += '\0';
+    key += std::to_string(warning.line_number);
+    key += ':';
+    key += std::to_string(warning.column);
+    key += '\0';
+    key += warning.type;
+    key += '\0';
+    key += warning.message;
+    return stable_hash(key);
+}
+
+auto warning_fingerprints(const std::vector<Warning>& warnings) -> std::vector<std::uint64_t> {
+    std::vector<std::uint64_t> fingerprints;
+    fingerprints.reserve(warnings.size());
+    for (const auto& warning : warnings) {
+        fingerprints.push_back(warning_fingerprint(warning));
+    }
+    return fingerprints;
+}
+
+auto parse_split_mode(std::string_view value) -> std::optional<SplitMode> {
+    if (value == "directory") {
+        return SplitMode::DIRECTORY;
+    }
+    if (value == "count") {
+        return SplitMode::COUNT;
+    }
+    return std::nullopt;
+}
+
+auto split_reviewers(const std::vector<Warning>& warnings, size_t reviewers, SplitMode mode)
+    -> std::vector<std::vector<size_t>> {
+    if (reviewers == 0) {
+        return {};
+    }
+    return (mode == SplitMode::DIRECTORY) ? split_by_directory(warnings, reviewers)
+                                          : split_by_count(warnings.size(), reviewers);
+}
+
+auto format_warning_lines(const std::vector<Warning>& warnings, const std::vector<size_t>& indices)
+    -> std::string {
+    std::string text;
+    for (auto index : indices) {
+        const auto& warning = warnings[index];
+        auto location = warning.file_path + ":" + std::to_string(warning.line_number) + ":"
+                        + std::to_string(warning.column) + ": ";
+        text += location + "warning: " + warning.message + " [" + warning.type + "]\n";
+        if (warning.function_lines) {
+            text += location + "note: " + std::to_string(*warning.function_lines)
+                    + " lines including whitespace and comments\n";
+        }
+    }
+    return text;
+}
+
+auto make_journal(const std::vector<std::uint64_t>& fingerprints,
+                  const std::unordered_map<size_t, NolintStyle>& decisions) -> DecisionJournal {
+    std::vector<std::pair<size_t, NolintStyle>> ordered(decisions.begin(), decisions.end());
+    std::sort(ordered.begin(), ordered.end());
+
+    DecisionJournal journal;
+    journal.reserve(ordered.size());
+    for (const auto& [index, style] : ordered) {
+        journal.push_back(JournalEntry{.fingerprint = fingerprints[index], .style = style});
+    }
+    std::stable_sort(journal.begin(), journal.end(), by_fingerprint);
+    auto repeats = std::unique(journal.begin(), journal.end(),
+                               [](const JournalEntry& a, const JournalEntry& b) {
+                                   return a.fingerprint == b.fingerprint;
+                               });
+    journal.erase(repeats, journal.end());
+    return journal;
+}
+
+auto format_journal(const DecisionJournal& journal) -> std::string {
+    static constexpr char HEX[] = "0123456789abcdef";
+    std::string text(JOURNAL_HEADER);
+    text += '\n';
+    for (const auto& entry : journal) {
+        std::string digits(16, '0');
+        for (size_t i = 0; i < digits.size(); ++i) {
+            digits[digits.size() - 1 - i] = HEX[(entry.fingerprint >> (4 * i)) & 0xF];
+        }
+        text += digits + " " + std::string(style_name(entry.style)) + "\n";
+    }
+    return text;
+}
+
+auto parse_journal(std::istream& input) -> std::optional<DecisionJournal> {
+    DecisionJournal journal;
+    for (std::string line; std::getline(input, line);) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        auto space = line.find(' ');
+        if (space != 16) {
+            return std::nullopt;
+        }
+        JournalEntry entry;
+        const char* digits_end = line.data() + space;
+        auto [end, error] = std::from_chars(line.data(), digits_end, entry.fingerprint, 16);
+        auto style = parse_style_name(std::string_view(line).substr(space + 1));
+        if (error != std::errc{} || end != digits_end || !style) {
+            return std::nullopt;
+        }
+        entry.style = *style;
+        journal.push_back(entry);
+    }
+
+    if (!std::is_sorted(journal.begin(), journal.end(), by_fingerprint)) {
+        std::stable_sort(journal.begin(), journal.end(), by_fingerprint);
+    }
+    // Keep the last of each run of one fingerprint
+    DecisionJournal unique;
+    unique.reserve(journal.size());
+    for (const auto& entry : journal) {
+        if (!unique.empty() && unique.back().fingerprint == entry.fingerprint) {
+            unique.back() = entry;
+        } else {
+            unique.push_back(entry);
+        }
+    }
+    return unique;
+}
+
+auto merge_journals(const std::vector<DecisionJournal>& journals) -> MergedJournal {
+    // Head of every journal, smallest fingerprint on top
+    using Head = std::pair<std::uint64_t, size_t>; // fingerprint, journal
+    std::priority_queue<Head, std::vector<Head>, std::greater<>> heads;
+    std::vector<size_t> positions(journals.size(), 0);
+    size_t total = 0;
+    for (size_t j = 0; j < journals.size(); ++j) {
+        total += journals[j].size();
+        if (!journals[j].empty()) {
+            heads.emplace(journals[j].front().fingerprint, j);
+        }
+    }
+
+    MergedJournal merged;
+    merged.journal.reserve(total);
+    while (!heads.empty()) {
+        auto [fingerprint, j] = heads.top();
+        heads.pop();
+        auto style = journals[j][positions[j]].style;
+        if (++positions[j] < journals[j].size()) {
+            heads.emplace(journals[j][positions[j]].fingerprint, j);
+        }
+
+        if (merged.journal.empty() || merged.journal.back().fingerprint != fingerprint) {
+            merged.journal.push_back(JournalEntry{.fingerprint = fingerprint, .style = style});
+            continue;
+        }
+        auto& entry = merged.journal.back();
+        bool in_conflict = !merged.conflicts.empty() && merged.conflicts.back() == fingerprint;
+        if (!in_conflict && entry.style != style) {
+            entry.style = NolintStyle::NONE;
+            merged.conflicts.push_back(fingerprint);
+        }
+    }
+    return merged;
+}
+
+auto apply_journal(const std::vector<std::uint64_t>& fingerprints, const DecisionJournal& journal)
+    -> JournalMatch {
+    JournalMatch match;
+    std::vector<bool> used(journal.size(), false);
+    for (size_t i = 0; i < fingerprints.size(); ++i) {
+        auto found = std::lower_bound(journal.begin(), journal.end(),
+                                      JournalEntry{.fingerprint = fingerprints[i],
+                                                   .style = NolintStyle::NONE},
+                                      by_fingerprint);
+        if (found != journal.end() && found->fingerprint == fingerprints[i]) {
+            match.decisions[i] = found->style;
+            auto entry = static_cast<size_t>(found - journal.begin());
+            match.matched_entries += used[entry] ? 0 : 1;
+            used[entry] = true;
+        }
+    }
+    return match;
+}
+
+} // namespace nolint
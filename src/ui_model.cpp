@@ -1,93 +1,226 @@
 #include "ui_model.hpp"
+#include "fuzzy_match.hpp"
+#include "parallel_chunks.hpp"
+#include "text_search.hpp"
 #include <algorithm>
 #include <cctype>
+#include <limits>
+#include <numeric>
 
 namespace nolint {
 
-// Filter warnings based on search string - searches all fields
-auto filter_warnings(const std::vector<Warning>& warnings, const std::string& filter)
+// Warnings per worker below which threading costs more than it saves
+constexpr size_t PARALLEL_FILTER_CHUNK = 1 << 16;
+
+namespace {
+
+// Collect matching rows in [begin, end). The searchable text is conceptually
+// "file_path type message": path and check matches are looked up per id, only
+// messages are searched per row, and the joined copy is only built when the
+// filter contains a space and could match across a field boundary.
+auto filter_table_range(const WarningTable& table, const std::string& lower_filter,
+                        const std::vector<bool>& path_matches,
+                        const std::vector<bool>& type_matches, size_t begin, size_t end)
     -> std::vector<size_t> {
-    std::vector<size_t> filtered_indices;
+    bool may_span_fields = lower_filter.find(' ') != std::string::npos;
+    std::vector<size_t> matches;
+
+    for (size_t i = begin; i < end; ++i) {
+        auto row = warning_row(table, i);
+        bool matched = path_matches[table.path_ids[i]] || type_matches[table.type_ids[i]]
+                       || contains_case_insensitive(row.message(), lower_filter);
+
+        if (!matched && may_span_fields) {
+            std::string searchable_text = row.file_path() + " " + std::string(row.type()) + " "
+                                          + std::string(row.message());
+            matched = contains_case_insensitive(searchable_text, lower_filter);
+        }
 
-    if (filter.empty()) {
-        // No filter - return all indices
-        for (size_t i = 0; i < warnings.size(); ++i) {
-            filtered_indices.push_back(i);
+        if (matched) {
+            matches.push_back(i);
         }
-        return filtered_indices;
     }
 
-    // Convert filter to lowercase for case-insensitive search
-    std::string lower_filter = filter;
-    std::transform(lower_filter.begin(), lower_filter.end(), lower_filter.begin(), ::tolower);
+    return matches;
+}
 
-    for (size_t i = 0; i < warnings.size(); ++i) {
-        const auto& warning = warnings[i];
+// Build the columnar table and line index if warnings were replaced since they
+// were last built. Indexes derived from the old warnings are dropped with them.
+auto ensure_warning_table(UIModel& model) -> void {
+    if (model.table && model.table->size() == model.warnings.size()
+        && model.indexed_generation == model.warnings_generation) {
+        return;
+    }
+    model.table = std::make_shared<const WarningTable>(build_warning_table(model.warnings));
+    model.line_index = std::make_shared<const FileLineIndex>(build_file_line_index(*model.table));
+    model.indexed_generation = model.warnings_generation;
+    model.runs.reset();
+    model.locations.reset();
+    model.decided_positions = {};
+    model.check_trie = {};
+    model.filter_cache.entries.clear();
+}
 
-        // Search in all warning fields (case-insensitive)
-        std::string searchable_text
-            = warning.file_path + " " + warning.type + " " + warning.message;
-        std::transform(searchable_text.begin(), searchable_text.end(), searchable_text.begin(),
-                       ::tolower);
+// Move current_index to a position found by a navigation index lookup
+auto jump_to(UIModel& model, std::optional<size_t> position) -> void {
+    if (position) {
+        model.current_index = *position;
+    }
+}
 
-        if (searchable_text.find(lower_filter) != std::string::npos) {
-            filtered_indices.push_back(i);
-        }
+// Rebuild navigation indexes if filtered_warning_indices was replaced without apply_filter
+auto ensure_navigation_indexes(UIModel& model) -> void {
+    ensure_warning_table(model);
+    if (model.decided_positions.size != model.filtered_warning_indices->size()) {
+        model.decided_positions
+            = build_decided_positions(*model.filtered_warning_indices, model.decisions);
     }
+    if (!model.runs || model.runs->position_count != model.filtered_warning_indices->size()) {
+        model.runs = std::make_shared<const RunIndex>(
+            build_run_index(*model.table, *model.filtered_warning_indices));
+    }
+    if (!model.locations
+        || model.locations->position_count != model.filtered_warning_indices->size()) {
+        model.locations = std::make_shared<const LocationIndex>(
+            build_location_index(model.warnings, *model.filtered_warning_indices));
+    }
+}
 
-    return filtered_indices;
+// Write one decision and keep derived state in sync. `position` is the warning's
+// index in filtered_warning_indices when known; otherwise the bitset is rebuilt.
+auto set_decision(UIModel& model, size_t warning_index, NolintStyle style,
+                  std::optional<size_t> position) -> void {
+    NolintStyle before = model.get_decision(warning_index);
+    model.decisions[warning_index] = style;
+    ++model.decisions_version;
+
+    // Keep statistics counts current without recounting
+    if (!model.check_trie.nodes.empty() && model.table
+        && warning_index < model.table->size()) {
+        apply_decision_change(model.check_trie, model.table->type_ids[warning_index], before,
+                              style);
+    }
+
+    ensure_navigation_indexes(model);
+    if (position && *position < model.filtered_warning_indices->size()
+        && (*model.filtered_warning_indices)[*position] == warning_index) {
+        set_position(model.decided_positions, *position, style != NolintStyle::NONE);
+    } else if (position) {
+        model.decided_positions
+            = build_decided_positions(*model.filtered_warning_indices, model.decisions);
+    }
+    // Without a position the caller is applying a batch and rebuilds the bitset once
+
+    // Track that this file will be modified
+    if (style != NolintStyle::NONE) {
+        model.modified_files.insert(model.warnings[warning_index].file_path);
+    }
 }
 
-// Pure state transition function - no side effects!
-auto calculate_warning_statistics(const std::vector<Warning>& warnings,
-                                  const std::unordered_map<size_t, NolintStyle>& decisions)
-    -> std::vector<WarningTypeStats> {
-    std::unordered_map<std::string, WarningTypeStats> stats_map;
+// Store a decision for the current warning as one undoable action
+auto record_current_decision(UIModel& model, NolintStyle style) -> void {
+    size_t warning_index = model.current_warning_original_index();
+    DecisionChange change{
+        .warning_index = warning_index, .before = model.current_style(), .after = style};
 
-    // Initialize stats for each warning type
-    for (size_t i = 0; i < warnings.size(); ++i) {
-        const auto& warning = warnings[i];
-        if (stats_map.find(warning.type) == stats_map.end()) {
-            stats_map[warning.type] = WarningTypeStats{.type = warning.type};
-        }
+    set_decision(model, warning_index, style, model.current_index);
+    model.history = push_action(std::move(model.history), {change}, model.current_index);
+}
+
+// Apply one side of a history node and put the cursor back where it happened
+auto replay_history_node(UIModel& model, const HistoryNode& node, bool use_after) -> void {
+    // Single edits know their filtered position; bulk edits rebuild the bitset once
+    std::optional<size_t> position;
+    if (node.changes->size() == 1) {
+        position = node.cursor_position;
+    }
+
+    for (auto it = node.changes->rbegin(); it != node.changes->rend(); ++it) {
+        set_decision(model, it->warning_index, use_after ? it->after : it->before, position);
+    }
+    if (!position) {
+        model.decided_positions
+            = build_decided_positions(*model.filtered_warning_indices, model.decisions);
+    }
+
+    // Only move the cursor if it still points at the same warning under the current filter
+    if (node.cursor_position < model.filtered_warning_indices->size()
+        && (*model.filtered_warning_indices)[node.cursor_position]
+               == node.changes->front().warning_index) {
+        model.current_index = node.cursor_position;
+    }
+}
 
-        auto& stats = stats_map[warning.type];
-        stats.total_count++;
+// Scroll the statistics window just far enough to show the selected row
+auto keep_statistics_selection_visible(UIModel& model) -> void {
+    size_t page = std::max<size_t>(1, model.statistics_page_rows);
+    if (model.statistics_selected_index < model.statistics_scroll_offset) {
+        model.statistics_scroll_offset = model.statistics_selected_index;
+    } else if (model.statistics_selected_index >= model.statistics_scroll_offset + page) {
+        model.statistics_scroll_offset = model.statistics_selected_index - page + 1;
+    }
+}
 
-        // Count based on decision
-        auto decision_it = decisions.find(i);
-        NolintStyle style
-            = (decision_it != decisions.end()) ? decision_it->second : NolintStyle::NONE;
+// Rebuild the statistics trie if the warnings changed, then refresh its visible
+// rows in the current sort order. The selection stays on the same node.
+auto refresh_statistics_rows(UIModel& model) -> void {
+    ensure_warning_table(model);
+    size_t selected_node = NO_TRIE_NODE;
+    if (model.statistics_selected_index < model.statistics_rows.size()) {
+        selected_node = model.statistics_rows[model.statistics_selected_index];
+    }
 
-        switch (style) {
-        case NolintStyle::NOLINT:
-            stats.nolint_count++;
-            break;
-        case NolintStyle::NOLINTNEXTLINE:
-            stats.nolintnextline_count++;
-            break;
-        case NolintStyle::NOLINT_BLOCK:
-            stats.nolint_block_count++;
-            break;
-        case NolintStyle::NONE:
-            stats.unsuppressed_count++;
-            break;
+    if (model.check_trie.nodes.empty() || model.check_trie.warning_count != model.table->size()) {
+        model.check_trie = build_check_trie(*model.table, model.decisions);
+        selected_node = NO_TRIE_NODE;
+    }
+    rank_trie_nodes(model.check_trie);
+
+    model.statistics_rows = visible_trie_rows(model.check_trie, model.statistics_sort);
+    if (selected_node != NO_TRIE_NODE) {
+        auto selected = std::find(model.statistics_rows.begin(), model.statistics_rows.end(),
+                                  selected_node);
+        if (selected != model.statistics_rows.end()) {
+            model.statistics_selected_index = selected - model.statistics_rows.begin();
         }
     }
+    if (model.statistics_selected_index >= model.statistics_rows.size()) {
+        model.statistics_selected_index
+            = model.statistics_rows.empty() ? 0 : model.statistics_rows.size() - 1;
+    }
+    keep_statistics_selection_visible(model);
+}
 
-    // Convert map to sorted vector
-    std::vector<WarningTypeStats> result;
-    for (const auto& [type, stats] : stats_map) {
-        result.push_back(stats);
+// Move the statistics selection by `delta` rows, clamped to the table
+auto move_statistics_selection(UIModel& model, std::ptrdiff_t delta) -> void {
+    if (model.statistics_rows.empty()) {
+        return;
     }
+    auto last = static_cast<std::ptrdiff_t>(model.statistics_rows.size()) - 1;
+    auto target = static_cast<std::ptrdiff_t>(model.statistics_selected_index) + delta;
+    model.statistics_selected_index
+        = static_cast<size_t>(std::clamp<std::ptrdiff_t>(target, 0, last));
+    keep_statistics_selection_visible(model);
+}
 
-    // Sort by total count (descending)
-    std::sort(result.begin(), result.end(),
-              [](const WarningTypeStats& a, const WarningTypeStats& b) {
-                  return a.total_count > b.total_count;
-              });
+// Expand or collapse the selected statistics row; collapsing a leaf selects its parent
+auto set_selected_expanded(UIModel& model, bool expanded) -> void {
+    if (model.statistics_selected_index >= model.statistics_rows.size()) {
+        return;
+    }
+    size_t node = model.statistics_rows[model.statistics_selected_index];
+    auto& trie_node = model.check_trie.nodes[node];
+
+    if (expanded || trie_node.expanded) {
+        trie_node.expanded = expanded && !trie_node.children.empty();
+    } else if (trie_node.parent != NO_TRIE_NODE) {
+        model.check_trie.nodes[trie_node.parent].expanded = false;
+        auto parent = std::find(model.statistics_rows.begin(), model.statistics_rows.end(),
+                                trie_node.parent);
+        model.statistics_selected_index = parent - model.statistics_rows.begin();
+    }
 
-    return result;
+    refresh_statistics_rows(model);
 }
 
 // Helper function to handle function view mode updates
@@ -180,6 +313,296 @@ auto update_function_view(UIModel model, InputEvent event) -> UIModel {
     return model;
 }
 
+} // namespace
+
+auto filter_warnings(const WarningTable& table, const std::string& filter) -> std::vector<size_t> {
+    std::vector<size_t> filtered_indices;
+
+    if (filter.empty()) {
+        filtered_indices.resize(table.size());
+        std::iota(filtered_indices.begin(), filtered_indices.end(), size_t{0});
+        return filtered_indices;
+    }
+
+    std::string lower_filter = fold_case(filter);
+
+    std::vector<bool> path_matches(table.paths.names.size());
+    for (size_t id = 0; id < path_matches.size(); ++id) {
+        path_matches[id] = contains_case_insensitive(table.paths.names[id], lower_filter);
+    }
+    std::vector<bool> type_matches(check_count(table.checks));
+    for (CheckId id = 0; id < type_matches.size(); ++id) {
+        type_matches[id] = contains_case_insensitive(check_name(table.checks, id), lower_filter);
+    }
+
+    auto chunk_results = process_in_chunks<std::vector<size_t>>(
+        table.size(), PARALLEL_FILTER_CHUNK,
+        [&](size_t begin, size_t end) {
+            return filter_table_range(table, lower_filter, path_matches, type_matches, begin,
+                                      end);
+        });
+
+    for (const auto& chunk : chunk_results) {
+        filtered_indices.insert(filtered_indices.end(), chunk.begin(), chunk.end());
+    }
+
+    return filtered_indices;
+}
+
+auto build_decided_positions(const std::vector<size_t>& filtered_warning_indices,
+                             const std::unordered_map<size_t, NolintStyle>& decisions)
+    -> PositionBitset {
+    auto bits = make_position_bitset(filtered_warning_indices.size());
+
+    for (size_t i = 0; i < filtered_warning_indices.size(); ++i) {
+        auto decision_it = decisions.find(filtered_warning_indices[i]);
+        if (decision_it != decisions.end() && decision_it->second != NolintStyle::NONE) {
+            set_position(bits, i, true);
+        }
+    }
+
+    return bits;
+}
+
+auto build_run_index(const WarningTable& table, const std::vector<size_t>& filtered_warning_indices)
+    -> RunIndex {
+    RunIndex runs;
+    runs.position_count = filtered_warning_indices.size();
+
+    for (size_t i = 0; i < filtered_warning_indices.size(); ++i) {
+        size_t row = filtered_warning_indices[i];
+        size_t previous = (i > 0) ? filtered_warning_indices[i - 1] : row;
+
+        if (i == 0 || table.path_ids[previous] != table.path_ids[row]) {
+            runs.file_run_starts.push_back(i);
+        }
+        if (i == 0 || table.type_ids[previous] != table.type_ids[row]) {
+            runs.type_run_starts.push_back(i);
+        }
+    }
+
+    return runs;
+}
+
+auto neighbouring_warnings(const UIModel& model, int first_line, int last_line)
+    -> std::span<const LineWarning> {
+    if (!model.table || !model.line_index || model.total_warnings() == 0
+        || model.table->size() != model.warnings.size()
+        || model.indexed_generation != model.warnings_generation) {
+        return {};
+    }
+    auto path_id = model.table->path_ids[model.current_warning_original_index()];
+    return warnings_in_lines(*model.line_index, path_id, first_line, last_line);
+}
+
+auto rebase_file_warnings(UIModel model, const std::string& file_path, const LineMap& map)
+    -> UIModel {
+    ensure_warning_table(model);
+    auto path_id = find_interned(model.table->paths, file_path);
+    if (!path_id || is_identity(map)) {
+        return model;
+    }
+
+    // Copy-on-write: other holders of the table and index keep the old lines
+    auto table = std::make_shared<WarningTable>(*model.table);
+    auto line_index = std::make_shared<FileLineIndex>(*model.line_index);
+    auto entries = warnings_in_lines(*line_index, *path_id, std::numeric_limits<int>::min(),
+                                     std::numeric_limits<int>::max());
+    for (const auto& entry : entries) {
+        int line = remap_line(map, entry.line);
+        table->lines[entry.warning_index] = line;
+        model.warnings[entry.warning_index].line_number = line;
+    }
+    refresh_file_lines(*line_index, *table, *path_id);
+    model.table = std::move(table);
+    model.line_index = std::move(line_index);
+
+    // Other cached filters rebuild their location indexes when next applied; the
+    // current one is patched for just this file (copy-on-write, like the table)
+    forget_filter_locations(model.filter_cache);
+    if (model.locations && model.locations->lines_by_file.contains(file_path)) {
+        auto locations = std::make_shared<LocationIndex>(*model.locations);
+        auto& lines = locations->lines_by_file[file_path];
+        const auto& filtered = *model.filtered_warning_indices;
+        for (auto& entry : lines) {
+            entry.line = model.warnings[filtered[entry.position]].line_number;
+        }
+        std::stable_sort(lines.begin(), lines.end(), [](const LineEntry& a, const LineEntry& b) {
+            return a.line < b.line;
+        });
+        model.locations = std::move(locations);
+        if (auto* entry
+            = lookup_filter(model.filter_cache, normalize_filter_key(model.search_filter))) {
+            entry->locations = model.locations;
+        }
+    }
+
+    model.status_message = "Reloaded " + file_path + ": " + std::to_string(entries.size())
+                           + " warnings rebased, " + std::to_string(map.changed_lines)
+                           + " lines changed";
+    return model;
+}
+
+auto build_location_index(const std::vector<Warning>& warnings,
+                          const std::vector<size_t>& filtered_warning_indices) -> LocationIndex {
+    LocationIndex index;
+    index.position_count = filtered_warning_indices.size();
+
+    for (size_t i = 0; i < filtered_warning_indices.size(); ++i) {
+        const auto& warning = warnings[filtered_warning_indices[i]];
+        index.lines_by_file[warning.file_path].push_back(
+            LineEntry{.line = warning.line_number, .position = i});
+    }
+
+    for (auto& [path, lines] : index.lines_by_file) {
+        std::stable_sort(lines.begin(), lines.end(), [](const LineEntry& a, const LineEntry& b) {
+            return a.line < b.line;
+        });
+    }
+
+    return index;
+}
+
+auto replace_warnings(UIModel model, std::vector<Warning> warnings) -> UIModel {
+    model.warnings = std::move(warnings);
+    ++model.warnings_generation;
+    ensure_warning_table(model);
+    auto filter = model.search_filter;
+    return apply_filter(std::move(model), filter);
+}
+
+auto replace_decisions(UIModel model, std::unordered_map<size_t, NolintStyle> decisions)
+    -> UIModel {
+    model.decisions = std::move(decisions);
+    ++model.decisions_version;
+    model.decided_positions
+        = build_decided_positions(*model.filtered_warning_indices, model.decisions);
+    model.check_trie = {};
+    return model;
+}
+
+auto apply_filter(UIModel model, const std::string& filter) -> UIModel {
+    invalidate_filter_cache(model.filter_cache, model.warnings.size());
+    ensure_warning_table(model);
+
+    // Remember where we were in the filter we are leaving, and hand it the
+    // decided bitset so an unchanged return needs no rebuild
+    remember_filter_position(model.filter_cache, normalize_filter_key(model.search_filter),
+                             model.current_index, std::move(model.decided_positions),
+                             model.decisions_version);
+
+    model.search_filter = filter;
+    auto key = normalize_filter_key(model.search_filter);
+
+    bool decided_current = false;
+    if (auto* entry = lookup_filter(model.filter_cache, key)) {
+        // Hit: the indices and their run/location indexes are shared with the
+        // entry, so switching back costs no pass over the warnings
+        model.filtered_warning_indices = entry->indices;
+        model.current_index = (entry->current_index < model.filtered_warning_indices->size())
+                                  ? entry->current_index
+                                  : 0;
+        if (!entry->locations) {
+            entry->locations = std::make_shared<const LocationIndex>(
+                build_location_index(model.warnings, *model.filtered_warning_indices));
+        }
+        model.runs = entry->runs;
+        model.locations = entry->locations;
+        if (entry->decisions_version == model.decisions_version
+            && entry->decided.size == model.filtered_warning_indices->size()) {
+            model.decided_positions = std::move(entry->decided);
+            decided_current = true;
+        }
+    } else {
+        model.filtered_warning_indices = std::make_shared<const std::vector<size_t>>(
+            is_fuzzy_query(model.search_filter)
+                ? fuzzy_filter_warnings(*model.table, model.search_filter.substr(1))
+                : filter_warnings(*model.table, model.search_filter));
+        model.current_index = 0; // Reset to first filtered result
+        model.runs = std::make_shared<const RunIndex>(
+            build_run_index(*model.table, *model.filtered_warning_indices));
+        model.locations = std::make_shared<const LocationIndex>(
+            build_location_index(model.warnings, *model.filtered_warning_indices));
+        store_filter(model.filter_cache, FilterCacheEntry{.key = key,
+                                                          .indices = model.filtered_warning_indices,
+                                                          .runs = model.runs,
+                                                          .locations = model.locations,
+                                                          .current_index = 0,
+                                                          .last_used = 0,
+                                                          .decided = {},
+                                                          .decisions_version = 0});
+    }
+
+    // The decided bitset is rebuilt only when decisions changed since the
+    // filter was last shown (one linear pass, no sorting)
+    if (!decided_current) {
+        model.decided_positions
+            = build_decided_positions(*model.filtered_warning_indices, model.decisions);
+    }
+    return model;
+}
+
+auto goto_location(UIModel model, const std::string& command) -> UIModel {
+    auto target = parse_goto_command(command);
+    if (!target) {
+        model.status_message = "Invalid go-to target (expected :N or path:line)";
+        return model;
+    }
+
+    if (target->warning_number) {
+        size_t number = *target->warning_number;
+        if (number < 1 || number > model.total_warnings()) {
+            model.status_message = "Go to: no warning " + std::to_string(number);
+            return model;
+        }
+        model.current_index = number - 1; // Displayed numbers are 1-based
+        return model;
+    }
+
+    ensure_navigation_indexes(model);
+    const auto* lines = find_file_lines(*model.locations, target->file_path);
+    if (lines == nullptr) {
+        model.status_message = "Go to: no warnings in " + target->file_path;
+        return model;
+    }
+
+    jump_to(model, find_nearest_line(*lines, target->line));
+    return model;
+}
+
+auto apply_bulk_decision(UIModel model, size_t node, NolintStyle style) -> UIModel {
+    ensure_warning_table(model);
+    if (node >= model.check_trie.nodes.size()) {
+        return model;
+    }
+
+    std::vector<bool> in_subtree(check_count(model.table->checks));
+    for (auto check : checks_under(model.check_trie, node)) {
+        in_subtree[check] = true;
+    }
+
+    std::vector<DecisionChange> changes;
+    for (size_t i = 0; i < model.table->size(); ++i) {
+        if (!in_subtree[model.table->type_ids[i]]
+            || (style == NolintStyle::NOLINT_BLOCK
+                && model.table->function_lines[i] == NO_FUNCTION_LINES)) {
+            continue;
+        }
+        NolintStyle before = model.get_decision(i);
+        if (before != style) {
+            changes.push_back(DecisionChange{.warning_index = i, .before = before, .after = style});
+            set_decision(model, i, style, std::nullopt);
+        }
+    }
+
+    model.decided_positions
+        = build_decided_positions(*model.filtered_warning_indices, model.decisions);
+    model.status_message = "Changed " + std::to_string(changes.size()) + " warning(s) in "
+                           + model.check_trie.nodes[node].label;
+    model.history = push_action(std::move(model.history), std::move(changes), model.current_index);
+    return model;
+}
+
 auto update(UIModel model, InputEvent event) -> UIModel {
     // Handle function view mode separately
     if (model.in_function_view) {
@@ -195,6 +618,10 @@ auto update(UIModel model, InputEvent event) -> UIModel {
         return model;
     }
 
+    if (event != InputEvent::UNKNOWN) {
+        model.status_message.clear();
+    }
+
     switch (event) {
     case InputEvent::QUIT:
         model.should_save = false;
@@ -202,25 +629,60 @@ auto update(UIModel model, InputEvent event) -> UIModel {
         break;
 
     case InputEvent::ARROW_LEFT:
-        // Navigate to previous warning
-        if (model.current_index > 0) {
+        if (model.show_statistics) {
+            set_selected_expanded(model, false);
+        } else if (model.current_index > 0) {
+            // Navigate to previous warning
             model.current_index--;
         }
         break;
 
     case InputEvent::ARROW_RIGHT:
-        // Navigate to next warning
-        if (model.current_index < model.total_warnings() - 1) {
+        if (model.show_statistics) {
+            set_selected_expanded(model, true);
+        } else if (model.current_index < model.total_warnings() - 1) {
+            // Navigate to next warning
             model.current_index++;
         }
         break;
 
+    case InputEvent::NEXT_UNDECIDED:
+        // Jump forward to the next warning the user has not decided yet
+        ensure_navigation_indexes(model);
+        jump_to(model, find_next_clear(model.decided_positions, model.current_index + 1));
+        break;
+
+    case InputEvent::PREV_UNDECIDED:
+        // Jump back to the previous warning the user has not decided yet
+        ensure_navigation_indexes(model);
+        if (model.current_index > 0) {
+            jump_to(model, find_prev_clear(model.decided_positions, model.current_index - 1));
+        }
+        break;
+
+    case InputEvent::NEXT_FILE:
+        ensure_navigation_indexes(model);
+        jump_to(model, find_next_run_start(model.runs->file_run_starts, model.current_index));
+        break;
+
+    case InputEvent::PREV_FILE:
+        ensure_navigation_indexes(model);
+        jump_to(model, find_prev_run_start(model.runs->file_run_starts, model.current_index));
+        break;
+
+    case InputEvent::NEXT_CHECK:
+        ensure_navigation_indexes(model);
+        jump_to(model, find_next_run_start(model.runs->type_run_starts, model.current_index));
+        break;
+
+    case InputEvent::PREV_CHECK:
+        ensure_navigation_indexes(model);
+        jump_to(model, find_prev_run_start(model.runs->type_run_starts, model.current_index));
+        break;
+
     case InputEvent::ARROW_UP:
         if (model.show_statistics) {
-            // Navigate statistics selection up
-            if (model.statistics_selected_index > 0) {
-                model.statistics_selected_index--;
-            }
+            move_statistics_selection(model, -1);
         } else {
             // Cycle suppression style forward
             auto current = static_cast<int>(model.current_style());
@@ -232,22 +694,13 @@ auto update(UIModel model, InputEvent event) -> UIModel {
             } while (current == static_cast<int>(NolintStyle::NOLINT_BLOCK)
                      && !warning.function_lines.has_value());
 
-            model.decisions[model.current_warning_original_index()]
-                = static_cast<NolintStyle>(current);
-
-            // Track that this file will be modified
-            if (model.current_style() != NolintStyle::NONE) {
-                model.modified_files.insert(model.current_warning().file_path);
-            }
+            record_current_decision(model, static_cast<NolintStyle>(current));
         }
         break;
 
     case InputEvent::ARROW_DOWN:
         if (model.show_statistics) {
-            // Navigate statistics selection down
-            if (model.statistics_selected_index < model.statistics_types.size() - 1) {
-                model.statistics_selected_index++;
-            }
+            move_statistics_selection(model, 1);
         } else {
             // Cycle suppression style backward
             auto current = static_cast<int>(model.current_style());
@@ -259,29 +712,91 @@ auto update(UIModel model, InputEvent event) -> UIModel {
             } while (current == static_cast<int>(NolintStyle::NOLINT_BLOCK)
                      && !warning.function_lines.has_value());
 
-            model.decisions[model.current_warning_original_index()]
-                = static_cast<NolintStyle>(current);
+            record_current_decision(model, static_cast<NolintStyle>(current));
+        }
+        break;
+
+    case InputEvent::UNDO:
+        if (auto node = pop_undo(model.history)) {
+            replay_history_node(model, *node, false);
+        } else {
+            model.status_message = "Nothing to undo";
+        }
+        if (model.show_statistics) {
+            refresh_statistics_rows(model);
+        }
+        break;
 
-            // Track that this file will be modified
-            if (model.current_style() != NolintStyle::NONE) {
-                model.modified_files.insert(model.current_warning().file_path);
-            }
+    case InputEvent::REDO:
+        if (auto node = pop_redo(model.history)) {
+            replay_history_node(model, *node, true);
+        } else {
+            model.status_message = "Nothing to redo";
+        }
+        if (model.show_statistics) {
+            refresh_statistics_rows(model);
         }
         break;
 
     case InputEvent::SHOW_STATISTICS:
         model.show_statistics = !model.show_statistics;
         if (model.show_statistics) {
-            // Initialize statistics types and reset selection
-            auto stats = calculate_warning_statistics(model.warnings, model.decisions);
-            model.statistics_types.clear();
-            for (const auto& stat : stats) {
-                model.statistics_types.push_back(stat.type);
-            }
+            // The trie survives between visits; decisions keep its counts current
             model.statistics_selected_index = 0;
+            model.statistics_scroll_offset = 0;
+            model.statistics_rows.clear();
+            refresh_statistics_rows(model);
         }
         break;
 
+    case InputEvent::CYCLE_SORT:
+        if (model.show_statistics) {
+            model.statistics_sort = next_statistics_sort(model.statistics_sort);
+            refresh_statistics_rows(model);
+        }
+        break;
+
+    case InputEvent::PAGE_UP:
+    case InputEvent::PAGE_DOWN:
+        if (model.show_statistics) {
+            auto page
+                = static_cast<std::ptrdiff_t>(std::max<size_t>(1, model.statistics_page_rows));
+            move_statistics_selection(model, event == InputEvent::PAGE_UP ? -page : page);
+        }
+        break;
+
+    case InputEvent::HOME:
+    case InputEvent::END:
+        if (model.show_statistics) {
+            auto row_count = static_cast<std::ptrdiff_t>(model.statistics_rows.size());
+            move_statistics_selection(model, event == InputEvent::HOME ? -row_count : row_count);
+        }
+        break;
+
+    case InputEvent::SET_NONE:
+    case InputEvent::SET_NOLINT:
+    case InputEvent::SET_NOLINTNEXTLINE:
+    case InputEvent::SET_NOLINT_BLOCK: {
+        auto style = static_cast<NolintStyle>(static_cast<int>(event)
+                                              - static_cast<int>(InputEvent::SET_NONE));
+        if (model.show_statistics) {
+            if (model.statistics_selected_index < model.statistics_rows.size()) {
+                model = apply_bulk_decision(
+                    std::move(model), model.statistics_rows[model.statistics_selected_index],
+                    style);
+                refresh_statistics_rows(model); // Count sort orders may have changed
+            }
+        } else if (model.total_warnings() == 0) {
+            model.status_message = "No warning matches the filter";
+        } else if (style == NolintStyle::NOLINT_BLOCK
+                   && !model.current_warning().function_lines.has_value()) {
+            model.status_message = "NOLINT_BLOCK needs a function size";
+        } else {
+            record_current_decision(model, style);
+        }
+        break;
+    }
+
     case InputEvent::SAVE_EXIT:
         model.should_save = true;
         model.should_exit = true;
@@ -293,12 +808,12 @@ auto update(UIModel model, InputEvent event) -> UIModel {
         break;
 
     case InputEvent::ENTER:
-        if (model.show_statistics && !model.statistics_types.empty()) {
-            // Select the highlighted warning type as filter
-            std::string selected_type = model.statistics_types[model.statistics_selected_index];
-            model.search_filter = selected_type;
-            model.filtered_warning_indices = filter_warnings(model.warnings, model.search_filter);
-            model.current_index = 0;       // Reset to first filtered result
+        if (model.show_statistics && !model.statistics_rows.empty()) {
+            // Filter by the highlighted check or category
+            std::string selected_type
+                = model.check_trie.nodes[model.statistics_rows[model.statistics_selected_index]]
+                      .label;
+            model = apply_filter(std::move(model), selected_type);
             model.show_statistics = false; // Return to main view
         }
         break;
@@ -0,0 +1,607 @@
+#include "verify.hpp"
+#include "batch_io.hpp"
+#include "parallel_chunks.hpp"
+#include "warning_parser.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <fcntl.h>
+#include <set>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <tuple>
+#include <unistd.h>
+#include <unordered_set>
+
+extern char** environ;
+
+namespace nolint {
+
+namespace {
+
+// Minimal JSON reading for compile_commands.json: strings, arrays of strings,
+// and skipping any other value
+
+auto skip_whitespace(std::string_view text, size_t& pos) -> void {
+    while (pos < text.size()
+           && (text[pos] == ' ' || text[pos] == '\t' || text[pos] == '\n' || text[pos] == '\r')) {
+        ++pos;
+    }
+}
+
+auto consume(std::string_view text, size_t& pos, char expected) -> bool {
+    skip_whitespace(text, pos);
+    if (pos < text.size() && text[pos] == expected) {
+        ++pos;
+        return true;
+    }
+    return false;
+}
+
+auto append_utf8(std::string& out, unsigned code) -> void {
+    if (code < 0x80) {
+        out += static_cast<char>(code);
+    } else if (code < 0x800) {
+        out += static_cast<char>(0xC0 | (code >> 6));
+        out += static_cast<char>(0x80 | (code & 0x3F));
+    } else if (code < 0x10000) {
+        out += static_cast<char>(0xE0 | (code >> 12));
+        out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (code & 0x3F));
+    } else {
+        out += static_cast<char>(0xF0 | (code >> 18));
+        out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (code & 0x3F));
+    }
+}
+
+// The four hex digits of a \u escape at `pos`; std::nullopt unless all four are hex
+auto read_hex4(std::string_view text, size_t& pos) -> std::optional<unsigned> {
+    auto digits = text.substr(pos, 4);
+    unsigned code = 0;
+    auto [end, error] = std::from_chars(digits.data(), digits.data() + digits.size(), code, 16);
+    if (error != std::errc{} || digits.size() != 4 || end != digits.data() + 4) {
+        return std::nullopt;
+    }
+    pos += 4;
+    return code;
+}
+
+auto read_string(std::string_view text, size_t& pos) -> std::optional<std::string> {
+    if (!consume(text, pos, '"')) {
+        return std::nullopt;
+    }
+    std::string value;
+    while (pos < text.size()) {
+        char c = text[pos++];
+        if (c == '"') {
+            return value;
+        }
+        if (c != '\\') {
+            value += c;
+            continue;
+        }
+        if (pos >= text.size()) {
+            break;
+        }
+        char escaped = text[pos++];
+        switch (escaped) {
+        case 'n':
+            value += '\n';
+            break;
+        case 't':
+            value += '\t';
+            break;
+        case 'r':
+            value += '\r';
+            break;
+        case 'b':
+            value += '\b';
+            break;
+        case 'f':
+            value += '\f';
+            break;
+        case 'u': {
+            auto code = read_hex4(text, pos);
+            if (!code) {
+                return std::nullopt;
+            }
+            // A high surrogate followed by \uDC00-\uDFFF is one code point past U+FFFF
+            if (*code >= 0xD800 && *code < 0xDC00 && text.substr(pos, 2) == "\\u") {
+                size_t low_pos = pos + 2;
+                auto low = read_hex4(text, low_pos);
+                if (low && *low >= 0xDC00 && *low < 0xE000) {
+                    code = 0x10000 + ((*code - 0xD800) << 10) + (*low - 0xDC00);
+                    pos = low_pos;
+                }
+            }
+            // Unpaired surrogates have no UTF-8 form
+            append_utf8(value, (*code >= 0xD800 && *code < 0xE000) ? 0xFFFD : *code);
+            break;
+        }
+        default:
+            value += escaped; // '"', '\\' and '/'
+        }
+    }
+    return std::nullopt;
+}
+
+auto skip_value(std::string_view text, size_t& pos) -> bool {
+    skip_whitespace(text, pos);
+    if (pos >= text.size()) {
+        return false;
+    }
+    if (text[pos] == '"') {
+        return read_string(text, pos).has_value();
+    }
+    if (text[pos] == '[' || text[pos] == '{') {
+        char close = (text[pos] == '[') ? ']' : '}';
+        bool object = text[pos] == '{';
+        ++pos;
+        if (consume(text, pos, close)) {
+            return true;
+        }
+        do {
+            if (object && (!read_string(text, pos) || !consume(text, pos, ':'))) {
+                return false;
+            }
+            if (!skip_value(text, pos)) {
+                return false;
+            }
+        } while (consume(text, pos, ','));
+        return consume(text, pos, close);
+    }
+    // Number, true, false or null
+    size_t start = pos;
+    while (pos < text.size() && text[pos] != ',' && text[pos] != ']' && text[pos] != '}'
+           && text[pos] != ' ' && text[pos] != '\n' && text[pos] != '\t' && text[pos] != '\r') {
+        ++pos;
+    }
+    return pos > start;
+}
+
+auto read_string_array(std::string_view text, size_t& pos)
+    -> std::optional<std::vector<std::string>> {
+    if (!consume(text, pos, '[')) {
+        return std::nullopt;
+    }
+    std::vector<std::string> values;
+    if (consume(text, pos, ']')) {
+        return values;
+    }
+    do {
+        auto value = read_string(text, pos);
+        if (!value) {
+            return std::nullopt;
+        }
+        values.push_back(std::move(*value));
+    } while (consume(text, pos, ','));
+    return consume(text, pos, ']') ? std::optional(std::move(values)) : std::nullopt;
+}
+
+auto read_compile_command(std::string_view text, size_t& pos) -> std::optional<CompileCommand> {
+    if (!consume(text, pos, '{')) {
+        return std::nullopt;
+    }
+    CompileCommand command;
+    std::optional<std::string> shell_command;
+    if (!consume(text, pos, '}')) {
+        do {
+            auto key = read_string(text, pos);
+            if (!key || !consume(text, pos, ':')) {
+                return std::nullopt;
+            }
+            std::optional<std::string> value;
+            if (*key == "arguments") {
+                auto arguments = read_string_array(text, pos);
+                if (!arguments) {
+                    return std::nullopt;
+                }
+                command.arguments = std::move(*arguments);
+                continue;
+            }
+            if (*key != "directory" && *key != "file" && *key != "command" && *key != "output") {
+                if (!skip_value(text, pos)) {
+                    return std::nullopt;
+                }
+                continue;
+            }
+            value = read_string(text, pos);
+            if (!value) {
+                return std::nullopt;
+            }
+            if (*key == "directory") {
+                command.directory = std::move(*value);
+            } else if (*key == "file") {
+                command.file = std::move(*value);
+            } else if (*key == "output") {
+                command.output = std::move(*value);
+            } else {
+                shell_command = std::move(value);
+            }
+        } while (consume(text, pos, ','));
+        if (!consume(text, pos, '}')) {
+            return std::nullopt;
+        }
+    }
+
+    if (command.directory.empty() || command.file.empty()) {
+        return std::nullopt;
+    }
+    if (command.arguments.empty() && shell_command) {
+        command.arguments = split_command_line(*shell_command);
+    }
+    return command;
+}
+
+// `path` as the compile in `directory` saw it
+auto absolute_in(const std::string& directory, const std::string& path) -> std::string {
+    std::filesystem::path resolved(path);
+    if (resolved.is_relative()) {
+        resolved = std::filesystem::path(directory) / resolved;
+    }
+    return resolved.lexically_normal().string();
+}
+
+// Run a program and capture its stdout (stderr is discarded). std::nullopt if it
+// could not be started, was killed by a signal or exited non-zero.
+auto capture_output(const std::vector<std::string>& arguments) -> std::optional<std::string> {
+    // Close-on-exec from the start, so children spawned by other threads at the
+    // same time never inherit either end (and keep the pipe open)
+    int pipe_ends[2];
+    if (pipe2(pipe_ends, O_CLOEXEC) != 0) {
+        return std::nullopt;
+    }
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, pipe_ends[1], STDOUT_FILENO);
+    posix_spawn_file_actions_addopen(&actions, STDERR_FILENO, "/dev/null", O_WRONLY, 0);
+
+    std::vector<char*> argv;
+    for (const auto& argument : arguments) {
+        argv.push_back(const_cast<char*>(argument.c_str()));
+    }
+    argv.push_back(nullptr);
+
+    pid_t pid = 0;
+    int spawned = posix_spawnp(&pid, argv[0], &actions, nullptr, argv.data(), environ);
+    posix_spawn_file_actions_destroy(&actions);
+    close(pipe_ends[1]);
+    if (spawned != 0) {
+        close(pipe_ends[0]);
+        return std::nullopt;
+    }
+
+    std::string output;
+    char buffer[65536];
+    for (ssize_t n = read(pipe_ends[0], buffer, sizeof(buffer)); n != 0;
+         n = read(pipe_ends[0], buffer, sizeof(buffer))) {
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        output.append(buffer, static_cast<size_t>(n));
+    }
+    close(pipe_ends[0]);
+
+    int status = 0;
+    while (waitpid(pid, &status, 0) < 0 && errno == EINTR) {
+    }
+    // A signal or a non-zero exit (127: could not be executed; otherwise e.g.
+    // compiler errors) means the output cannot be trusted to be complete
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        return std::nullopt;
+    }
+    return output;
+}
+
+using TargetKey = std::tuple<std::string, int, std::string>; // path, line, check
+
+} // namespace
+
+auto parse_compile_commands(std::string_view json) -> std::optional<std::vector<CompileCommand>> {
+    size_t pos = 0;
+    if (!consume(json, pos, '[')) {
+        return std::nullopt;
+    }
+    std::vector<CompileCommand> commands;
+    if (consume(json, pos, ']')) {
+        return commands;
+    }
+    do {
+        auto command = read_compile_command(json, pos);
+        if (!command) {
+            return std::nullopt;
+        }
+        commands.push_back(std::move(*command));
+    } while (consume(json, pos, ','));
+    return consume(json, pos, ']') ? std::optional(std::move(commands)) : std::nullopt;
+}
+
+auto split_command_line(std::string_view command) -> std::vector<std::string> {
+    std::vector<std::string> words;
+    std::string word;
+    bool in_word = false;
+    char quote = '\0';
+    for (size_t i = 0; i < command.size(); ++i) {
+        char c = command[i];
+        if (quote == '\'') {
+            if (c == '\'') {
+                quote = '\0';
+            } else {
+                word += c;
+            }
+        } else if (c == '\\' && i + 1 < command.size()
+                   && (quote == '\0' || command[i + 1] == '"' || command[i + 1] == '\\')) {
+            word += command[++i];
+            in_word = true;
+        } else if (quote == '"') {
+            if (c == '"') {
+                quote = '\0';
+            } else {
+                word += c;
+            }
+        } else if (c == '\'' || c == '"') {
+            quote = c;
+            in_word = true;
+        } else if (c == ' ' || c == '\t' || c == '\n') {
+            if (in_word) {
+                words.push_back(std::move(word));
+                word.clear();
+                in_word = false;
+            }
+        } else {
+            word += c;
+            in_word = true;
+        }
+    }
+    if (in_word) {
+        words.push_back(std::move(word));
+    }
+    return words;
+}
+
+auto depfile_candidates(const CompileCommand& command) -> std::vector<std::string> {
+    std::string output = command.output;
+    const auto& arguments = command.arguments;
+    for (size_t i = 0; i < arguments.size(); ++i) {
+        if (arguments[i] == "-MF" && i + 1 < arguments.size()) {
+            return {absolute_in(command.directory, arguments[i + 1])};
+        }
+        if (arguments[i].rfind("-MF", 0) == 0 && arguments[i].size() > 3) {
+            return {absolute_in(command.directory, arguments[i].substr(3))};
+        }
+        if (arguments[i] == "-o" && i + 1 < arguments.size() && output.empty()) {
+            output = arguments[i + 1];
+        }
+    }
+    if (output.empty()) {
+        return {};
+    }
+
+    auto object = absolute_in(command.directory, output);
+    auto replaced = std::filesystem::path(object).replace_extension(".d").string();
+    return {object + ".d", replaced};
+}
+
+auto parse_depfile(std::string_view text) -> std::vector<std::string> {
+    std::vector<std::string> prerequisites;
+    std::string word;
+    bool after_colon = false;
+    auto finish_word = [&] {
+        if (after_colon && !word.empty()) {
+            prerequisites.push_back(std::move(word));
+        }
+        word.clear();
+    };
+
+    for (size_t i = 0; i < text.size(); ++i) {
+        char c = text[i];
+        if (c == '\\' && i + 1 < text.size()) {
+            char next = text[i + 1];
+            if (next == '\n' || (next == '\r' && i + 2 < text.size() && text[i + 2] == '\n')) {
+                // Line continuation
+                finish_word();
+                i += (next == '\r') ? 2 : 1;
+                continue;
+            }
+            if (next == ' ' || next == '#' || next == '\\') {
+                word += next;
+                ++i;
+                continue;
+            }
+            word += c;
+        } else if (c == '$' && i + 1 < text.size() && text[i + 1] == '$') {
+            word += '$';
+            ++i;
+        } else if (c == '\n') {
+            finish_word();
+            after_colon = false; // Next rule
+        } else if (c == ' ' || c == '\t' || c == '\r') {
+            finish_word();
+        } else if (c == ':' && !after_colon
+                   && (i + 1 == text.size() || text[i + 1] == ' ' || text[i + 1] == '\n'
+                       || text[i + 1] == '\t' || text[i + 1] == '\r')) {
+            // The colon ending the targets is followed by whitespace, unlike a drive letter
+            word.clear();
+            after_colon = true;
+        } else {
+            word += c;
+        }
+    }
+    finish_word();
+    return prerequisites;
+}
+
+auto verification_targets(const std::vector<Warning>& warnings,
+                          const std::unordered_map<size_t, NolintStyle>& decisions,
+                          const std::unordered_map<std::string, LineMap>& line_maps)
+    -> std::vector<Warning> {
+    std::vector<size_t> suppressed;
+    for (const auto& [index, style] : decisions) {
+        if (style != NolintStyle::NONE && line_maps.contains(warnings[index].file_path)) {
+            suppressed.push_back(index);
+        }
+    }
+    std::sort(suppressed.begin(), suppressed.end());
+
+    std::vector<Warning> targets;
+    targets.reserve(suppressed.size());
+    for (auto index : suppressed) {
+        auto target = warnings[index];
+        target.line_number = remap_line(line_maps.at(target.file_path), target.line_number);
+        targets.push_back(std::move(target));
+    }
+    return targets;
+}
+
+auto surviving_targets(const std::vector<Warning>& targets, const std::vector<Warning>& rerun)
+    -> std::vector<Warning> {
+    std::set<TargetKey> reported;
+    for (const auto& warning : rerun) {
+        reported.emplace(warning.file_path, warning.line_number, warning.type);
+    }
+
+    std::vector<Warning> survivors;
+    for (const auto& target : targets) {
+        if (reported.contains({target.file_path, target.line_number, target.type})) {
+            survivors.push_back(target);
+        }
+    }
+    return survivors;
+}
+
+auto select_translation_units(const std::vector<CompileCommand>& commands,
+                              const std::vector<std::string>& modified_files, PathResolver& paths)
+    -> UnitSelection {
+    std::unordered_set<std::uint32_t> modified;
+    for (const auto& file : modified_files) {
+        modified.insert(paths.file_id(file));
+    }
+
+    // One unit per source file: the same file built for several targets has the
+    // same includes as far as suppressions go
+    std::vector<size_t> candidates;
+    std::unordered_set<std::uint32_t> sources;
+    for (size_t i = 0; i < commands.size(); ++i) {
+        if (sources.insert(paths.file_id(absolute_in(commands[i].directory, commands[i].file)))
+                .second) {
+            candidates.push_back(i);
+        }
+    }
+
+    // Every depfile candidate of every unit, read in one batch
+    std::vector<std::string> depfiles;
+    std::vector<size_t> first_depfile;
+    for (auto unit : candidates) {
+        first_depfile.push_back(depfiles.size());
+        auto unit_depfiles = depfile_candidates(commands[unit]);
+        depfiles.insert(depfiles.end(), unit_depfiles.begin(), unit_depfiles.end());
+    }
+    first_depfile.push_back(depfiles.size());
+    auto contents = read_files(depfiles);
+
+    UnitSelection selection;
+    std::unordered_set<std::uint32_t> covered;
+    for (size_t c = 0; c < candidates.size(); ++c) {
+        const auto& command = commands[candidates[c]];
+        auto source = paths.file_id(absolute_in(command.directory, command.file));
+        bool selected = modified.contains(source);
+        if (selected) {
+            covered.insert(source);
+        }
+
+        const std::string* depfile = nullptr;
+        for (size_t d = first_depfile[c]; d < first_depfile[c + 1] && depfile == nullptr; ++d) {
+            if (contents[d]) {
+                depfile = &*contents[d];
+            }
+        }
+        if (depfile == nullptr) {
+            ++selection.missing_depfiles;
+        } else {
+            for (const auto& prerequisite : parse_depfile(*depfile)) {
+                auto id = paths.file_id(absolute_in(command.directory, prerequisite));
+                if (modified.contains(id)) {
+                    covered.insert(id);
+                    selected = true;
+                }
+            }
+        }
+        if (selected) {
+            selection.units.push_back(candidates[c]);
+        }
+    }
+
+    for (const auto& file : modified_files) {
+        if (!covered.contains(paths.file_id(file))) {
+            selection.uncovered_files.push_back(file);
+        }
+    }
+    return selection;
+}
+
+auto verify_suppressions(const VerifyOptions& options, const std::vector<Warning>& targets,
+                         const std::vector<std::string>& modified_files) -> VerifyReport {
+    VerifyReport report;
+    auto database = options.build_directory / "compile_commands.json";
+    auto json = read_files({database.string()}, 1).front();
+    auto commands = json ? parse_compile_commands(*json) : std::nullopt;
+    if (!commands) {
+        report.error_message = "Cannot read " + database.string();
+        return report;
+    }
+    report.success = true;
+
+    PathResolver paths;
+    auto selection = select_translation_units(*commands, modified_files, paths);
+    report.uncovered_files = selection.uncovered_files;
+    report.translation_units = selection.units.size();
+
+    // Only the suppressed checks are run, and headers are included so that
+    // suppressions placed in headers are checked too
+    std::set<std::string> checks;
+    for (const auto& target : targets) {
+        checks.insert(target.type);
+    }
+    std::string check_list = "-*";
+    for (const auto& check : checks) {
+        check_list += "," + check;
+    }
+
+    std::vector<std::optional<std::string>> outputs(selection.units.size());
+    process_each(selection.units.size(), options.worker_count, [&](size_t i) {
+        const auto& command = (*commands)[selection.units[i]];
+        outputs[i] = capture_output({options.clang_tidy, "--quiet", "-p",
+                                     options.build_directory.string(), "--checks=" + check_list,
+                                     "--warnings-as-errors=-*", "--header-filter=.*",
+                                     absolute_in(command.directory, command.file)});
+    });
+
+    std::string rerun_output;
+    for (size_t i = 0; i < outputs.size(); ++i) {
+        if (outputs[i]) {
+            rerun_output += *outputs[i];
+        } else {
+            const auto& command = (*commands)[selection.units[i]];
+            report.failed_units.push_back(absolute_in(command.directory, command.file));
+        }
+    }
+
+    // Both sides go through one resolver so every spelling of a file compares equal
+    WarningParser parser;
+    parser.set_path_resolver(&paths);
+    auto rerun = parser.parse(rerun_output);
+    auto resolved_targets = targets;
+    for (auto& target : resolved_targets) {
+        target.file_path = paths.resolve(target.file_path);
+    }
+    report.survivors = surviving_targets(resolved_targets, rerun);
+    return report;
+}
+
+} // namespace nolint
@@ -1,75 +1,291 @@
 #include "warning_parser.hpp"
+#include "check_registry.hpp"
+#include "parallel_chunks.hpp"
+#include <charconv>
 #include <iostream>
-#include <sstream>
+#include <iterator>
 
 namespace nolint {
 
-auto WarningParser::parse(const std::string& clang_tidy_output) -> std::vector<Warning> {
-    std::istringstream stream(clang_tidy_output);
-    return parse(stream);
+namespace {
+
+// Lines searched after a function size warning for its size note
+constexpr int NOTE_LOOKAHEAD_LINES = 50;
+
+// Spans per worker below which decoding on one thread is faster
+constexpr size_t PARALLEL_DECODE_CHUNK = 1 << 14;
+
+constexpr std::string_view WARNING_MARKER = "warning:";
+
+auto is_space(char c) -> bool {
+    return c == ' ' || c == '\t' || c == '\v' || c == '\f' || c == '\r' || c == '\n';
 }
 
-auto WarningParser::parse(std::istream& input) -> std::vector<Warning> {
-    std::vector<Warning> warnings;
-    std::string line;
-
-    while (std::getline(input, line)) {
-        if (auto warning = parse_line(line)) {
-            warnings.push_back(*warning);
-
-            // Check if a following line (within the next few lines) is a note about function size
-            if (!warnings.empty() && warnings.back().type == "readability-function-size") {
-                std::streampos pos = input.tellg();
-                std::string next_line;
-                bool found_note = false;
-
-                // Look ahead up to 50 lines for the note (clang-tidy can have many context lines)
-                for (int i = 0; i < 50 && std::getline(input, next_line); ++i) {
-                    std::smatch note_match;
-                    if (std::regex_match(next_line, note_match, note_pattern_)) {
-                        warnings.back().function_lines = std::stoi(note_match[1].str());
-                        found_note = true;
-                        break;
-                    }
-
-                    // Also try to catch note lines that mention readability-function-size
-                    // specifically
-                    std::regex alt_pattern{
-                        R"(.*note:\s+(\d+)\s+lines.*readability-function-size.*)"};
-                    if (std::regex_match(next_line, note_match, alt_pattern)) {
-                        warnings.back().function_lines = std::stoi(note_match[1].str());
-                        found_note = true;
-                        break;
-                    }
-                }
+auto is_digit(char c) -> bool { return c >= '0' && c <= '9'; }
+
+// Advance past one or more digits; npos if there are none
+auto skip_digits(std::string_view text, size_t pos) -> size_t {
+    size_t start = pos;
+    while (pos < text.size() && is_digit(text[pos])) {
+        ++pos;
+    }
+    return pos > start ? pos : std::string_view::npos;
+}
+
+// Advance past one or more whitespace characters; npos if there are none
+auto skip_spaces(std::string_view text, size_t pos) -> size_t {
+    size_t start = pos;
+    while (pos < text.size() && is_space(text[pos])) {
+        ++pos;
+    }
+    return pos > start ? pos : std::string_view::npos;
+}
+
+// Match "path:line:col:" + whitespace, returning the position after it
+auto match_location_prefix(std::string_view line) -> size_t {
+    size_t colon = line.find(':');
+    if (colon == std::string_view::npos || colon == 0) {
+        return std::string_view::npos;
+    }
+
+    size_t pos = skip_digits(line, colon + 1);
+    if (pos == std::string_view::npos || pos >= line.size() || line[pos] != ':') {
+        return std::string_view::npos;
+    }
+    pos = skip_digits(line, pos + 1);
+    if (pos == std::string_view::npos || pos >= line.size() || line[pos] != ':') {
+        return std::string_view::npos;
+    }
+    return skip_spaces(line, pos + 1);
+}
+
+auto to_int(std::string_view digits) -> int {
+    int value = 0;
+    std::from_chars(digits.data(), digits.data() + digits.size(), value);
+    return value;
+}
 
-                if (!found_note) {
-                    // Didn't find a note, restore stream position
-                    input.seekg(pos);
+// Decode one located warning, looking ahead for its function size note
+auto decode_span(std::string_view output, const DiagnosticSpan& span, size_t next_line_offset)
+    -> Warning {
+    std::string_view line = output.substr(span.line_offset, span.line_length);
+
+    Warning warning;
+    warning.file_path = std::string(line.substr(0, span.path_length));
+    size_t line_end = skip_digits(line, span.path_length + 1);
+    warning.line_number
+        = to_int(line.substr(span.path_length + 1, line_end - span.path_length - 1));
+    size_t column_end = skip_digits(line, line_end + 1);
+    warning.column = to_int(line.substr(line_end + 1, column_end - line_end - 1));
+    warning.message = std::string(line.substr(span.message_offset, span.message_length));
+    warning.type = std::string(line.substr(span.type_offset, span.type_length));
+
+    if (!reports_function_size(warning.type)) {
+        return warning;
+    }
+
+    // Look ahead for the note (clang-tidy can print many context lines first),
+    // stopping at the next warning so its note is never taken
+    size_t pos = span.line_offset + span.line_length + 1;
+    for (int i = 0; i < NOTE_LOOKAHEAD_LINES && pos < output.size() && pos < next_line_offset;
+         ++i) {
+        size_t end = output.find('\n', pos);
+        if (end == std::string_view::npos) {
+            end = output.size();
+        }
+        if (auto lines = match_function_size_note(output.substr(pos, end - pos))) {
+            warning.function_lines = *lines;
+            break;
+        }
+        pos = end + 1;
+    }
+
+    return warning;
+}
+
+// Remap prefixes, then canonicalize. Warnings arrive grouped by file, so each
+// run of one spelling is rewritten once.
+auto rewrite_paths(std::vector<Warning>& warnings, const PrefixMap* prefix_map,
+                   PathResolver* resolver) -> void {
+    std::string last_spelling;
+    std::string last_rewritten;
+    for (auto& warning : warnings) {
+        if (warning.file_path != last_spelling) {
+            last_spelling = warning.file_path;
+            last_rewritten = warning.file_path;
+            if (prefix_map != nullptr) {
+                if (auto mapped = map_prefix(*prefix_map, last_rewritten)) {
+                    last_rewritten = std::move(*mapped);
                 }
             }
+            if (resolver != nullptr) {
+                last_rewritten = resolver->resolve(last_rewritten);
+            }
         }
+        warning.file_path = last_rewritten;
     }
+}
 
-    return warnings;
+} // namespace
+
+auto match_warning_line(std::string_view line) -> std::optional<DiagnosticSpan> {
+    // file.cpp:line:col: warning: message [warning-type]
+    size_t pos = match_location_prefix(line);
+    if (pos == std::string_view::npos
+        || line.compare(pos, WARNING_MARKER.size(), WARNING_MARKER) != 0) {
+        return std::nullopt;
+    }
+    size_t message_start = skip_spaces(line, pos + WARNING_MARKER.size());
+    if (message_start == std::string_view::npos || line.empty() || line.back() != ']') {
+        return std::nullopt;
+    }
+
+    // The type runs from a whitespace-preceded '[' to the final ']' and cannot
+    // contain ']', so it starts after the last ']' before the end. The message
+    // is as short as possible, so take the first such '['.
+    size_t last = line.size() - 1;
+    size_t inner_bracket = line.rfind(']', last - 1);
+    size_t search_from = message_start + 1;
+    if (inner_bracket != std::string_view::npos && inner_bracket >= search_from) {
+        search_from = inner_bracket + 1;
+    }
+
+    for (size_t open = line.find('[', search_from); open != std::string_view::npos && open < last;
+         open = line.find('[', open + 1)) {
+        if (!is_space(line[open - 1]) || open + 1 == last) {
+            continue;
+        }
+
+        size_t message_end = open - 1;
+        while (message_end > message_start + 1 && is_space(line[message_end - 1])) {
+            --message_end;
+        }
+
+        return DiagnosticSpan{.line_offset = 0,
+                              .line_length = line.size(),
+                              .path_length = line.find(':'),
+                              .message_offset = message_start,
+                              .message_length = message_end - message_start,
+                              .type_offset = open + 1,
+                              .type_length = last - open - 1};
+    }
+
+    return std::nullopt;
 }
 
-auto WarningParser::parse_line(const std::string& line) -> std::optional<Warning> {
-    std::smatch match;
+auto match_function_size_note(std::string_view line) -> std::optional<int> {
+    // file.cpp:line:col: note: 35 lines including whitespace and comments...
+    // or any "note: N lines ... readability-function-size ..." line
+    size_t note = match_location_prefix(line);
+    if (note == std::string_view::npos || line.compare(note, 5, "note:") != 0) {
+        note = line.find("note:");
+    }
+    if (note == std::string_view::npos) {
+        return std::nullopt;
+    }
+
+    size_t count_start = skip_spaces(line, note + 5);
+    size_t count_end = (count_start == std::string_view::npos)
+                           ? std::string_view::npos
+                           : skip_digits(line, count_start);
+    size_t word_start = (count_end == std::string_view::npos)
+                            ? std::string_view::npos
+                            : skip_spaces(line, count_end);
+    if (word_start == std::string_view::npos || line.compare(word_start, 5, "lines") != 0) {
+        return std::nullopt;
+    }
+
+    bool located_note = match_location_prefix(line) == note;
+    size_t after_lines = skip_spaces(line, word_start + 5);
+    bool including = located_note && after_lines != std::string_view::npos
+                     && line.compare(after_lines, 9, "including") == 0;
+    bool mentions_check
+        = line.find("readability-function-size", word_start) != std::string_view::npos;
 
-    if (!std::regex_match(line, match, warning_pattern_)) {
+    if (!including && !mentions_check) {
         return std::nullopt;
     }
+    return to_int(line.substr(count_start, count_end - count_start));
+}
 
-    // Extract matched groups
-    Warning warning;
-    warning.file_path = match[1].str();
-    warning.line_number = std::stoi(match[2].str());
-    warning.column = std::stoi(match[3].str());
-    warning.message = match[4].str();
-    warning.type = match[5].str();
+auto WarningParser::parse(const std::string& clang_tidy_output) -> std::vector<Warning> {
+    auto warnings = decode(clang_tidy_output, scan(clang_tidy_output));
+    if (prefix_map_ != nullptr || resolver_ != nullptr) {
+        rewrite_paths(warnings, prefix_map_, resolver_);
+    }
+    return warnings;
+}
 
-    return warning;
+auto WarningParser::parse(std::istream& input) -> std::vector<Warning> {
+    // One copy of the input: a sized read when the stream can seek, else grow as we go
+    std::string content;
+    auto start = input.tellg();
+    if (start != std::istream::pos_type(-1) && input.seekg(0, std::ios::end)) {
+        auto size = input.tellg() - start;
+        input.seekg(start);
+        content.resize(static_cast<size_t>(size));
+        input.read(content.data(), size);
+        content.resize(static_cast<size_t>(input.gcount()));
+    } else {
+        input.clear();
+        content.assign(std::istreambuf_iterator<char>(input), {});
+    }
+    return parse(content);
+}
+
+auto WarningParser::scan(std::string_view output) -> std::vector<DiagnosticSpan> {
+    std::vector<DiagnosticSpan> spans;
+
+    // Jump between "warning:" occurrences instead of visiting every line
+    size_t pos = 0;
+    while ((pos = output.find(WARNING_MARKER, pos)) != std::string_view::npos) {
+        size_t line_start = output.rfind('\n', pos);
+        line_start = (line_start == std::string_view::npos) ? 0 : line_start + 1;
+        size_t line_end = output.find('\n', pos);
+        if (line_end == std::string_view::npos) {
+            line_end = output.size();
+        }
+
+        if (auto span = match_warning_line(output.substr(line_start, line_end - line_start))) {
+            span->line_offset = line_start;
+            spans.push_back(*span);
+        }
+
+        if (progress_ != nullptr) {
+            progress_->bytes_done.store(line_end, std::memory_order_relaxed);
+        }
+        pos = line_end;
+    }
+
+    if (progress_ != nullptr) {
+        progress_->bytes_done.store(output.size(), std::memory_order_relaxed);
+    }
+    return spans;
+}
+
+auto WarningParser::decode(std::string_view output, const std::vector<DiagnosticSpan>& spans)
+    -> std::vector<Warning> {
+    auto chunk_results = process_in_chunks<std::vector<Warning>>(
+        spans.size(), PARALLEL_DECODE_CHUNK, [this, output, &spans](size_t begin, size_t end) {
+            std::vector<Warning> warnings;
+            warnings.reserve(end - begin);
+            for (size_t i = begin; i < end; ++i) {
+                size_t next_line_offset
+                    = (i + 1 < spans.size()) ? spans[i + 1].line_offset : output.size();
+                warnings.push_back(decode_span(output, spans[i], next_line_offset));
+                if (progress_ != nullptr) {
+                    progress_->warnings_done.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+            return warnings;
+        });
+
+    std::vector<Warning> warnings;
+    warnings.reserve(spans.size());
+    for (auto& chunk : chunk_results) {
+        std::move(chunk.begin(), chunk.end(), std::back_inserter(warnings));
+    }
+    return warnings;
 }
 
 } // namespace nolint
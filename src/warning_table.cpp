@@ -0,0 +1,51 @@
+#include "warning_table.hpp"
+#include "ui_model.hpp"
+
+namespace nolint {
+
+namespace {
+
+// Append one warning as a new row
+auto append_warning(WarningTable& table, const Warning& warning) -> void {
+    if (table.message_offsets.empty()) {
+        table.message_offsets.push_back(0);
+    }
+
+    table.path_ids.push_back(intern(table.paths, warning.file_path));
+    table.type_ids.push_back(intern_check(table.checks, warning.type));
+    table.lines.push_back(warning.line_number);
+    table.columns.push_back(warning.column);
+    table.function_lines.push_back(warning.function_lines.value_or(NO_FUNCTION_LINES));
+    table.message_text += warning.message;
+    table.message_offsets.push_back(table.message_text.size());
+}
+
+} // namespace
+
+auto build_warning_table(const std::vector<Warning>& warnings) -> WarningTable {
+    WarningTable table;
+    table.path_ids.reserve(warnings.size());
+    table.type_ids.reserve(warnings.size());
+    table.lines.reserve(warnings.size());
+    table.columns.reserve(warnings.size());
+    table.function_lines.reserve(warnings.size());
+    table.message_offsets.reserve(warnings.size() + 1);
+
+    size_t message_bytes = 0;
+    for (const auto& warning : warnings) {
+        message_bytes += warning.message.size();
+    }
+    table.message_text.reserve(message_bytes);
+
+    for (const auto& warning : warnings) {
+        append_warning(table, warning);
+    }
+
+    return table;
+}
+
+auto warning_row(const WarningTable& table, size_t index) -> WarningRow {
+    return WarningRow{.table = &table, .index = index};
+}
+
+} // namespace nolint
@@ -179,3 +179,64 @@ TEST_F(AnnotatedFileTest, ImmutableOperations) {
     // Modified file should have changes
     EXPECT_TRUE(modified.lines[1].inline_comment.has_value());
 }
+
+TEST_F(AnnotatedFileTest, AtomicWriteGoesThroughSymlinks) {
+    const std::string link = "test_annotated_link.cpp";
+    std::filesystem::remove(link);
+    std::filesystem::create_symlink(test_file_, link);
+    
+    ASSERT_TRUE(write_lines_atomically({"int x = 1;"}, link));
+    
+    EXPECT_TRUE(std::filesystem::is_symlink(link));
+    std::ifstream target(test_file_);
+    std::string line;
+    std::getline(target, line);
+    EXPECT_EQ(line, "int x = 1;");
+    std::filesystem::remove(link);
+}
+
+TEST_F(AnnotatedFileTest, AtomicWriteKeepsHardLinks) {
+    const std::string other = "test_annotated_hardlink.cpp";
+    std::filesystem::remove(other);
+    std::filesystem::create_hard_link(test_file_, other);
+    
+    ASSERT_TRUE(write_lines_atomically({"int y = 2;"}, test_file_));
+    
+    EXPECT_TRUE(std::filesystem::equivalent(test_file_, other));
+    std::ifstream linked(other);
+    std::string line;
+    std::getline(linked, line);
+    EXPECT_EQ(line, "int y = 2;");
+    std::filesystem::remove(other);
+}
+
+TEST_F(AnnotatedFileTest, AtomicWriteLeavesNoTemporaryAndKeepsMode) {
+    std::filesystem::permissions(test_file_, std::filesystem::perms::owner_read
+                                                 | std::filesystem::perms::owner_write
+                                                 | std::filesystem::perms::group_read);
+    
+    ASSERT_TRUE(write_lines_atomically({"int z = 3;"}, test_file_));
+    
+    auto mode = std::filesystem::status(test_file_).permissions();
+    EXPECT_EQ(mode & std::filesystem::perms::all,
+              std::filesystem::perms::owner_read | std::filesystem::perms::owner_write
+                  | std::filesystem::perms::group_read);
+    for (const auto& entry : std::filesystem::directory_iterator(".")) {
+        EXPECT_EQ(entry.path().filename().string().find(".nolint."), std::string::npos)
+            << entry.path();
+    }
+}
+
+TEST_F(AnnotatedFileTest, AtomicWriteCreatesNewFileWithUmaskMode) {
+    const std::string created = "test_annotated_new.cpp";
+    const std::string reference = "test_annotated_reference.cpp";
+    std::filesystem::remove(created);
+    std::ofstream(reference) << "\n";  // Created the usual way, umask applied
+    
+    ASSERT_TRUE(write_lines_atomically({"int n = 4;"}, created));
+    
+    EXPECT_EQ(std::filesystem::status(created).permissions(),
+              std::filesystem::status(reference).permissions());
+    std::filesystem::remove(created);
+    std::filesystem::remove(reference);
+}
@@ -0,0 +1,205 @@
+#include "../include/autosave_writer.hpp"
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+using namespace nolint;
+
+class AutosaveWriterTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        std::ofstream file(test_file_);
+        file << "int main() {\n";
+        file << "    int unused_var = 42;\n";
+        file << "    return 0;\n";
+        file << "}\n";
+    }
+    
+    void TearDown() override {
+        std::filesystem::remove(test_file_);
+    }
+    
+    std::vector<std::string> read_back() {
+        std::vector<std::string> lines;
+        std::ifstream file(test_file_);
+        std::string line;
+        while (std::getline(file, line)) {
+            lines.push_back(line);
+        }
+        return lines;
+    }
+    
+    Warning unused_warning() {
+        return {test_file_, 2, 9, "clang-diagnostic-unused-variable", "unused", std::nullopt};
+    }
+    
+    const std::string test_file_ = "test_autosave.cpp";
+};
+
+TEST_F(AutosaveWriterTest, GroupAndCollectDecisions) {
+    std::vector<Warning> warnings = {
+        {"a.cpp", 1, 1, "t", "m", std::nullopt},
+        {"b.cpp", 1, 1, "t", "m", std::nullopt},
+        {"a.cpp", 2, 1, "t", "m", std::nullopt}
+    };
+    std::unordered_map<size_t, NolintStyle> decisions = {
+        {0, NolintStyle::NONE}, {2, NolintStyle::NOLINT}};
+    
+    auto grouped = group_warning_indices_by_file(warnings);
+    ASSERT_EQ(grouped["a.cpp"], (std::vector<size_t>{0, 2}));
+    
+    auto collected = collect_file_decisions(warnings, decisions, grouped["a.cpp"]);
+    ASSERT_EQ(collected.size(), 1);
+    EXPECT_EQ(collected[0].first.line_number, 2);
+}
+
+TEST_F(AutosaveWriterTest, FlushWritesSubmittedFile) {
+    AutosaveWriter writer(std::chrono::milliseconds(10000));  // Only flush() forces the write
+    writer.submit(test_file_, {{unused_warning(), NolintStyle::NOLINT}});
+    
+    auto result = writer.flush();
+    
+    ASSERT_EQ(result.written_files.size(), 1);
+    auto lines = read_back();
+    ASSERT_EQ(lines.size(), 4);
+    EXPECT_EQ(lines[1], "    int unused_var = 42;  // NOLINT(clang-diagnostic-unused-variable)");
+}
+
+TEST_F(AutosaveWriterTest, ResubmitRendersFromOriginal) {
+    AutosaveWriter writer(std::chrono::milliseconds(0));
+    writer.submit(test_file_, {{unused_warning(), NolintStyle::NOLINT}});
+    writer.flush();
+    
+    // Changing the decision must replace the comment, not stack a second one
+    writer.submit(test_file_, {{unused_warning(), NolintStyle::NOLINTNEXTLINE}});
+    writer.flush();
+    
+    auto lines = read_back();
+    ASSERT_EQ(lines.size(), 5);
+    EXPECT_EQ(lines[1], "    // NOLINTNEXTLINE(clang-diagnostic-unused-variable)");
+    EXPECT_EQ(lines[2], "    int unused_var = 42;");
+}
+
+TEST_F(AutosaveWriterTest, CoalescesRapidToggles) {
+    AutosaveWriter writer(std::chrono::milliseconds(10000));
+    writer.submit(test_file_, {{unused_warning(), NolintStyle::NOLINT}});
+    writer.submit(test_file_, {});  // Toggled back before the write happened
+    
+    auto result = writer.flush();
+    
+    EXPECT_TRUE(result.written_files.empty());
+    EXPECT_EQ(read_back().size(), 4);
+}
+
+TEST_F(AutosaveWriterTest, FileWrittenBackToOriginalIsNotReported) {
+    AutosaveWriter writer(std::chrono::milliseconds(0));
+    writer.submit(test_file_, {{unused_warning(), NolintStyle::NOLINT}});
+    ASSERT_EQ(writer.flush().written_files.size(), 1);
+    
+    writer.submit(test_file_, {});  // Decision cleared after the write
+    auto result = writer.flush();
+    
+    EXPECT_TRUE(result.written_files.empty());
+    EXPECT_EQ(read_back().size(), 4);
+}
+
+TEST_F(AutosaveWriterTest, RevertRestoresOriginal) {
+    AutosaveWriter writer(std::chrono::milliseconds(0));
+    writer.submit(test_file_, {{unused_warning(), NolintStyle::NOLINTNEXTLINE}});
+    writer.flush();
+    ASSERT_EQ(read_back().size(), 5);
+    
+    auto reverted = writer.revert();
+    
+    EXPECT_EQ(reverted.written_files.size(), 1);
+    auto lines = read_back();
+    ASSERT_EQ(lines.size(), 4);
+    EXPECT_EQ(lines[1], "    int unused_var = 42;");
+}
+
+TEST_F(AutosaveWriterTest, MissingFileIsReportedAndNeverCreated) {
+    const std::string missing = "test_autosave_missing.cpp";
+    std::filesystem::remove(missing);
+    Warning warning{missing, 2, 9, "clang-diagnostic-unused-variable", "unused", std::nullopt};
+    
+    AutosaveWriter writer(std::chrono::milliseconds(0));
+    writer.submit(missing, {{warning, NolintStyle::NOLINT}});
+    auto result = writer.flush();
+    
+    EXPECT_TRUE(result.written_files.empty());
+    EXPECT_EQ(result.failed_files, (std::vector<std::string>{missing}));
+    EXPECT_FALSE(std::filesystem::exists(missing));
+    
+    auto reverted = writer.revert();
+    EXPECT_TRUE(reverted.written_files.empty());
+    EXPECT_FALSE(std::filesystem::exists(missing));
+    EXPECT_EQ(writer.restore_original(missing), std::nullopt);
+}
+
+TEST_F(AutosaveWriterTest, RebaseRendersFromEditedFile) {
+    AutosaveWriter writer(std::chrono::milliseconds(0));
+    writer.submit(test_file_, {{unused_warning(), NolintStyle::NOLINTNEXTLINE}});
+    writer.flush();
+    
+    // The editor sees the text the warnings refer to, not the annotated one
+    auto original = writer.restore_original(test_file_);
+    ASSERT_TRUE(original.has_value());
+    EXPECT_EQ(original->size(), 4);
+    ASSERT_EQ(read_back(), *original);
+    
+    {
+        std::ofstream file(test_file_);
+        file << "// edited\n";
+        file << "int main() {\n";
+        file << "    int unused_var = 42;\n";
+        file << "    return 0;\n";
+        file << "}\n";
+    }
+    writer.rebase(test_file_);
+    
+    auto moved = unused_warning();
+    moved.line_number = 3;
+    writer.submit(test_file_, {{moved, NolintStyle::NOLINT}});
+    writer.flush();
+    
+    auto lines = read_back();
+    ASSERT_EQ(lines.size(), 5);
+    EXPECT_EQ(lines[0], "// edited");
+    EXPECT_EQ(lines[2], "    int unused_var = 42;  // NOLINT(clang-diagnostic-unused-variable)");
+    
+    // Reverting keeps the edit
+    writer.revert();
+    EXPECT_EQ(read_back()[0], "// edited");
+    EXPECT_EQ(read_back()[2], "    int unused_var = 42;");
+}
+
+TEST_F(AutosaveWriterTest, RestoreOriginalOfUntouchedFile) {
+    AutosaveWriter writer(std::chrono::milliseconds(0));
+    
+    EXPECT_FALSE(writer.restore_original(test_file_).has_value());
+}
+
+TEST_F(AutosaveWriterTest, RestoreOriginalWhileWritesAreInFlight) {
+    AutosaveWriter writer(std::chrono::milliseconds(0));
+    std::thread submitter([&] {
+        for (int i = 0; i < 200; ++i) {
+            writer.submit(test_file_, {{unused_warning(), (i % 2 == 0)
+                                                              ? NolintStyle::NOLINT
+                                                              : NolintStyle::NOLINTNEXTLINE}});
+        }
+    });
+    for (int i = 0; i < 200; ++i) {
+        auto original = writer.restore_original(test_file_);
+        if (original) {
+            EXPECT_EQ(original->size(), 4);
+        }
+    }
+    submitter.join();
+    
+    writer.flush();
+    auto original = writer.restore_original(test_file_);
+    ASSERT_TRUE(original.has_value());
+    EXPECT_EQ(*original, read_back());
+    EXPECT_EQ(read_back().size(), 4);
+}
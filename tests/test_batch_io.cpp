@@ -0,0 +1,81 @@
+#include "../include/batch_io.hpp"
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+using namespace nolint;
+
+class BatchIoTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        std::filesystem::create_directories(directory_);
+        for (int i = 0; i < 40; ++i) {
+            paths_.push_back(directory_ + "/file" + std::to_string(i) + ".cpp");
+            std::ofstream(paths_.back()) << "int value = " << i << ";\n";
+        }
+    }
+    
+    void TearDown() override {
+        std::filesystem::remove_all(directory_);
+    }
+    
+    const std::string directory_ = "test_batch_io_dir";
+    std::vector<std::string> paths_;
+};
+
+TEST(SplitLinesTest, MatchesGetline) {
+    for (std::string text : {"", "a", "a\n", "a\n\nb", "a\r\nb\n\n"}) {
+        std::istringstream input(text);
+        std::vector<std::string> expected;
+        for (std::string line; std::getline(input, line);) {
+            expected.push_back(line);
+        }
+        
+        EXPECT_EQ(split_lines(text), expected) << "for \"" << text << "\"";
+    }
+}
+
+TEST_F(BatchIoTest, ReadsEveryFileInOrder) {
+    auto paths = paths_;
+    paths.push_back(directory_ + "/missing.cpp");
+    
+    auto contents = read_files(paths, 4);
+    
+    ASSERT_EQ(contents.size(), paths.size());
+    for (size_t i = 0; i < paths_.size(); ++i) {
+        ASSERT_TRUE(contents[i].has_value());
+        EXPECT_EQ(*contents[i], "int value = " + std::to_string(i) + ";\n");
+    }
+    EXPECT_FALSE(contents.back().has_value());
+}
+
+TEST_F(BatchIoTest, DirectoriesAndMissingPathsAreUnreadable) {
+    auto contents = read_files({directory_, paths_[0], directory_ + "/missing.cpp"});
+    
+    ASSERT_EQ(contents.size(), 3);
+    EXPECT_FALSE(contents[0].has_value());
+    ASSERT_TRUE(contents[1].has_value());
+    EXPECT_EQ(*contents[1], "int value = 0;\n");
+    EXPECT_FALSE(contents[2].has_value());
+}
+
+TEST_F(BatchIoTest, WritesEveryFileAndCountsProgress) {
+    std::vector<FileWrite> writes;
+    for (size_t i = 0; i < paths_.size(); ++i) {
+        writes.push_back(FileWrite{.path = paths_[i], .lines = {"// " + std::to_string(i), "x"}});
+    }
+    writes.push_back(FileWrite{.path = directory_ + "/no/such/dir.cpp", .lines = {"x"}});
+    ProgressCounters progress;
+    
+    auto written = write_files(writes, &progress, 4);
+    
+    ASSERT_EQ(written.size(), writes.size());
+    EXPECT_FALSE(written.back());
+    EXPECT_EQ(progress.files_done.load(), writes.size());
+    auto contents = read_files(paths_);
+    for (size_t i = 0; i < paths_.size(); ++i) {
+        EXPECT_TRUE(written[i]);
+        EXPECT_EQ(*contents[i], "// " + std::to_string(i) + "\nx\n");
+    }
+}
@@ -0,0 +1,47 @@
+#include "../include/check_registry.hpp"
+#include <gtest/gtest.h>
+
+using namespace nolint;
+
+static_assert(find_known_check("readability-magic-numbers").has_value());
+static_assert(!find_known_check("readability-magic-number").has_value());
+static_assert(check_category("clang-analyzer-core.NullDereference") == "clang-analyzer");
+static_assert(reports_function_size("google-readability-function-size"));
+static_assert(!reports_function_size("mycompany-function-size"));
+
+TEST(CheckRegistryTest, EveryKnownCheckHashesToItsOwnId) {
+    for (CheckId id = 0; id < KNOWN_CHECK_COUNT; ++id) {
+        EXPECT_EQ(find_known_check(KNOWN_CHECKS[id].name), id) << KNOWN_CHECKS[id].name;
+    }
+}
+
+TEST(CheckRegistryTest, UnknownNamesAreRejected) {
+    EXPECT_FALSE(find_known_check("").has_value());
+    EXPECT_FALSE(find_known_check("readability").has_value());
+    EXPECT_FALSE(find_known_check("mycompany-custom-check").has_value());
+}
+
+TEST(CheckRegistryTest, KnownCheckMetadata) {
+    auto info = known_check_info(*find_known_check("readability-function-size"));
+    
+    EXPECT_EQ(info.name, "readability-function-size");
+    EXPECT_EQ(info.category, "readability");
+    EXPECT_TRUE(info.reports_function_size);
+    EXPECT_FALSE(known_check_info(*find_known_check("modernize-use-auto")).reports_function_size);
+    EXPECT_TRUE(reports_function_size("hicpp-function-size"));
+}
+
+TEST(CheckRegistryTest, UnknownChecksAreInternedAfterKnownOnes) {
+    CheckRegistry registry;
+    
+    CheckId known = intern_check(registry, "modernize-use-nullptr");
+    CheckId custom = intern_check(registry, "mycompany-custom-check");
+    
+    EXPECT_LT(known, KNOWN_CHECK_COUNT);
+    EXPECT_EQ(custom, KNOWN_CHECK_COUNT);
+    EXPECT_EQ(intern_check(registry, "mycompany-custom-check"), custom);
+    EXPECT_EQ(check_name(registry, custom), "mycompany-custom-check");
+    EXPECT_EQ(check_name(registry, known), "modernize-use-nullptr");
+    EXPECT_EQ(check_count(registry), KNOWN_CHECK_COUNT + 1);
+    EXPECT_EQ(check_category("mycompany-custom-check"), "mycompany");
+}
@@ -0,0 +1,98 @@
+#include "../include/check_trie.hpp"
+#include "../include/ui_model.hpp"
+#include <gtest/gtest.h>
+
+using namespace nolint;
+
+namespace {
+
+auto sample_table() -> WarningTable {
+    return build_warning_table({
+        {"a.cpp", 1, 1, "readability-identifier-naming", "m", std::nullopt},
+        {"a.cpp", 2, 1, "readability-identifier-length", "m", std::nullopt},
+        {"a.cpp", 3, 1, "readability-magic-numbers", "m", std::nullopt},
+        {"b.cpp", 4, 1, "readability-magic-numbers", "m", std::nullopt},
+        {"b.cpp", 5, 1, "modernize-use-auto", "m", std::nullopt}
+    });
+}
+
+auto find_node(const CheckTrie& trie, const std::string& label) -> size_t {
+    for (size_t i = 0; i < trie.nodes.size(); ++i) {
+        if (trie.nodes[i].label == label) {
+            return i;
+        }
+    }
+    return NO_TRIE_NODE;
+}
+
+} // namespace
+
+TEST(CheckTrieTest, GroupsChecksByPrefix) {
+    auto trie = build_check_trie(sample_table(), {});
+    
+    ASSERT_EQ(trie.roots.size(), 2);
+    size_t readability = find_node(trie, "readability");
+    size_t identifier = find_node(trie, "readability-identifier");
+    ASSERT_NE(readability, NO_TRIE_NODE);
+    ASSERT_NE(identifier, NO_TRIE_NODE);
+    EXPECT_EQ(trie.nodes[identifier].parent, readability);
+    EXPECT_EQ(trie.nodes[readability].counts.total, 4);
+    EXPECT_EQ(trie.nodes[identifier].counts.total, 2);
+    
+    // Single-child prefixes are merged into their child
+    EXPECT_EQ(find_node(trie, "readability-magic"), NO_TRIE_NODE);
+    EXPECT_EQ(trie.nodes[find_node(trie, "readability-magic-numbers")].parent, readability);
+    EXPECT_EQ(trie.nodes[find_node(trie, "modernize-use-auto")].depth, 1);
+}
+
+TEST(CheckTrieTest, DecisionChangesUpdateAncestors) {
+    auto table = sample_table();
+    auto trie = build_check_trie(table, {{0, NolintStyle::NOLINT}});
+    size_t readability = find_node(trie, "readability");
+    
+    EXPECT_EQ(trie.nodes[readability].counts.nolint, 1);
+    EXPECT_EQ(trie.nodes[readability].counts.unsuppressed, 3);
+    
+    apply_decision_change(trie, table.type_ids[1], NolintStyle::NONE, NolintStyle::NOLINT_BLOCK);
+    
+    EXPECT_EQ(trie.nodes[readability].counts.nolint_block, 1);
+    EXPECT_EQ(trie.nodes[find_node(trie, "readability-identifier")].counts.unsuppressed, 0);
+    EXPECT_EQ(trie.nodes[find_node(trie, "modernize")].counts.unsuppressed, 1);
+}
+
+TEST(CheckTrieTest, VisibleRowsFollowExpansion) {
+    auto trie = build_check_trie(sample_table(), {});
+    
+    auto collapsed = visible_trie_rows(trie);
+    ASSERT_EQ(collapsed.size(), 2);
+    EXPECT_EQ(trie.nodes[collapsed[0]].label, "readability"); // Larger total first
+    
+    trie.nodes[find_node(trie, "readability")].expanded = true;
+    auto expanded = visible_trie_rows(trie);
+    
+    ASSERT_EQ(expanded.size(), 4);
+    EXPECT_EQ(trie.nodes[expanded[1]].label, "readability-identifier");
+    EXPECT_EQ(trie.nodes[expanded[2]].label, "readability-magic-numbers");
+    EXPECT_EQ(trie.nodes[expanded[3]].label, "modernize");
+    EXPECT_EQ(checks_under(trie, find_node(trie, "readability")).size(), 3);
+}
+
+TEST(CheckTrieTest, SortKeysUseRanks) {
+    auto table = sample_table();
+    auto trie = build_check_trie(table, {{4, NolintStyle::NOLINT}});
+    
+    auto by_name = visible_trie_rows(trie, StatisticsSort::NAME);
+    auto by_nolint = visible_trie_rows(trie, StatisticsSort::NOLINT);
+    
+    EXPECT_EQ(trie.nodes[by_name[0]].label, "modernize");
+    EXPECT_EQ(trie.nodes[by_nolint[0]].label, "modernize");
+    EXPECT_EQ(trie.nodes[visible_trie_rows(trie)[0]].label, "readability");
+    
+    // Decisions mark ranks stale; re-ranking reflects the new counts
+    apply_decision_change(trie, table.type_ids[4], NolintStyle::NOLINT, NolintStyle::NONE);
+    apply_decision_change(trie, table.type_ids[0], NolintStyle::NONE, NolintStyle::NOLINT);
+    EXPECT_FALSE(trie.ranks_current);
+    rank_trie_nodes(trie);
+    
+    EXPECT_EQ(trie.nodes[visible_trie_rows(trie, StatisticsSort::NOLINT)[0]].label, "readability");
+}
@@ -0,0 +1,73 @@
+#include "../include/cpp_lexer.hpp"
+#include <gtest/gtest.h>
+
+using namespace nolint;
+
+namespace {
+
+// Text and kind of each span, for compact expectations
+auto spans_of(std::string_view line, LexState& state)
+    -> std::vector<std::pair<std::string, TokenKind>> {
+    std::vector<std::pair<std::string, TokenKind>> result;
+    for (const auto& span : lex_line(line, state)) {
+        result.emplace_back(std::string(line.substr(span.start, span.length)), span.kind);
+    }
+    return result;
+}
+
+} // namespace
+
+TEST(CppLexerTest, KeywordsTypesNumbersAndStrings) {
+    LexState state;
+    
+    auto spans = spans_of("return static_cast<int>(x) + 0x1F'FF + 1.5e-3 + \"a\\\"b\";", state);
+    
+    std::vector<std::pair<std::string, TokenKind>> expected = {
+        {"return", TokenKind::KEYWORD}, {"static_cast", TokenKind::KEYWORD},
+        {"int", TokenKind::TYPE},       {"0x1F'FF", TokenKind::NUMBER},
+        {"1.5e-3", TokenKind::NUMBER},  {"\"a\\\"b\"", TokenKind::STRING}};
+    EXPECT_EQ(spans, expected);
+}
+
+TEST(CppLexerTest, IdentifiersAreNotColored) {
+    LexState state;
+    
+    EXPECT_TRUE(lex_line("foo_bar(baz1, returned);", state).empty());
+}
+
+TEST(CppLexerTest, BlockCommentSpansLines) {
+    LexState state;
+    
+    auto first = spans_of("int x; /* start", state);
+    EXPECT_TRUE(state.in_block_comment);
+    auto second = spans_of("still comment */ return", state);
+    
+    EXPECT_EQ(first.back().first, "/* start");
+    EXPECT_EQ(second.front(), std::make_pair(std::string("still comment */"), TokenKind::COMMENT));
+    EXPECT_EQ(second.back().second, TokenKind::KEYWORD);
+    EXPECT_FALSE(state.in_block_comment);
+}
+
+TEST(CppLexerTest, RawStringSpansLines) {
+    LexState state;
+    
+    spans_of("auto s = R\"xy(first )\" line", state);
+    EXPECT_TRUE(state.in_raw_string);
+    auto second = spans_of("end)xy\"; // done", state);
+    
+    EXPECT_EQ(second.front(), std::make_pair(std::string("end)xy\""), TokenKind::STRING));
+    EXPECT_EQ(second.back(), std::make_pair(std::string("// done"), TokenKind::COMMENT));
+}
+
+TEST(CppLexerTest, DirectiveContinuation) {
+    LexState state;
+    
+    auto first = spans_of("  #define TWICE(x) \\", state);
+    auto second = spans_of("    ((x) * 2)", state);
+    auto third = spans_of("int y;", state);
+    
+    ASSERT_EQ(first.size(), 1);
+    EXPECT_EQ(first[0].second, TokenKind::PREPROCESSOR);
+    EXPECT_EQ(second[0].second, TokenKind::PREPROCESSOR);
+    EXPECT_EQ(third[0], std::make_pair(std::string("int"), TokenKind::TYPE));
+}
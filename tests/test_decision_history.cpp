@@ -0,0 +1,113 @@
+#include "../include/ui_model.hpp"
+#include <gtest/gtest.h>
+
+using namespace nolint;
+
+TEST(DecisionHistoryTest, EmptyHistory) {
+    DecisionHistory history;
+    
+    EXPECT_EQ(pop_undo(history), nullptr);
+    EXPECT_EQ(pop_redo(history), nullptr);
+    EXPECT_EQ(undo_depth(history), 0);
+}
+
+TEST(DecisionHistoryTest, PushUndoRedo) {
+    DecisionHistory history;
+    history = push_action(history, {{1, NolintStyle::NONE, NolintStyle::NOLINT}}, 0);
+    history = push_action(history, {{2, NolintStyle::NONE, NolintStyle::NOLINT}}, 1);
+    
+    auto undone = pop_undo(history);
+    ASSERT_NE(undone, nullptr);
+    EXPECT_EQ((*undone->changes)[0].warning_index, 2);
+    EXPECT_EQ(undo_depth(history), 1);
+    EXPECT_EQ(redo_depth(history), 1);
+    
+    auto redone = pop_redo(history);
+    ASSERT_NE(redone, nullptr);
+    EXPECT_EQ((*redone->changes)[0].warning_index, 2);
+    EXPECT_EQ(undo_depth(history), 2);
+    EXPECT_EQ(redo_depth(history), 0);
+}
+
+TEST(DecisionHistoryTest, UndoRedoShareTheChangeList) {
+    DecisionHistory history;
+    history = push_action(history, {{1, NolintStyle::NONE, NolintStyle::NOLINT}}, 0);
+    auto pushed = history.undo_stack->changes;
+    
+    pop_undo(history);
+    EXPECT_EQ(history.redo_stack->changes, pushed);  // Relinked, not copied
+    pop_redo(history);
+    EXPECT_EQ(history.undo_stack->changes, pushed);
+}
+
+TEST(DecisionHistoryTest, NewActionClearsRedo) {
+    DecisionHistory history;
+    history = push_action(history, {{1, NolintStyle::NONE, NolintStyle::NOLINT}}, 0);
+    pop_undo(history);
+    
+    history = push_action(history, {{3, NolintStyle::NONE, NolintStyle::NOLINT}}, 0);
+    
+    EXPECT_EQ(redo_depth(history), 0);
+    EXPECT_EQ(undo_depth(history), 1);
+}
+
+TEST(DecisionHistoryTest, CopiesShareOlderNodes) {
+    DecisionHistory history;
+    history = push_action(history, {{1, NolintStyle::NONE, NolintStyle::NOLINT}}, 0);
+    
+    auto branch = push_action(history, {{2, NolintStyle::NONE, NolintStyle::NOLINT}}, 0);
+    
+    EXPECT_EQ(branch.undo_stack->next, history.undo_stack);  // Shared, not copied
+    EXPECT_EQ(undo_depth(history), 1);
+}
+
+TEST(DecisionHistoryTest, DepthIsBounded) {
+    DecisionHistory history;
+    for (size_t i = 0; i < MAX_UNDO_LEVELS * 3; ++i) {
+        history = push_action(history, {{i, NolintStyle::NONE, NolintStyle::NOLINT}}, 0);
+    }
+    
+    EXPECT_EQ(undo_depth(history), MAX_UNDO_LEVELS);
+    EXPECT_EQ((*pop_undo(history)->changes)[0].warning_index, MAX_UNDO_LEVELS * 3 - 1);
+    
+    // Exactly the oldest levels were dropped
+    size_t oldest = 0;
+    while (auto node = pop_undo(history)) {
+        oldest = (*node->changes)[0].warning_index;
+    }
+    EXPECT_EQ(oldest, MAX_UNDO_LEVELS * 2);
+}
+
+TEST(DecisionHistoryTest, UndoRedoThroughUpdate) {
+    UIModel model;
+    model.warnings = {
+        {"file1.cpp", 10, 5, "type1", "message1", std::nullopt},
+        {"file2.cpp", 20, 10, "type2", "message2", std::nullopt}
+    };
+    model = apply_filter(model, "");
+    
+    model = update(model, InputEvent::ARROW_UP);     // NONE -> NOLINT
+    model = update(model, InputEvent::ARROW_UP);     // NOLINT -> NOLINTNEXTLINE
+    model = update(model, InputEvent::ARROW_RIGHT);
+    
+    auto undone = update(model, InputEvent::UNDO);
+    EXPECT_EQ(undone.current_index, 0);              // Cursor returns to the change
+    EXPECT_EQ(undone.current_style(), NolintStyle::NOLINT);
+    
+    auto undone_twice = update(undone, InputEvent::UNDO);
+    EXPECT_EQ(undone_twice.current_style(), NolintStyle::NONE);
+    
+    // Undone warning counts as undecided again
+    auto moved = update(undone_twice, InputEvent::ARROW_RIGHT);
+    auto back = update(moved, InputEvent::PREV_UNDECIDED);
+    EXPECT_EQ(back.current_index, 0);
+    
+    auto redone = update(undone_twice, InputEvent::REDO);
+    EXPECT_EQ(redone.current_style(), NolintStyle::NOLINT);
+    
+    UIModel fresh;
+    fresh.warnings = model.warnings;
+    fresh = apply_filter(fresh, "");
+    auto nothing = update(fresh, InputEvent::UNDO);
+    EXPECT_FALSE(nothing.status_message.empty());
+}
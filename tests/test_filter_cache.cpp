@@ -0,0 +1,86 @@
+#include "../include/filter_cache.hpp"
+#include <gtest/gtest.h>
+
+using namespace nolint;
+
+namespace {
+
+auto store(FilterCache& cache, const std::string& key, std::vector<size_t> indices) -> void {
+    store_filter(cache, FilterCacheEntry{
+                            .key = key,
+                            .indices = std::make_shared<const std::vector<size_t>>(indices),
+                            .runs = std::make_shared<const RunIndex>(),
+                            .locations = std::make_shared<const LocationIndex>(),
+                            .current_index = 0,
+                            .last_used = 0,
+                            .decided = {},
+                            .decisions_version = 0});
+}
+
+} // namespace
+
+TEST(FilterCacheTest, NormalizeIsCaseInsensitive) {
+    EXPECT_EQ(normalize_filter_key("Readability-MAGIC"), "readability-magic");
+}
+
+TEST(FilterCacheTest, LookupHitAndMiss) {
+    FilterCache cache;
+    store(cache, "type1", {1, 2, 3});
+    
+    auto* hit = lookup_filter(cache, "type1");
+    ASSERT_NE(hit, nullptr);
+    EXPECT_EQ(*hit->indices, (std::vector<size_t>{1, 2, 3}));
+    
+    EXPECT_EQ(lookup_filter(cache, "type2"), nullptr);
+}
+
+TEST(FilterCacheTest, EvictsLeastRecentlyUsed) {
+    FilterCache cache;
+    cache.capacity = 2;
+    
+    store(cache, "a", {1});
+    store(cache, "b", {2});
+    lookup_filter(cache, "a");       // "b" is now least recently used
+    store(cache, "c", {3});
+    
+    EXPECT_NE(lookup_filter(cache, "a"), nullptr);
+    EXPECT_EQ(lookup_filter(cache, "b"), nullptr);
+    EXPECT_NE(lookup_filter(cache, "c"), nullptr);
+    EXPECT_EQ(cache.entries.size(), 2);
+}
+
+TEST(FilterCacheTest, RememberPositionOnlyUpdatesCachedFilters) {
+    FilterCache cache;
+    store(cache, "a", {1, 2, 3});
+    
+    remember_filter_position(cache, "a", 2);
+    remember_filter_position(cache, "missing", 5);
+    
+    EXPECT_EQ(lookup_filter(cache, "a")->current_index, 2);
+    EXPECT_EQ(cache.entries.size(), 1);
+}
+
+TEST(FilterCacheTest, InvalidateOnWarningSetChange) {
+    FilterCache cache;
+    invalidate_filter_cache(cache, 10);
+    store(cache, "a", {1});
+    
+    invalidate_filter_cache(cache, 10);  // Same warning set - keep entries
+    EXPECT_EQ(cache.entries.size(), 1);
+    
+    invalidate_filter_cache(cache, 11);
+    EXPECT_TRUE(cache.entries.empty());
+}
+
+TEST(FilterCacheTest, ForgetLocationsKeepsResults) {
+    FilterCache cache;
+    store(cache, "a", {1, 2});
+    
+    forget_filter_locations(cache);
+    
+    auto* entry = lookup_filter(cache, "a");
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(entry->locations, nullptr);
+    EXPECT_NE(entry->runs, nullptr);
+    EXPECT_EQ(entry->indices->size(), 2);
+}
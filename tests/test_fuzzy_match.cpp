@@ -0,0 +1,103 @@
+#include "../include/fuzzy_match.hpp"
+#include <gtest/gtest.h>
+
+using namespace nolint;
+
+TEST(FuzzyMatchTest, RequiresSubsequence) {
+    EXPECT_TRUE(fuzzy_score("readability-magic-numbers", "rdmg").has_value());
+    EXPECT_FALSE(fuzzy_score("readability-magic-numbers", "mgrd").has_value());
+    EXPECT_FALSE(fuzzy_score("", "a").has_value());
+    EXPECT_EQ(fuzzy_score("anything", ""), 0);
+}
+
+TEST(FuzzyMatchTest, CaseInsensitive) {
+    EXPECT_TRUE(fuzzy_score("src/MyWidget.cpp", "mywidget").has_value());
+}
+
+TEST(FuzzyMatchTest, PrefersBoundaryAndConsecutiveMatches) {
+    // Same letters, but "mn" at word starts beats "mn" buried in a word
+    auto boundary = fuzzy_score("magic-numbers", "mn");
+    auto buried = fuzzy_score("xmxxnx", "mn");
+    ASSERT_TRUE(boundary && buried);
+    EXPECT_GT(*boundary, *buried);
+    
+    auto consecutive = fuzzy_score("xmagicx", "magic");
+    auto spread = fuzzy_score("xmxaxgxixcx", "magic");
+    ASSERT_TRUE(consecutive && spread);
+    EXPECT_GT(*consecutive, *spread);
+}
+
+TEST(FuzzyMatchTest, CamelCaseBonus) {
+    auto camel = fuzzy_score("getValue", "gv");
+    auto plain = fuzzy_score("getvalue", "gv");
+    ASSERT_TRUE(camel && plain);
+    EXPECT_GT(*camel, *plain);
+}
+
+TEST(FuzzyMatchTest, IsFuzzyQuery) {
+    EXPECT_TRUE(is_fuzzy_query("~abc"));
+    EXPECT_FALSE(is_fuzzy_query("abc"));
+    EXPECT_FALSE(is_fuzzy_query(""));
+}
+
+TEST(FuzzyMatchTest, FilterRanksBestMatchFirst) {
+    std::vector<Warning> warnings = {
+        {"src/a.cpp", 1, 1, "bugprone-x", "m", std::nullopt},
+        {"src/b.cpp", 1, 1, "readability-x", "mostly a giant cost", std::nullopt},
+        {"src/c.cpp", 1, 1, "readability-magic-numbers", "m", std::nullopt}
+    };
+    
+    auto ranked = fuzzy_filter_warnings(build_warning_table(warnings), "readmagic");
+    
+    ASSERT_EQ(ranked.size(), 2);
+    EXPECT_EQ(ranked[0], 2);
+    EXPECT_EQ(ranked[1], 1);
+}
+
+TEST(FuzzyMatchTest, UnrankedTailKeepsWarningOrder) {
+    std::vector<Warning> warnings;
+    for (int i = 0; i < 20; ++i) {
+        warnings.push_back({"src/file.cpp", i + 1, 1, "type", "message", std::nullopt});
+    }
+    warnings.push_back({"src/file.cpp", 99, 1, "type", "TYPE exact", std::nullopt});
+    
+    auto ranked = fuzzy_filter_warnings(build_warning_table(warnings), "type exact", 1);
+    
+    ASSERT_EQ(ranked.size(), 1);
+    EXPECT_EQ(ranked[0], 20);
+    
+    auto all = fuzzy_filter_warnings(build_warning_table(warnings), "tp", 3);
+    ASSERT_EQ(all.size(), 21);
+    EXPECT_TRUE(std::is_sorted(all.begin() + 3, all.end()));
+}
+
+TEST(FuzzyMatchTest, TopMatchesAgreeWithRankedFilter) {
+    std::vector<Warning> warnings;
+    for (int i = 0; i < 20; ++i) {
+        warnings.push_back({"src/file.cpp", i + 1, 1, "type", "message", std::nullopt});
+    }
+    warnings.push_back({"src/file.cpp", 99, 1, "type", "TYPE exact", std::nullopt});
+    warnings.push_back({"src/other.cpp", 1, 1, "bugprone-x", "m", std::nullopt});
+    
+    auto preview = fuzzy_top_matches(build_warning_table(warnings), "tp", 3);
+    auto ranked = fuzzy_filter_warnings(build_warning_table(warnings), "tp", 3);
+    
+    EXPECT_EQ(preview.match_count, ranked.size());
+    EXPECT_EQ(preview.top, (std::vector<size_t>(ranked.begin(), ranked.begin() + 3)));
+    
+    auto none = fuzzy_top_matches(build_warning_table(warnings), "zzz", 3);
+    EXPECT_EQ(none.match_count, 0);
+    EXPECT_TRUE(none.top.empty());
+}
+
+TEST(FuzzyMatchTest, ApplyFilterUsesFuzzyPrefix) {
+    UIModel model;
+    model.warnings = {
+        {"src/a.cpp", 1, 1, "bugprone-x", "m", std::nullopt},
+        {"src/widget.cpp", 1, 1, "readability-x", "m", std::nullopt}
+    };
+    
+    auto filtered = apply_filter(model, "~wdgt");
+    
+    EXPECT_EQ(*filtered.filtered_warning_indices, (std::vector<size_t>{1}));
+}
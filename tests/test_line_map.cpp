@@ -0,0 +1,50 @@
+#include "../include/line_map.hpp"
+#include <gtest/gtest.h>
+
+using namespace nolint;
+
+TEST(LineMapTest, UnchangedFileIsIdentity) {
+    std::vector<std::string> lines = {"a", "b", "c"};
+    
+    auto map = map_lines(lines, lines);
+    
+    EXPECT_TRUE(is_identity(map));
+    EXPECT_EQ(map.changed_lines, 0);
+}
+
+TEST(LineMapTest, InsertionsAndDeletionsShiftFollowingLines) {
+    auto map = map_lines({"a", "b", "c", "d", "e"}, {"new", "a", "c", "d", "more", "e"});
+    
+    EXPECT_EQ(remap_line(map, 1), 2);
+    EXPECT_EQ(remap_line(map, 2), 3);  // Deleted: lands on the next surviving line
+    EXPECT_EQ(remap_line(map, 3), 3);
+    EXPECT_EQ(remap_line(map, 4), 4);
+    EXPECT_EQ(remap_line(map, 5), 6);
+    EXPECT_EQ(remap_line(map, 9), 10);  // Past the old end: shifted by the size change
+    EXPECT_EQ(map.changed_lines, 1);
+}
+
+TEST(LineMapTest, RewrittenLinesMapOntoTheirReplacements) {
+    auto map = map_lines({"a", "old1", "old2", "old3", "z"}, {"a", "new1", "new2", "z"});
+    
+    EXPECT_EQ(remap_line(map, 2), 2);
+    EXPECT_EQ(remap_line(map, 3), 3);
+    EXPECT_EQ(remap_line(map, 4), 3);  // More removed than inserted: stays on the last
+    EXPECT_EQ(remap_line(map, 5), 4);
+    EXPECT_EQ(map.changed_lines, 3);
+}
+
+TEST(LineMapTest, LargeRewriteFallsBackToProportionalMapping) {
+    std::vector<std::string> old_lines;
+    std::vector<std::string> new_lines;
+    for (size_t i = 0; i < MAX_DIFF_EDITS; ++i) {
+        old_lines.push_back("old" + std::to_string(i));
+        new_lines.push_back("new" + std::to_string(i));
+    }
+    
+    auto map = map_lines(old_lines, new_lines);
+    
+    EXPECT_EQ(remap_line(map, 1), 1);
+    EXPECT_EQ(remap_line(map, 100), 100);
+    EXPECT_EQ(map.changed_lines, MAX_DIFF_EDITS);
+}
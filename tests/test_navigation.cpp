@@ -0,0 +1,168 @@
+#include "../include/navigation.hpp"
+#include "../include/ui_model.hpp"
+#include <gtest/gtest.h>
+
+using namespace nolint;
+
+TEST(NavigationTest, EmptyBitsetHasNoClearBits) {
+    auto bits = make_position_bitset(0);
+    
+    EXPECT_FALSE(find_next_clear(bits, 0).has_value());
+    EXPECT_FALSE(find_prev_clear(bits, 0).has_value());
+}
+
+TEST(NavigationTest, SetAndTestPositions) {
+    auto bits = make_position_bitset(130);
+    
+    set_position(bits, 0, true);
+    set_position(bits, 64, true);
+    set_position(bits, 129, true);
+    set_position(bits, 500, true);  // Out of range - ignored
+    
+    EXPECT_TRUE(test_position(bits, 0));
+    EXPECT_TRUE(test_position(bits, 64));
+    EXPECT_TRUE(test_position(bits, 129));
+    EXPECT_FALSE(test_position(bits, 1));
+    EXPECT_FALSE(test_position(bits, 500));
+    
+    set_position(bits, 64, false);
+    EXPECT_FALSE(test_position(bits, 64));
+}
+
+TEST(NavigationTest, FindNextClearSkipsFullWords) {
+    auto bits = make_position_bitset(200);
+    for (size_t i = 0; i < 150; ++i) {
+        set_position(bits, i, true);
+    }
+    
+    EXPECT_EQ(find_next_clear(bits, 0), 150);
+    EXPECT_EQ(find_next_clear(bits, 170), 170);
+}
+
+TEST(NavigationTest, FindNextClearIgnoresPaddingBits) {
+    auto bits = make_position_bitset(70);
+    for (size_t i = 10; i < 70; ++i) {
+        set_position(bits, i, true);
+    }
+    
+    // Bits 70..127 are padding in the last word and must not be reported
+    EXPECT_FALSE(find_next_clear(bits, 10).has_value());
+    EXPECT_FALSE(find_next_clear(bits, 70).has_value());
+}
+
+TEST(NavigationTest, FindPrevClearSkipsFullWords) {
+    auto bits = make_position_bitset(200);
+    for (size_t i = 5; i < 200; ++i) {
+        set_position(bits, i, true);
+    }
+    
+    EXPECT_EQ(find_prev_clear(bits, 199), 4);
+    EXPECT_EQ(find_prev_clear(bits, 63), 4);
+    EXPECT_EQ(find_prev_clear(bits, 2), 2);
+}
+
+TEST(NavigationTest, FindPrevClearAllSet) {
+    auto bits = make_position_bitset(64);
+    for (size_t i = 0; i < 64; ++i) {
+        set_position(bits, i, true);
+    }
+    
+    EXPECT_FALSE(find_prev_clear(bits, 63).has_value());
+    EXPECT_FALSE(find_prev_clear(bits, 1000).has_value());
+}
+
+TEST(NavigationTest, FindNextRunStart) {
+    std::vector<size_t> run_starts = {0, 3, 7};
+    
+    EXPECT_EQ(find_next_run_start(run_starts, 0), 3);
+    EXPECT_EQ(find_next_run_start(run_starts, 4), 7);
+    EXPECT_FALSE(find_next_run_start(run_starts, 7).has_value());
+}
+
+TEST(NavigationTest, FindPrevRunStart) {
+    std::vector<size_t> run_starts = {0, 3, 7};
+    
+    EXPECT_EQ(find_prev_run_start(run_starts, 5), 3);  // Inside a run - go to its start
+    EXPECT_EQ(find_prev_run_start(run_starts, 3), 0);  // At a run start - go to previous run
+    EXPECT_FALSE(find_prev_run_start(run_starts, 0).has_value());
+}
+
+TEST(NavigationTest, ParseGotoWarningNumber) {
+    auto colon = parse_goto_command(":1234");
+    ASSERT_TRUE(colon.has_value());
+    EXPECT_EQ(colon->warning_number, 1234);
+    
+    auto bare = parse_goto_command(" 42 ");
+    ASSERT_TRUE(bare.has_value());
+    EXPECT_EQ(bare->warning_number, 42);
+}
+
+TEST(NavigationTest, ParseGotoLocation) {
+    auto with_line = parse_goto_command("src/file.cpp:42");
+    ASSERT_TRUE(with_line.has_value());
+    EXPECT_FALSE(with_line->warning_number.has_value());
+    EXPECT_EQ(with_line->file_path, "src/file.cpp");
+    EXPECT_EQ(with_line->line, 42);
+    
+    auto with_column = parse_goto_command("src/file.cpp:42:7");
+    ASSERT_TRUE(with_column.has_value());
+    EXPECT_EQ(with_column->file_path, "src/file.cpp");
+    EXPECT_EQ(with_column->line, 42);
+    
+    auto path_only = parse_goto_command("src/file.cpp");
+    ASSERT_TRUE(path_only.has_value());
+    EXPECT_EQ(path_only->file_path, "src/file.cpp");
+    EXPECT_EQ(path_only->line, 0);
+    
+    EXPECT_FALSE(parse_goto_command("   ").has_value());
+}
+
+TEST(NavigationTest, ParseGotoRejectsOutOfRangeNumbers) {
+    EXPECT_FALSE(parse_goto_command(":99999999999999999999").has_value());
+    EXPECT_FALSE(parse_goto_command("a.cpp:99999999999").has_value());
+    EXPECT_FALSE(parse_goto_command("a.cpp:1:99999999999").has_value());
+}
+
+TEST(NavigationTest, FindNearestLine) {
+    std::vector<LineEntry> lines = {{10, 0}, {20, 1}, {40, 2}};
+    
+    EXPECT_EQ(find_nearest_line(lines, 1), 0);
+    EXPECT_EQ(find_nearest_line(lines, 20), 1);
+    EXPECT_EQ(find_nearest_line(lines, 24), 1);
+    EXPECT_EQ(find_nearest_line(lines, 30), 2);  // Tie prefers the later warning
+    EXPECT_EQ(find_nearest_line(lines, 100), 2);
+    EXPECT_FALSE(find_nearest_line({}, 10).has_value());
+}
+
+TEST(NavigationTest, FindFileLinesBySuffix) {
+    LocationIndex index;
+    index.lines_by_file["/work/project/src/file.cpp"] = {{10, 0}};
+    index.lines_by_file["src/other.cpp"] = {{5, 1}};
+    
+    EXPECT_NE(find_file_lines(index, "/work/project/src/file.cpp"), nullptr);
+    EXPECT_NE(find_file_lines(index, "src/file.cpp"), nullptr);
+    EXPECT_NE(find_file_lines(index, "/ci/checkout/src/other.cpp"), nullptr);
+    EXPECT_EQ(find_file_lines(index, "ile.cpp"), nullptr);  // Not a path component
+}
+
+TEST(NavigationTest, WarningsInLinesIsPerFileRangeQuery) {
+    auto table = build_warning_table({
+        {"a.cpp", 30, 1, "t", "m", std::nullopt},
+        {"b.cpp", 12, 1, "t", "m", std::nullopt},
+        {"a.cpp", 10, 1, "t", "m", std::nullopt},
+        {"a.cpp", 12, 1, "t", "m", std::nullopt},
+        {"a.cpp", 12, 5, "t", "m", std::nullopt}
+    });
+    auto index = build_file_line_index(table);
+    auto a_id = *find_interned(table.paths, "a.cpp");
+    
+    auto window = warnings_in_lines(index, a_id, 9, 13);
+    
+    ASSERT_EQ(window.size(), 3);
+    EXPECT_EQ(window[0].warning_index, 2);
+    EXPECT_EQ(window[1].warning_index, 3);  // Same line keeps warning order
+    EXPECT_EQ(window[2].warning_index, 4);
+    EXPECT_TRUE(warnings_in_lines(index, a_id, 13, 29).empty());
+    EXPECT_EQ(warnings_in_lines(index, a_id, 30, 30).size(), 1);
+    EXPECT_TRUE(warnings_in_lines(index, 99, 1, 100).empty());
+}
@@ -0,0 +1,73 @@
+#include "../include/path_resolver.hpp"
+#include "../include/warning_parser.hpp"
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+
+using namespace nolint;
+
+class PathResolverTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        std::filesystem::create_directories(root_ + "/src");
+        std::filesystem::create_directories(root_ + "/build");
+        std::ofstream(root_ + "/src/x.cpp") << "int x;\n";
+        std::filesystem::create_directory_symlink("src", root_ + "/linked");
+    }
+    
+    void TearDown() override {
+        std::filesystem::remove_all(root_);
+    }
+    
+    const std::string root_ = "test_path_resolver_tree";
+};
+
+TEST_F(PathResolverTest, SpellingsOfOneFileShareAnId) {
+    PathResolver resolver;
+    
+    auto id = resolver.file_id(root_ + "/src/x.cpp");
+    
+    EXPECT_EQ(resolver.file_id(root_ + "/build/../src/x.cpp"), id);
+    EXPECT_EQ(resolver.file_id(root_ + "/linked/x.cpp"), id);
+    EXPECT_EQ(resolver.file_id(std::filesystem::absolute(root_ + "/src/x.cpp").string()), id);
+    EXPECT_EQ(resolver.file_count(), 1);
+    EXPECT_EQ(resolver.canonical_path(id), root_ + "/src/x.cpp");  // Relative to the cwd
+}
+
+TEST_F(PathResolverTest, RelativeSpellingsResolveAgainstBuildDirectory) {
+    PathResolver resolver(root_ + "/build");
+    
+    auto id = resolver.file_id("../src/x.cpp");
+    
+    auto absolute = std::filesystem::absolute(root_ + "/src/x.cpp").string();
+    EXPECT_EQ(resolver.file_id(absolute), id);  // Absolute spellings are unaffected
+    EXPECT_EQ(resolver.canonical_path(id), root_ + "/src/x.cpp");
+    EXPECT_EQ(resolver.resolve("../src/missing.cpp"), root_ + "/src/missing.cpp");
+}
+
+TEST_F(PathResolverTest, RepeatedAndMissingSpellingsAreMemoized) {
+    PathResolver resolver;
+    
+    resolver.file_id(root_ + "/src/x.cpp");
+    auto missing = resolver.file_id(root_ + "/src/../src/gone.cpp");
+    resolver.file_id(root_ + "/src/x.cpp");
+    resolver.file_id(root_ + "/src/../src/gone.cpp");
+    
+    EXPECT_EQ(resolver.stat_calls(), 2);
+    EXPECT_EQ(resolver.canonical_path(missing), root_ + "/src/gone.cpp");
+    EXPECT_EQ(resolver.file_count(), 2);
+}
+
+TEST_F(PathResolverTest, ParserCanonicalizesAtIngest) {
+    PathResolver resolver;
+    WarningParser parser;
+    parser.set_path_resolver(&resolver);
+    std::string input = root_ + "/build/../src/x.cpp:1:5: warning: a [type1]\n"
+                        + root_ + "/linked/x.cpp:1:5: warning: b [type2]\n";
+    
+    auto warnings = parser.parse(input);
+    
+    ASSERT_EQ(warnings.size(), 2);
+    EXPECT_EQ(warnings[0].file_path, root_ + "/src/x.cpp");
+    EXPECT_EQ(warnings[1].file_path, root_ + "/src/x.cpp");
+}
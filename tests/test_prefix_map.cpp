@@ -0,0 +1,50 @@
+#include "../include/prefix_map.hpp"
+#include "../include/warning_parser.hpp"
+#include <gtest/gtest.h>
+
+using namespace nolint;
+
+TEST(PrefixMapTest, ParsesRules) {
+    auto rule = parse_prefix_rule("/work/src=/home/me/repo");
+    
+    ASSERT_TRUE(rule.has_value());
+    EXPECT_EQ(rule->first, "/work/src");
+    EXPECT_EQ(rule->second, "/home/me/repo");
+    EXPECT_FALSE(parse_prefix_rule("/work/src").has_value());
+    EXPECT_FALSE(parse_prefix_rule("=/home/me/repo").has_value());
+}
+
+TEST(PrefixMapTest, LongestPrefixOnComponentBoundaryWins) {
+    PrefixMap map;
+    add_prefix_rule(map, "/work", "/mnt/work");
+    add_prefix_rule(map, "/work/src", "/home/me/repo");
+    
+    EXPECT_EQ(map_prefix(map, "/work/src/a.cpp"), "/home/me/repo/a.cpp");
+    EXPECT_EQ(map_prefix(map, "/work/srcs/a.cpp"), "/mnt/work/srcs/a.cpp");
+    EXPECT_EQ(map_prefix(map, "/work/src"), "/home/me/repo");
+    EXPECT_FALSE(map_prefix(map, "/workspace/a.cpp").has_value());
+    EXPECT_FALSE(map_prefix(map, "src/a.cpp").has_value());
+}
+
+TEST(PrefixMapTest, LaterRuleReplacesSameFrom) {
+    PrefixMap map;
+    add_prefix_rule(map, "/work/", "/old/");
+    add_prefix_rule(map, "/work/", "/new/");
+    
+    EXPECT_EQ(map_prefix(map, "/work/a.cpp"), "/new/a.cpp");
+    EXPECT_EQ(map.replacements.size(), 1);
+}
+
+TEST(PrefixMapTest, ParserRemapsPathsAtIngest) {
+    PrefixMap map;
+    add_prefix_rule(map, "/work/src", "repo");
+    WarningParser parser;
+    parser.set_prefix_map(&map);
+    
+    auto warnings = parser.parse("/work/src/a.cpp:3:1: warning: m [type1]\n"
+                                 "/other/b.cpp:4:1: warning: m [type1]\n");
+    
+    ASSERT_EQ(warnings.size(), 2);
+    EXPECT_EQ(warnings[0].file_path, "repo/a.cpp");
+    EXPECT_EQ(warnings[1].file_path, "/other/b.cpp");
+}
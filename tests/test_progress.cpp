@@ -0,0 +1,90 @@
+#include "../include/progress.hpp"
+#include "../include/warning_parser.hpp"
+#include <gtest/gtest.h>
+#include <sstream>
+
+using namespace nolint;
+
+TEST(ProgressTest, PercentPrefersBytes) {
+    ProgressSnapshot snapshot{.bytes_done = 25, .bytes_total = 100, .files_done = 1,
+                              .files_total = 2, .elapsed_seconds = 1.0};
+    EXPECT_DOUBLE_EQ(progress_percent(snapshot), 25.0);
+    
+    snapshot.bytes_total = 0;
+    EXPECT_DOUBLE_EQ(progress_percent(snapshot), 50.0);
+    
+    snapshot.files_total = 0;
+    EXPECT_LT(progress_percent(snapshot), 0.0);  // Unknown total
+}
+
+TEST(ProgressTest, EtaFromRate) {
+    ProgressSnapshot snapshot{.bytes_done = 25, .bytes_total = 100, .elapsed_seconds = 2.0};
+    
+    EXPECT_DOUBLE_EQ(progress_eta_seconds(snapshot), 6.0);
+    
+    snapshot.bytes_total = 0;
+    EXPECT_LT(progress_eta_seconds(snapshot), 0.0);
+}
+
+TEST(ProgressTest, FormatLine) {
+    ProgressSnapshot snapshot{.bytes_done = 2 * 1024 * 1024, .bytes_total = 4 * 1024 * 1024,
+                              .warnings_done = 100, .elapsed_seconds = 1.0};
+    
+    auto line = format_progress_line("parse", snapshot);
+    
+    EXPECT_NE(line.find("parse"), std::string::npos);
+    EXPECT_NE(line.find("50.0%"), std::string::npos);
+    EXPECT_NE(line.find("2.0 MB/s"), std::string::npos);
+    EXPECT_NE(line.find("100 warnings (100/s)"), std::string::npos);
+    EXPECT_NE(line.find("ETA 1s"), std::string::npos);
+}
+
+TEST(ProgressTest, FormatJson) {
+    ProgressSnapshot snapshot{.files_done = 3, .files_total = 4, .elapsed_seconds = 1.0};
+    
+    auto json = format_progress_json("save", snapshot, true);
+    
+    EXPECT_EQ(json.front(), '{');
+    EXPECT_EQ(json.back(), '}');
+    EXPECT_NE(json.find(R"("event":"done")"), std::string::npos);
+    EXPECT_NE(json.find(R"("phase":"save")"), std::string::npos);
+    EXPECT_NE(json.find(R"("files":3)"), std::string::npos);
+    EXPECT_NE(json.find(R"("percent":75.000)"), std::string::npos);
+}
+
+TEST(ProgressTest, ParseFormat) {
+    EXPECT_EQ(parse_progress_format("line"), ProgressFormat::LINE);
+    EXPECT_EQ(parse_progress_format("json"), ProgressFormat::JSON);
+    EXPECT_EQ(parse_progress_format("none"), ProgressFormat::NONE);
+    EXPECT_EQ(parse_progress_format("bogus"), std::nullopt);
+    EXPECT_EQ(parse_progress_format("jsn"), std::nullopt);
+    EXPECT_EQ(parse_progress_format(""), std::nullopt);
+}
+
+TEST(ProgressTest, ReporterWritesFinalJsonEvent) {
+    ProgressCounters counters;
+    std::ostringstream output;
+    {
+        ProgressReporter reporter("parse", counters, ProgressFormat::JSON, output);
+        counters.warnings_done = 7;
+    }
+    
+    EXPECT_NE(output.str().find(R"("event":"done")"), std::string::npos);
+    EXPECT_NE(output.str().find(R"("warnings":7)"), std::string::npos);
+}
+
+TEST(ProgressTest, ParserReportsProgress) {
+    std::string input =
+        "file1.cpp:1:1: warning: message1 [type1]\n"
+        "noise\n"
+        "file2.cpp:2:2: warning: message2 [type2]\n";
+    ProgressCounters counters;
+    WarningParser parser;
+    parser.set_progress(&counters);
+    
+    auto warnings = parser.parse(input);
+    
+    EXPECT_EQ(warnings.size(), 2);
+    EXPECT_EQ(counters.warnings_done, 2);
+    EXPECT_EQ(counters.bytes_done, input.size());
+}
@@ -0,0 +1,181 @@
+#include "../include/shard.hpp"
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <set>
+#include <sstream>
+
+using namespace nolint;
+
+namespace {
+
+auto make_warning(const std::string& path, int line) -> Warning {
+    return Warning{path, line, 1, "readability-magic-numbers", "magic", std::nullopt};
+}
+
+} // namespace
+
+TEST(ShardTest, ParsesSpecs) {
+    auto shard = parse_shard_spec("2/4");
+    
+    ASSERT_TRUE(shard.has_value());
+    EXPECT_EQ(shard->index, 1);
+    EXPECT_EQ(shard->count, 4);
+    EXPECT_EQ(format_shard_spec(*shard), "2/4");
+    EXPECT_FALSE(parse_shard_spec("0/4").has_value());
+    EXPECT_FALSE(parse_shard_spec("5/4").has_value());
+    EXPECT_FALSE(parse_shard_spec("1/").has_value());
+    EXPECT_FALSE(parse_shard_spec("1/4x").has_value());
+    EXPECT_FALSE(parse_shard_spec("4").has_value());
+}
+
+TEST(ShardTest, ShardsPartitionWholeFiles) {
+    std::vector<Warning> warnings;
+    for (int file = 0; file < 50; ++file) {
+        for (int line = 1; line <= 3; ++line) {
+            warnings.push_back(make_warning("src/file" + std::to_string(file) + ".cpp", line));
+        }
+    }
+    
+    size_t total = 0;
+    std::set<std::string> seen;
+    for (std::uint32_t index = 0; index < 4; ++index) {
+        auto selected = select_shard(warnings, ShardSpec{.index = index, .count = 4}, "/repo");
+        total += selected.size();
+        std::set<std::string> files;
+        for (const auto& warning : selected) {
+            files.insert(warning.file_path);
+        }
+        for (const auto& file : files) {
+            EXPECT_TRUE(seen.insert(file).second) << file << " is in two shards";
+        }
+    }
+    
+    EXPECT_EQ(total, warnings.size());
+    EXPECT_EQ(seen.size(), 50);
+}
+
+TEST(ShardTest, AssignmentIsStable) {
+    // Pinned so that every machine, build and run agrees on the owner of a file
+    EXPECT_EQ(shard_of_path("src/main.cpp", 7), shard_of_path("src/main.cpp", 7));
+    EXPECT_EQ(shard_of_path("src/main.cpp", 1), 0);
+    EXPECT_EQ(shard_of_path("", 1000), 14695981039346656037ULL % 1000);
+}
+
+TEST(ShardTest, PathsHashRelativeToTheRoot) {
+    EXPECT_EQ(shard_relative_path("/home/a/repo/src/x.cpp", "/home/a/repo"), "src/x.cpp");
+    EXPECT_EQ(shard_relative_path("/home/a/repo/./src/../src/x.cpp", "/home/a/repo/"),
+              "src/x.cpp");
+    EXPECT_EQ(shard_relative_path("/usr/include/vector", "/home/a/repo"), "/usr/include/vector");
+    auto cwd = std::filesystem::current_path();
+    EXPECT_EQ(shard_relative_path("src/x.cpp", cwd), "src/x.cpp");
+    
+    // Two checkouts in different places pick the same files
+    std::vector<Warning> first;
+    std::vector<Warning> second;
+    for (int file = 0; file < 20; ++file) {
+        auto name = "src/file" + std::to_string(file) + ".cpp";
+        first.push_back(make_warning("/home/a/repo/" + name, 1));
+        second.push_back(make_warning("/build/work/" + name, 1));
+    }
+    ShardSpec shard{.index = 1, .count = 3};
+    auto from_first = select_shard(first, shard, "/home/a/repo");
+    auto from_second = select_shard(second, shard, "/build/work");
+    
+    ASSERT_EQ(from_first.size(), from_second.size());
+    for (size_t i = 0; i < from_first.size(); ++i) {
+        EXPECT_EQ(shard_relative_path(from_first[i].file_path, "/home/a/repo"),
+                  shard_relative_path(from_second[i].file_path, "/build/work"));
+    }
+}
+
+TEST(ShardTest, FindsRepositoryRoot) {
+    auto root = std::filesystem::absolute("test_shard_root");
+    std::filesystem::create_directories(root / ".git");
+    std::filesystem::create_directories(root / "src" / "deep");
+    
+    EXPECT_EQ(find_repository_root(root / "src" / "deep"), root);
+    EXPECT_EQ(find_repository_root(root), root);
+    
+    std::filesystem::remove_all(root);
+}
+
+TEST(ShardTest, ResultRoundTrips) {
+    ShardResult result{.shard = {.index = 2, .count = 3},
+                       .warnings = 5,
+                       .files = {{.path = "src/a \"q\".cpp", .modified = true, .suppressions = 3},
+                                 {.path = "src/b.cpp", .modified = false, .suppressions = 2}}};
+    
+    std::istringstream in(format_shard_result(result));
+    auto parsed = parse_shard_result(in);
+    
+    ASSERT_TRUE(parsed.has_value());
+    EXPECT_EQ(format_shard_spec(parsed->shard), "3/3");
+    EXPECT_EQ(parsed->warnings, 5);
+    ASSERT_EQ(parsed->files.size(), 2);
+    EXPECT_EQ(parsed->files[0].path, "src/a \"q\".cpp");
+    EXPECT_TRUE(parsed->files[0].modified);
+    EXPECT_EQ(parsed->files[0].suppressions, 3);
+    EXPECT_FALSE(parsed->files[1].modified);
+}
+
+TEST(ShardTest, ControlCharactersRoundTripAndBadEscapesAreRejected) {
+    ShardResult result{.shard = {.index = 0, .count = 1},
+                       .warnings = 1,
+                       .files = {{.path = "odd\tname.cpp", .modified = true, .suppressions = 1}}};
+    auto text = format_shard_result(result);
+    std::istringstream in(text);
+    
+    auto parsed = parse_shard_result(in);
+    ASSERT_TRUE(parsed.has_value());
+    EXPECT_EQ(parsed->files[0].path, "odd\tname.cpp");
+    
+    for (const auto* bad : {"\\u00zz", "\\u0", "\\u-001"}) {
+        auto broken = text;
+        broken.replace(broken.find("\\u0009"), 6, bad);
+        std::istringstream broken_in(broken);
+        EXPECT_FALSE(parse_shard_result(broken_in).has_value()) << bad;
+    }
+}
+
+TEST(ShardTest, ResultWithoutSummaryIsRejected) {
+    std::istringstream truncated(
+        R"({"event":"file","shard":"1/2","path":"a.cpp","status":"modified","suppressions":1})");
+    
+    EXPECT_FALSE(parse_shard_result(truncated).has_value());
+}
+
+TEST(ShardTest, MergeSortsFilesAndReportsGaps) {
+    ShardResult first{.shard = {.index = 0, .count = 3},
+                      .warnings = 2,
+                      .files = {{.path = "src/z.cpp", .modified = true, .suppressions = 2}}};
+    ShardResult third{.shard = {.index = 2, .count = 3},
+                      .warnings = 4,
+                      .files = {{.path = "src/a.cpp", .modified = true, .suppressions = 1},
+                                {.path = "src/z.cpp", .modified = true, .suppressions = 3}}};
+    
+    auto merged = merge_shard_results({first, third, first});
+    
+    EXPECT_EQ(merged.shard_count, 3);
+    EXPECT_EQ(merged.warnings, 8);
+    ASSERT_EQ(merged.missing_shards.size(), 1);
+    EXPECT_EQ(merged.missing_shards[0], 1);
+    ASSERT_EQ(merged.duplicate_shards.size(), 1);
+    EXPECT_EQ(merged.duplicate_shards[0], 0);
+    ASSERT_EQ(merged.conflicts.size(), 1);
+    EXPECT_EQ(merged.conflicts[0], "src/z.cpp");
+    EXPECT_EQ(merged.files.front().path, "src/a.cpp");
+    EXPECT_NE(format_merged_shards(merged).find(R"("missing":[2])"), std::string::npos);
+}
+
+TEST(ShardTest, MergeReportsMismatchedShardCounts) {
+    ShardResult quarter{.shard = {.index = 0, .count = 4}, .warnings = 1, .files = {}};
+    ShardResult eighth{.shard = {.index = 1, .count = 8}, .warnings = 1, .files = {}};
+    
+    auto merged = merge_shard_results({quarter, eighth, eighth});
+    
+    EXPECT_EQ(merged.shard_count, 4);
+    EXPECT_EQ(merged.mismatched_counts, (std::vector<std::uint32_t>{8}));
+    EXPECT_EQ(merged.missing_shards, (std::vector<std::uint32_t>{1, 2, 3}));
+    EXPECT_TRUE(merged.duplicate_shards.empty());
+    EXPECT_NE(format_merged_shards(merged).find(R"("mismatched_counts":[8])"), std::string::npos);
+}
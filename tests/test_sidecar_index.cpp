@@ -0,0 +1,118 @@
+#include "../include/sidecar_index.hpp"
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+
+using namespace nolint;
+
+class SidecarIndexTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        write_source("/* open\n   close */ int x = 1;\nauto s = R\"d(raw\n");
+    }
+    
+    void TearDown() override {
+        std::filesystem::remove(source_);
+        std::filesystem::remove_all(directory_);
+    }
+    
+    void write_source(const std::string& text) {
+        std::ofstream file(source_, std::ios::trunc);
+        file << text;
+    }
+    
+    const std::string source_ = "test_sidecar_source.cpp";
+    const std::string directory_ = "test_sidecar_dir";
+};
+
+TEST_F(SidecarIndexTest, LaterSessionAdoptsLexedPrefix) {
+    std::vector<std::vector<TokenSpan>> first_tokens;
+    {
+        SourceCache cache(0, directory_);
+        auto file = cache.get(source_);
+        ensure_lexed(*file, 3);
+        first_tokens = file->tokens;
+    }  // Written back on destruction
+    ASSERT_TRUE(std::filesystem::exists(sidecar_path(directory_, source_)));
+    
+    SourceCache cache(0, directory_);
+    auto file = cache.get(source_);
+    
+    ASSERT_NE(file, nullptr);
+    EXPECT_EQ(cache.stats().sidecar_loads, 1);
+    EXPECT_EQ(file->lines.size(), 3);
+    EXPECT_EQ(file->lines[1], "   close */ int x = 1;");
+    ASSERT_EQ(file->tokens.size(), 3);
+    for (size_t i = 0; i < first_tokens.size(); ++i) {
+        ASSERT_EQ(file->tokens[i].size(), first_tokens[i].size());
+        for (size_t j = 0; j < first_tokens[i].size(); ++j) {
+            EXPECT_EQ(file->tokens[i][j].start, first_tokens[i][j].start);
+            EXPECT_EQ(file->tokens[i][j].kind, first_tokens[i][j].kind);
+        }
+    }
+    EXPECT_TRUE(file->state.in_raw_string);
+    EXPECT_EQ(file->state.raw_delimiter, ")d\"");
+}
+
+TEST_F(SidecarIndexTest, StaleOrDamagedSidecarsAreIgnored) {
+    {
+        SourceCache cache(0, directory_);
+        cache.get(source_);
+    }
+    write_source("int changed;\n");
+    {
+        SourceCache cache(0, directory_);
+        auto file = cache.get(source_);
+        EXPECT_EQ(cache.stats().sidecar_loads, 0);
+        ASSERT_EQ(file->lines.size(), 1);
+        EXPECT_EQ(file->lines[0], "int changed;");
+    }
+    
+    std::filesystem::resize_file(sidecar_path(directory_, source_), 20);
+    SourceCache cache(0, directory_);
+    
+    EXPECT_NE(cache.get(source_), nullptr);
+    EXPECT_EQ(cache.stats().sidecar_loads, 0);
+}
+
+TEST_F(SidecarIndexTest, SidecarsThatDoNotFitTheContentAreIgnored) {
+    write_source("a\nbc\n");
+    auto key = make_sidecar_key(source_, std::filesystem::file_size(source_),
+                                std::filesystem::last_write_time(source_));
+    
+    // Same size and mtime, but the line boundaries are elsewhere
+    SourceFile moved_lines;
+    moved_lines.lines = {"ab", "c"};
+    ASSERT_TRUE(save_sidecar_index(directory_, key, moved_lines));
+    {
+        SourceCache cache(0, directory_);
+        auto file = cache.get(source_);
+        EXPECT_EQ(cache.stats().sidecar_loads, 0);
+        EXPECT_EQ(file->lines, (std::vector<std::string>{"a", "bc"}));
+    }
+    
+    // Same size, mtime and line breaks, but different text (e.g. touch -r). The
+    // session above wrote a valid sidecar for "a\nbc\n" on exit.
+    auto stamp = std::filesystem::last_write_time(source_);
+    write_source("x\nyz\n");
+    std::filesystem::last_write_time(source_, stamp);
+    {
+        SourceCache cache(0, directory_);
+        auto file = cache.get(source_);
+        EXPECT_EQ(cache.stats().sidecar_loads, 0);
+        EXPECT_EQ(file->lines, (std::vector<std::string>{"x", "yz"}));
+    }
+    write_source("a\nbc\n");
+    std::filesystem::last_write_time(source_, stamp);
+    
+    // A token span past the end of its line
+    SourceFile long_span;
+    long_span.lines = {"a", "bc"};
+    long_span.tokens = {{TokenSpan{.start = 0, .length = 5, .kind = TokenKind::KEYWORD}}};
+    long_span.token_count = 1;
+    ASSERT_TRUE(save_sidecar_index(directory_, key, long_span));
+    SourceCache cache(0, directory_);
+    
+    EXPECT_NE(cache.get(source_), nullptr);
+    EXPECT_EQ(cache.stats().sidecar_loads, 0);
+}
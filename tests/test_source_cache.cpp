@@ -0,0 +1,148 @@
+#include "../include/source_cache.hpp"
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+
+using namespace nolint;
+
+class SourceCacheTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        std::ofstream file(test_file_);
+        file << "/* header\n";
+        file << "   comment */\n";
+        file << "int main() { return 0; }\n";
+    }
+    
+    void TearDown() override {
+        std::filesystem::remove(test_file_);
+    }
+    
+    const std::string test_file_ = "test_source_cache.cpp";
+};
+
+TEST_F(SourceCacheTest, ReusesFileUntilItChanges) {
+    SourceCache cache;
+    
+    auto first = cache.get(test_file_);
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(first->lines.size(), 3);
+    EXPECT_EQ(cache.get(test_file_), first);
+    
+    {
+        std::ofstream file(test_file_, std::ios::app);
+        file << "// appended\n";
+    }
+    auto reloaded = cache.get(test_file_);
+    
+    ASSERT_NE(reloaded, nullptr);
+    EXPECT_NE(reloaded, first);
+    EXPECT_EQ(reloaded->lines.size(), 4);
+    EXPECT_EQ(cache.get("no_such_file.cpp"), nullptr);
+}
+
+TEST_F(SourceCacheTest, LexesOnlyUpToRequestedLine) {
+    SourceCache cache;
+    auto file = cache.get(test_file_);
+    ASSERT_NE(file, nullptr);
+    
+    const auto& second = line_tokens(*file, 1);
+    
+    EXPECT_EQ(file->tokens.size(), 2);
+    ASSERT_EQ(second.size(), 1);
+    EXPECT_EQ(second[0].kind, TokenKind::COMMENT);  // Carried over from line 1
+    EXPECT_TRUE(line_tokens(*file, 10).empty());
+}
+
+class SourceCacheBudgetTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        for (const auto& path : paths_) {
+            std::ofstream file(path);
+            for (int i = 0; i < 100; ++i) {
+                file << "int value_" << i << " = " << i << ";\n";
+            }
+        }
+    }
+    
+    void TearDown() override {
+        for (const auto& path : paths_) {
+            std::filesystem::remove(path);
+        }
+    }
+    
+    // Room for two of the three files
+    auto two_file_budget() -> size_t {
+        SourceCache probe;
+        return 2 * resident_bytes(*probe.get(paths_[0])) + 1;
+    }
+    
+    const std::vector<std::string> paths_ = {"test_cache_a.cpp", "test_cache_b.cpp",
+                                             "test_cache_c.cpp"};
+};
+
+TEST_F(SourceCacheBudgetTest, EvictsLeastRecentlyUsed) {
+    SourceCache cache(two_file_budget());
+    
+    cache.get(paths_[0]);
+    cache.get(paths_[1]);
+    cache.get(paths_[0]);  // b is now least recently used
+    cache.get(paths_[2]);
+    cache.get(paths_[0]);
+    cache.get(paths_[1]);  // Reloaded
+    
+    auto stats = cache.stats();
+    EXPECT_EQ(stats.hits, 2);
+    EXPECT_EQ(stats.misses, 4);
+    EXPECT_EQ(stats.evictions, 2);
+    EXPECT_EQ(stats.files, 2);
+    EXPECT_LE(stats.resident_bytes, stats.budget_bytes);
+}
+
+TEST_F(SourceCacheBudgetTest, RedrawsOfTheSameFileCountOnce) {
+    SourceCache cache;
+    
+    cache.get(paths_[0]);
+    cache.get(paths_[0]);  // Frames redrawn while staying on a
+    cache.get(paths_[0]);
+    cache.get(paths_[1]);
+    cache.get(paths_[0]);
+    
+    EXPECT_EQ(cache.stats().hits, 1);
+    EXPECT_EQ(cache.stats().misses, 2);
+}
+
+TEST_F(SourceCacheBudgetTest, PinnedFilesOutliveUnpinnedOnes) {
+    SourceCache cache(two_file_budget());
+    cache.pin(paths_[0]);
+    
+    cache.get(paths_[0]);
+    cache.get(paths_[1]);
+    cache.get(paths_[2]);  // Evicts b, although a is older
+    cache.get(paths_[0]);
+    
+    EXPECT_EQ(cache.stats().hits, 1);
+    EXPECT_EQ(cache.stats().evictions, 1);
+}
+
+TEST_F(SourceCacheBudgetTest, LexingCountsTowardsResidentBytes) {
+    SourceCache cache;
+    auto file = cache.get(paths_[0]);
+    auto before = cache.stats().resident_bytes;
+    
+    ensure_lexed(*file, file->lines.size());
+    cache.get(paths_[0]);
+    
+    EXPECT_GT(cache.stats().resident_bytes, before);
+    EXPECT_EQ(cache.stats().resident_bytes, resident_bytes(*file));
+}
+
+TEST(SourceCacheStatsTest, FormatsJson) {
+    SourceCacheStats stats{.hits = 3, .misses = 1, .evictions = 2, .sidecar_loads = 0,
+                           .resident_bytes = 10,
+                           .budget_bytes = 20, .files = 1};
+    
+    EXPECT_EQ(format_cache_stats_json(stats),
+              R"({"event":"cache","hits":3,"misses":1,"hit_percent":75.000,"evictions":2,)"
+              R"("sidecar_loads":0,"resident_bytes":10,"budget_bytes":20,"files":1})");
+}
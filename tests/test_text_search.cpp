@@ -0,0 +1,92 @@
+#include "../include/text_search.hpp"
+#include "../include/ui_model.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+
+using namespace nolint;
+
+// Reference implementation: lowercase copies + std::string::find
+static bool reference_contains(std::string haystack, std::string needle) {
+    std::transform(haystack.begin(), haystack.end(), haystack.begin(), ::tolower);
+    std::transform(needle.begin(), needle.end(), needle.begin(), ::tolower);
+    return haystack.find(needle) != std::string::npos;
+}
+
+TEST(TextSearchTest, FoldCase) {
+    EXPECT_EQ(fold_case("Readability-MAGIC-Numbers_42"), "readability-magic-numbers_42");
+}
+
+TEST(TextSearchTest, BasicMatches) {
+    EXPECT_TRUE(contains_case_insensitive("src/File.cpp", "file"));
+    EXPECT_TRUE(contains_case_insensitive("anything", ""));
+    EXPECT_FALSE(contains_case_insensitive("short", "longer needle"));
+    EXPECT_FALSE(contains_case_insensitive("readability", "x"));
+}
+
+TEST(TextSearchTest, MatchesInsideAndAcrossBlocks) {
+    std::string haystack(100, 'a');
+    haystack.replace(60, 9, "NeedleXyZ");
+    
+    EXPECT_TRUE(contains_case_insensitive(haystack, "needlexyz"));
+    EXPECT_TRUE(contains_case_insensitive(haystack, "an"));
+    EXPECT_FALSE(contains_case_insensitive(haystack, "needlexyy"));
+    
+    // Match at the very end exercises the scalar tail
+    EXPECT_TRUE(contains_case_insensitive(haystack + "TAIL", "tail"));
+}
+
+TEST(TextSearchTest, NonAsciiBytesAreNotFolded) {
+    std::string haystack = "caf\xC3\xA9 \xC3\x89t\xC3\xA9 long enough to use blocks";
+    
+    EXPECT_TRUE(contains_case_insensitive(haystack, "\xC3\x89t"));
+    EXPECT_FALSE(contains_case_insensitive(haystack, "\xC3\xA9t\xC3\xA9"));
+}
+
+TEST(TextSearchTest, AgreesWithReferenceOnRandomInput) {
+    std::mt19937 rng(1234);
+    const std::string alphabet = "abAB-_/ .";
+    auto random_string = [&](size_t length) {
+        std::string result;
+        for (size_t i = 0; i < length; ++i) {
+            result += alphabet[rng() % alphabet.size()];
+        }
+        return result;
+    };
+    
+    for (int i = 0; i < 2000; ++i) {
+        auto haystack = random_string(rng() % 80);
+        auto needle = random_string(1 + rng() % 5);
+        EXPECT_EQ(contains_case_insensitive(haystack, fold_case(needle)),
+                  reference_contains(haystack, needle))
+            << "haystack='" << haystack << "' needle='" << needle << "'";
+    }
+}
+
+TEST(TextSearchTest, FilterMatchesAcrossFieldBoundary) {
+    std::vector<Warning> warnings = {
+        {"src/file.cpp", 1, 1, "readability-x", "message", std::nullopt},
+        {"src/other.cpp", 1, 1, "bugprone-y", "message", std::nullopt}
+    };
+    
+    // "cpp read" only exists in the joined "file_path type message" text
+    auto table = build_warning_table(warnings);
+    EXPECT_EQ(filter_warnings(table, "CPP READ"), (std::vector<size_t>{0}));
+    EXPECT_EQ(filter_warnings(table, "bugprone"), (std::vector<size_t>{1}));
+}
+
+TEST(TextSearchTest, ParallelFilterKeepsOrder) {
+    std::vector<Warning> warnings;
+    for (size_t i = 0; i < 300000; ++i) {
+        warnings.push_back({"src/file" + std::to_string(i % 7) + ".cpp", 1, 1,
+                            (i % 3 == 0) ? "readability-magic" : "bugprone-other", "message",
+                            std::nullopt});
+    }
+    
+    auto filtered = filter_warnings(build_warning_table(warnings), "Magic");
+    
+    ASSERT_EQ(filtered.size(), 100000);
+    EXPECT_TRUE(std::is_sorted(filtered.begin(), filtered.end()));
+    EXPECT_EQ(filtered.front(), 0);
+    EXPECT_EQ(filtered.back(), 299997);
+}
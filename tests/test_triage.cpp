@@ -0,0 +1,172 @@
+#include "../include/triage.hpp"
+#include "../include/warning_parser.hpp"
+#include <gtest/gtest.h>
+#include <set>
+#include <sstream>
+
+using namespace nolint;
+
+namespace {
+
+auto make_warning(const std::string& path, int line) -> Warning {
+    return Warning{path, line, 5, "readability-magic-numbers", "42 is a magic number",
+                   std::nullopt};
+}
+
+auto entry(std::uint64_t fingerprint, NolintStyle style) -> JournalEntry {
+    return JournalEntry{.fingerprint = fingerprint, .style = style};
+}
+
+} // namespace
+
+TEST(TriageTest, FingerprintIdentifiesWarning) {
+    auto warning = make_warning("src/a.cpp", 10);
+    auto moved = make_warning("src/a.cpp", 11);
+    auto other_check = warning;
+    other_check.type = "readability-identifier-length";
+    
+    EXPECT_EQ(warning_fingerprint(warning), warning_fingerprint(make_warning("src/a.cpp", 10)));
+    EXPECT_NE(warning_fingerprint(warning), warning_fingerprint(moved));
+    EXPECT_NE(warning_fingerprint(warning), warning_fingerprint(other_check));
+}
+
+TEST(TriageTest, DirectorySplitKeepsDirectoriesWhole) {
+    std::vector<Warning> warnings;
+    for (int i = 0; i < 6; ++i) {
+        warnings.push_back(make_warning("src/ui/view.cpp", i + 1));
+    }
+    for (int i = 0; i < 4; ++i) {
+        warnings.push_back(make_warning("src/core/model.cpp", i + 1));
+    }
+    for (int i = 0; i < 3; ++i) {
+        warnings.push_back(make_warning("tests/test_model.cpp", i + 1));
+        warnings.push_back(make_warning("src/io/file.cpp", i + 1));
+    }
+    
+    auto sessions = split_reviewers(warnings, 2, SplitMode::DIRECTORY);
+    
+    ASSERT_EQ(sessions.size(), 2);
+    EXPECT_EQ(sessions[0].size() + sessions[1].size(), warnings.size());
+    // 6 + 3 against 4 + 3
+    EXPECT_EQ(std::max(sessions[0].size(), sessions[1].size()), 9);
+    for (const auto& session : sessions) {
+        EXPECT_TRUE(std::is_sorted(session.begin(), session.end()));
+    }
+    std::set<std::string> first_directories;
+    for (auto index : sessions[0]) {
+        first_directories.insert(warnings[index].file_path);
+    }
+    for (auto index : sessions[1]) {
+        EXPECT_EQ(first_directories.count(warnings[index].file_path), 0);
+    }
+}
+
+TEST(TriageTest, CountSplitIsBalanced) {
+    std::vector<Warning> warnings;
+    for (int i = 0; i < 10; ++i) {
+        warnings.push_back(make_warning("src/a.cpp", i + 1));
+    }
+    
+    auto sessions = split_reviewers(warnings, 3, SplitMode::COUNT);
+    
+    ASSERT_EQ(sessions.size(), 3);
+    EXPECT_EQ(sessions[0], (std::vector<size_t>{0, 1, 2}));
+    EXPECT_EQ(sessions[1], (std::vector<size_t>{3, 4, 5}));
+    EXPECT_EQ(sessions[2], (std::vector<size_t>{6, 7, 8, 9}));
+    EXPECT_TRUE(split_reviewers(warnings, 0, SplitMode::COUNT).empty());
+}
+
+TEST(TriageTest, SessionFileParsesBackToSameWarnings) {
+    auto sized = Warning{"src/a.cpp", 3, 6, "readability-function-size",
+                         "function 'f' exceeds recommended size/complexity thresholds", 120};
+    std::vector<Warning> warnings = {make_warning("src/a.cpp", 1), sized,
+                                     make_warning("src/b.cpp", 7)};
+    
+    WarningParser parser;
+    auto parsed = parser.parse(format_warning_lines(warnings, {0, 1, 2}));
+    
+    ASSERT_EQ(parsed.size(), 3);
+    for (size_t i = 0; i < parsed.size(); ++i) {
+        EXPECT_EQ(warning_fingerprint(parsed[i]), warning_fingerprint(warnings[i]));
+    }
+    EXPECT_EQ(parsed[1].function_lines, 120);
+}
+
+TEST(TriageTest, JournalRoundTrips) {
+    std::vector<Warning> warnings = {make_warning("src/a.cpp", 1), make_warning("src/a.cpp", 2),
+                                     make_warning("src/a.cpp", 1)};
+    std::unordered_map<size_t, NolintStyle> decisions = {{0, NolintStyle::NOLINTNEXTLINE},
+                                                         {1, NolintStyle::NONE},
+                                                         {2, NolintStyle::NOLINT}};
+    
+    auto fingerprints = warning_fingerprints(warnings);
+    auto journal = make_journal(fingerprints, decisions);
+    std::istringstream in(format_journal(journal));
+    auto parsed = parse_journal(in);
+    
+    // Warnings 0 and 2 are the same warning; the first one's decision is kept
+    ASSERT_EQ(journal.size(), 2);
+    ASSERT_TRUE(parsed.has_value());
+    ASSERT_EQ(parsed->size(), 2);
+    auto applied = apply_journal(fingerprints, *parsed);
+    EXPECT_EQ(applied.matched_entries, 2);
+    EXPECT_EQ(applied.decisions[0], NolintStyle::NOLINTNEXTLINE);
+    EXPECT_EQ(applied.decisions[1], NolintStyle::NONE);
+    EXPECT_EQ(applied.decisions[2], NolintStyle::NOLINTNEXTLINE);
+}
+
+TEST(TriageTest, JournalKeepsIngestIdentityAfterLinesMove) {
+    std::vector<Warning> warnings = {make_warning("src/a.cpp", 10), make_warning("src/b.cpp", 4)};
+    auto fingerprints = warning_fingerprints(warnings);
+    
+    // An editor session moved the first warning down; its identity stays put
+    warnings[0].line_number = 12;
+    auto journal = make_journal(fingerprints, {{0, NolintStyle::NOLINT}});
+    
+    std::vector<Warning> next_run = {make_warning("src/a.cpp", 10)};
+    auto applied = apply_journal(warning_fingerprints(next_run), journal);
+    EXPECT_EQ(applied.matched_entries, 1);
+    EXPECT_EQ(applied.decisions[0], NolintStyle::NOLINT);
+}
+
+TEST(TriageTest, ApplyJournalCountsUnmatchedEntries) {
+    std::vector<Warning> warnings = {make_warning("src/a.cpp", 1), make_warning("src/a.cpp", 2)};
+    auto journal = make_journal(warning_fingerprints(warnings),
+                                {{0, NolintStyle::NOLINT}, {1, NolintStyle::NOLINT}});
+    
+    std::vector<Warning> fixed = {make_warning("src/a.cpp", 2)};
+    auto applied = apply_journal(warning_fingerprints(fixed), journal);
+    
+    EXPECT_EQ(applied.matched_entries, 1);
+    EXPECT_LT(applied.matched_entries, journal.size());
+    EXPECT_EQ(applied.decisions.size(), 1);
+}
+
+TEST(TriageTest, MalformedJournalIsRejected) {
+    std::istringstream bad_style("0000000000000001 MAYBE\n");
+    std::istringstream bad_digits("00000000000000zz NOLINT\n");
+    
+    EXPECT_FALSE(parse_journal(bad_style).has_value());
+    EXPECT_FALSE(parse_journal(bad_digits).has_value());
+}
+
+TEST(TriageTest, MergeCombinesAgreementsAndResolvesConflicts) {
+    DecisionJournal alice = {entry(1, NolintStyle::NOLINT), entry(3, NolintStyle::NOLINT),
+                             entry(5, NolintStyle::NOLINTNEXTLINE)};
+    DecisionJournal bob = {entry(2, NolintStyle::NOLINT_BLOCK), entry(3, NolintStyle::NOLINT),
+                           entry(5, NolintStyle::NOLINT)};
+    DecisionJournal carol = {entry(4, NolintStyle::NOLINT), entry(5, NolintStyle::NOLINTNEXTLINE)};
+    
+    auto merged = merge_journals({alice, bob, carol});
+    auto reversed = merge_journals({carol, bob, alice});
+    
+    ASSERT_EQ(merged.journal.size(), 5);
+    for (size_t i = 0; i < merged.journal.size(); ++i) {
+        EXPECT_EQ(merged.journal[i].fingerprint, i + 1);
+        EXPECT_EQ(merged.journal[i].style, reversed.journal[i].style);
+    }
+    EXPECT_EQ(merged.journal[2].style, NolintStyle::NOLINT);
+    EXPECT_EQ(merged.journal[4].style, NolintStyle::NONE);
+    EXPECT_EQ(merged.conflicts, (std::vector<std::uint64_t>{5}));
+    EXPECT_EQ(reversed.conflicts, merged.conflicts);
+}
@@ -13,7 +13,8 @@ protected:
             {"file3.cpp", 30, 15, "type3", "message3", std::nullopt}
         };
         // Initialize filtered indices to show all warnings (no filter)
-        model.filtered_warning_indices = filter_warnings(model.warnings, "");
+        model.filtered_warning_indices
+            = std::make_shared<const std::vector<size_t>>(filter_warnings(build_warning_table(model.warnings), ""));
         return model;
     }
 };
@@ -159,7 +160,8 @@ TEST_F(UIModelTest, ToggleStatistics) {
 
 TEST_F(UIModelTest, EmptyWarningsHandling) {
     UIModel model;  // No warnings
-    model.filtered_warning_indices = filter_warnings(model.warnings, "");  // Empty vector
+    model.filtered_warning_indices  // Empty vector
+        = std::make_shared<const std::vector<size_t>>(filter_warnings(build_warning_table(model.warnings), ""));
     
     // Should handle all events gracefully
     auto model1 = update(model, InputEvent::ARROW_RIGHT);
@@ -171,3 +173,367 @@ TEST_F(UIModelTest, EmptyWarningsHandling) {
     auto model3 = update(model, InputEvent::QUIT);
     EXPECT_TRUE(model3.should_exit);
 }
+
+TEST_F(UIModelTest, NextUndecidedSkipsDecidedWarnings) {
+    auto model = apply_filter(create_test_model(), "");
+    
+    // Decide the second warning, then jump from the first
+    model.current_index = 1;
+    model = update(model, InputEvent::ARROW_UP);
+    model.current_index = 0;
+    
+    auto new_model = update(model, InputEvent::NEXT_UNDECIDED);
+    EXPECT_EQ(new_model.current_index, 2);
+    
+    // No undecided warning after the last one - stay put
+    auto end_model = update(new_model, InputEvent::NEXT_UNDECIDED);
+    EXPECT_EQ(end_model.current_index, 2);
+}
+
+TEST_F(UIModelTest, PrevUndecidedSkipsDecidedWarnings) {
+    auto model = apply_filter(create_test_model(), "");
+    
+    model.current_index = 1;
+    model = update(model, InputEvent::ARROW_UP);
+    model.current_index = 2;
+    
+    auto new_model = update(model, InputEvent::PREV_UNDECIDED);
+    EXPECT_EQ(new_model.current_index, 0);
+}
+
+TEST_F(UIModelTest, ResettingStyleMakesWarningUndecidedAgain) {
+    auto model = apply_filter(create_test_model(), "");
+    
+    model.current_index = 1;
+    model = update(model, InputEvent::ARROW_UP);    // NONE -> NOLINT
+    model = update(model, InputEvent::ARROW_DOWN);  // NOLINT -> NONE
+    model.current_index = 0;
+    
+    auto new_model = update(model, InputEvent::NEXT_UNDECIDED);
+    EXPECT_EQ(new_model.current_index, 1);
+}
+
+TEST_F(UIModelTest, NextUndecidedRespectsFilter) {
+    auto model = create_test_model();
+    model.decisions[0] = NolintStyle::NOLINT;
+    
+    // Filter built by hand (no apply_filter) - bitset is rebuilt on demand
+    model.filtered_warning_indices = std::make_shared<const std::vector<size_t>>(
+        std::vector<size_t>{0, 2});
+    
+    auto new_model = update(model, InputEvent::NEXT_UNDECIDED);
+    EXPECT_EQ(new_model.current_index, 1);
+    EXPECT_EQ(new_model.current_warning().file_path, "file3.cpp");
+}
+
+TEST_F(UIModelTest, UndecidedNavigationSkipsLoadedDecisions) {
+    UIModel model;
+    model = replace_warnings(std::move(model), create_test_model().warnings);
+    model = replace_decisions(std::move(model), {{1, NolintStyle::NOLINT}});
+    model = apply_filter(std::move(model), "");
+    
+    auto next = update(model, InputEvent::NEXT_UNDECIDED);
+    EXPECT_EQ(next.current_index, 2);
+    auto prev = update(next, InputEvent::PREV_UNDECIDED);
+    EXPECT_EQ(prev.current_index, 0);
+}
+
+TEST_F(UIModelTest, SetStyleWithEmptyFilterDoesNothing) {
+    auto model = apply_filter(create_test_model(), "no such warning");
+    ASSERT_EQ(model.total_warnings(), 0);
+    
+    for (auto event : {InputEvent::SET_NONE, InputEvent::SET_NOLINT,
+                       InputEvent::SET_NOLINTNEXTLINE, InputEvent::SET_NOLINT_BLOCK}) {
+        auto new_model = update(model, event);
+        EXPECT_TRUE(new_model.decisions.empty());
+        EXPECT_FALSE(new_model.status_message.empty());
+    }
+}
+
+TEST_F(UIModelTest, BuildRunIndexGroupsConsecutiveWarnings) {
+    std::vector<Warning> warnings = {
+        {"a.cpp", 1, 1, "type1", "m", std::nullopt},
+        {"a.cpp", 2, 1, "type1", "m", std::nullopt},
+        {"a.cpp", 3, 1, "type2", "m", std::nullopt},
+        {"b.cpp", 1, 1, "type2", "m", std::nullopt},
+        {"c.cpp", 1, 1, "type2", "m", std::nullopt}
+    };
+    
+    auto table = build_warning_table(warnings);
+    auto runs = build_run_index(table, filter_warnings(table, ""));
+    
+    EXPECT_EQ(runs.file_run_starts, (std::vector<size_t>{0, 3, 4}));
+    EXPECT_EQ(runs.type_run_starts, (std::vector<size_t>{0, 2}));
+    EXPECT_EQ(runs.position_count, 5);
+}
+
+TEST_F(UIModelTest, JumpBetweenFilesAndChecks) {
+    UIModel model;
+    model.warnings = {
+        {"a.cpp", 1, 1, "type1", "m", std::nullopt},
+        {"a.cpp", 2, 1, "type2", "m", std::nullopt},
+        {"b.cpp", 1, 1, "type2", "m", std::nullopt},
+        {"b.cpp", 2, 1, "type3", "m", std::nullopt}
+    };
+    model = apply_filter(model, "");
+    
+    auto next_file = update(model, InputEvent::NEXT_FILE);
+    EXPECT_EQ(next_file.current_index, 2);
+    
+    auto last_file = update(next_file, InputEvent::NEXT_FILE);
+    EXPECT_EQ(last_file.current_index, 2);  // No further file - stays put
+    
+    auto prev_file = update(last_file, InputEvent::PREV_FILE);
+    EXPECT_EQ(prev_file.current_index, 0);
+    
+    auto next_check = update(model, InputEvent::NEXT_CHECK);
+    EXPECT_EQ(next_check.current_index, 1);
+    
+    auto next_check2 = update(next_check, InputEvent::NEXT_CHECK);
+    EXPECT_EQ(next_check2.current_index, 3);  // type2 run spans both files
+    
+    auto prev_check = update(next_check2, InputEvent::PREV_CHECK);
+    EXPECT_EQ(prev_check.current_index, 1);
+}
+
+TEST_F(UIModelTest, GotoWarningNumber) {
+    auto model = apply_filter(create_test_model(), "");
+    
+    auto new_model = goto_location(model, ":3");
+    EXPECT_EQ(new_model.current_index, 2);
+    EXPECT_TRUE(new_model.status_message.empty());
+    
+    auto out_of_range = goto_location(model, ":4");
+    EXPECT_EQ(out_of_range.current_index, 0);
+    EXPECT_FALSE(out_of_range.status_message.empty());
+    
+    // Too large for any integer type: reported, never thrown
+    auto overflow = goto_location(model, ":99999999999999999999");
+    EXPECT_EQ(overflow.current_index, 0);
+    EXPECT_EQ(overflow.status_message.rfind("Invalid go-to target", 0), 0);
+}
+
+TEST_F(UIModelTest, GotoLocationPicksNearestWarning) {
+    UIModel model;
+    model.warnings = {
+        {"src/a.cpp", 10, 1, "type1", "m", std::nullopt},
+        {"src/b.cpp", 5, 1, "type1", "m", std::nullopt},
+        {"src/b.cpp", 50, 1, "type1", "m", std::nullopt}
+    };
+    model = apply_filter(model, "");
+    
+    auto near_end = goto_location(model, "src/b.cpp:45");
+    EXPECT_EQ(near_end.current_index, 2);
+    
+    auto near_start = goto_location(model, "b.cpp:7");
+    EXPECT_EQ(near_start.current_index, 1);
+    
+    auto missing = goto_location(model, "src/c.cpp:1");
+    EXPECT_EQ(missing.current_index, 0);
+    EXPECT_FALSE(missing.status_message.empty());
+    
+    // Next input clears the transient message
+    auto cleared = update(missing, InputEvent::ARROW_RIGHT);
+    EXPECT_TRUE(cleared.status_message.empty());
+}
+
+TEST_F(UIModelTest, ReturningToFilterRestoresPosition) {
+    auto model = apply_filter(create_test_model(), "");
+    model.current_index = 2;
+    
+    auto filtered = apply_filter(model, "TYPE1");
+    EXPECT_EQ(filtered.total_warnings(), 1);
+    EXPECT_EQ(filtered.current_index, 0);
+    
+    // Back to the unfiltered view - served from cache with cursor restored
+    auto unfiltered = apply_filter(filtered, "");
+    EXPECT_EQ(unfiltered.total_warnings(), 3);
+    EXPECT_EQ(unfiltered.current_index, 2);
+    
+    // Same query with different case hits the same entry
+    auto again = apply_filter(unfiltered, "type1");
+    EXPECT_EQ(again.total_warnings(), 1);
+    EXPECT_EQ(*again.filtered_warning_indices, *filtered.filtered_warning_indices);
+    
+    // A hit shares the indices and navigation indexes built when the filter was first applied
+    EXPECT_EQ(again.filtered_warning_indices, filtered.filtered_warning_indices);
+    EXPECT_EQ(again.runs, filtered.runs);
+    EXPECT_EQ(again.locations, filtered.locations);
+}
+
+TEST_F(UIModelTest, ReturningToFilterKeepsDecidedPositionsCurrent) {
+    auto model = apply_filter(create_test_model(), "");
+    model.current_index = 0;
+    model = update(model, InputEvent::ARROW_UP);  // Decide file1 under no filter
+    
+    auto round_trip = apply_filter(apply_filter(model, "type1"), "");
+    EXPECT_EQ(round_trip.decided_positions.words, model.decided_positions.words);
+    
+    // Deciding under another filter invalidates the bitset left behind
+    auto other = apply_filter(model, "type3");
+    other = update(other, InputEvent::ARROW_UP);  // Decide file3
+    auto back = apply_filter(other, "");
+    EXPECT_EQ(back.current_index, 0);
+    auto next = update(back, InputEvent::NEXT_UNDECIDED);
+    EXPECT_EQ(next.current_warning().file_path, "file2.cpp");
+    EXPECT_TRUE(test_position(back.decided_positions, 2));
+}
+
+TEST_F(UIModelTest, ReplacingWarningsOfSameLengthRebuildsIndexes) {
+    auto model = apply_filter(create_test_model(), "type1");
+    auto old_table = model.table;
+    
+    std::vector<Warning> replacement = {
+        {"src/x.cpp", 7, 1, "other", "m", std::nullopt},
+        {"src/y.cpp", 8, 1, "type1", "m", std::nullopt},
+        {"src/y.cpp", 9, 1, "type1", "m", std::nullopt}
+    };
+    ASSERT_EQ(replacement.size(), model.warnings.size());
+    model = replace_warnings(std::move(model), replacement);
+    
+    EXPECT_NE(model.table, old_table);
+    EXPECT_EQ(*model.filtered_warning_indices, (std::vector<size_t>{1, 2}));
+    auto found = goto_location(model, "src/y.cpp:9");
+    EXPECT_EQ(found.current_index, 1);
+    EXPECT_TRUE(found.status_message.empty());
+}
+
+TEST_F(UIModelTest, StatisticsBulkDecisionIsOneUndoStep) {
+    UIModel model;
+    model.warnings = {
+        {"a.cpp", 1, 1, "readability-magic-numbers", "m", std::nullopt},
+        {"a.cpp", 2, 1, "modernize-use-auto", "m", std::nullopt},
+        {"b.cpp", 3, 1, "readability-magic-numbers", "m", std::nullopt}
+    };
+    model = apply_filter(std::move(model), "");
+    
+    model = update(model, InputEvent::SHOW_STATISTICS);
+    ASSERT_EQ(model.statistics_rows.size(), 2);
+    EXPECT_EQ(model.check_trie.nodes[model.statistics_rows[0]].label, "readability");
+    
+    model = update(model, InputEvent::SET_NOLINTNEXTLINE);
+    
+    EXPECT_EQ(model.get_decision(0), NolintStyle::NOLINTNEXTLINE);
+    EXPECT_EQ(model.get_decision(1), NolintStyle::NONE);
+    EXPECT_EQ(model.get_decision(2), NolintStyle::NOLINTNEXTLINE);
+    EXPECT_EQ(model.check_trie.nodes[model.statistics_rows[0]].counts.nolintnextline, 2);
+    
+    model = update(model, InputEvent::UNDO);
+    
+    EXPECT_EQ(model.get_decision(0), NolintStyle::NONE);
+    EXPECT_EQ(model.get_decision(2), NolintStyle::NONE);
+    EXPECT_EQ(model.check_trie.nodes[model.statistics_rows[0]].counts.unsuppressed, 2);
+}
+
+TEST_F(UIModelTest, StatisticsArrowsExpandAndCollapse) {
+    UIModel model;
+    model.warnings = {
+        {"a.cpp", 1, 1, "readability-identifier-naming", "m", std::nullopt},
+        {"a.cpp", 2, 1, "readability-identifier-length", "m", std::nullopt}
+    };
+    model = apply_filter(std::move(model), "");
+    model = update(model, InputEvent::SHOW_STATISTICS);
+    ASSERT_EQ(model.statistics_rows.size(), 1);
+    
+    model = update(model, InputEvent::ARROW_RIGHT);
+    EXPECT_EQ(model.statistics_rows.size(), 2);
+    
+    model = update(model, InputEvent::ARROW_DOWN);
+    model = update(model, InputEvent::ARROW_LEFT);
+    
+    EXPECT_EQ(model.statistics_rows.size(), 1);
+    EXPECT_EQ(model.statistics_selected_index, 0);
+}
+
+TEST_F(UIModelTest, StatisticsWindowFollowsSelection) {
+    UIModel model;
+    for (int i = 0; i < 10; ++i) {
+        model.warnings.push_back({"a.cpp", i + 1, 1, "check" + std::to_string(i), "m", std::nullopt});
+    }
+    model = apply_filter(std::move(model), "");
+    model.statistics_page_rows = 3;
+    model = update(model, InputEvent::SHOW_STATISTICS);
+    ASSERT_EQ(model.statistics_rows.size(), 10);
+    
+    model = update(model, InputEvent::PAGE_DOWN);
+    EXPECT_EQ(model.statistics_selected_index, 3);
+    EXPECT_EQ(model.statistics_scroll_offset, 1);
+    
+    model = update(model, InputEvent::END);
+    EXPECT_EQ(model.statistics_selected_index, 9);
+    EXPECT_EQ(model.statistics_scroll_offset, 7);
+    
+    model = update(model, InputEvent::HOME);
+    EXPECT_EQ(model.statistics_scroll_offset, 0);
+}
+
+TEST_F(UIModelTest, StatisticsSortKeepsSelectedNode) {
+    UIModel model;
+    model.warnings = {
+        {"a.cpp", 1, 1, "zeta-check", "m", std::nullopt},
+        {"a.cpp", 2, 1, "zeta-check", "m", std::nullopt},
+        {"a.cpp", 3, 1, "alpha-check", "m", std::nullopt}
+    };
+    model = apply_filter(std::move(model), "");
+    model = update(model, InputEvent::SHOW_STATISTICS);
+    EXPECT_EQ(model.check_trie.nodes[model.statistics_rows[0]].label, "zeta");
+    
+    model = update(model, InputEvent::CYCLE_SORT); // unsuppressed
+    model = update(model, InputEvent::CYCLE_SORT); // NOLINT
+    model = update(model, InputEvent::CYCLE_SORT); // NOLINTNEXTLINE
+    model = update(model, InputEvent::CYCLE_SORT); // NOLINT_BLOCK
+    model = update(model, InputEvent::CYCLE_SORT); // name
+    
+    EXPECT_EQ(model.statistics_sort, StatisticsSort::NAME);
+    EXPECT_EQ(model.check_trie.nodes[model.statistics_rows[0]].label, "alpha");
+    EXPECT_EQ(model.statistics_selected_index, 1); // Still on "zeta"
+}
+
+TEST_F(UIModelTest, NeighbouringWarningsStayInCurrentFile) {
+    UIModel model;
+    model.warnings = {
+        {"a.cpp", 10, 1, "type1", "m", std::nullopt},
+        {"b.cpp", 11, 1, "type1", "m", std::nullopt},
+        {"a.cpp", 12, 1, "type2", "m", std::nullopt},
+        {"a.cpp", 40, 1, "type2", "m", std::nullopt}
+    };
+    
+    EXPECT_TRUE(neighbouring_warnings(model, 1, 100).empty());  // No index yet
+    
+    model = apply_filter(std::move(model), "type2");
+    auto neighbours = neighbouring_warnings(model, 7, 15);
+    
+    ASSERT_EQ(neighbours.size(), 2);
+    EXPECT_EQ(neighbours[0].warning_index, 0);  // Outside the filter, still shown
+    EXPECT_EQ(neighbours[1].warning_index, 2);
+}
+
+TEST_F(UIModelTest, RebaseMovesOnlyTheEditedFile) {
+    UIModel model;
+    model.warnings = {
+        {"a.cpp", 2, 1, "type1", "m", std::nullopt},
+        {"b.cpp", 2, 1, "type1", "m", std::nullopt},
+        {"a.cpp", 4, 1, "type1", "m", std::nullopt}
+    };
+    model = apply_filter(std::move(model), "");
+    model = update(model, InputEvent::SET_NOLINT);
+    auto old_table = model.table;
+    
+    // Two lines inserted above line 2 of a.cpp
+    auto map = map_lines({"x", "y", "z", "w"}, {"x", "new1", "new2", "y", "z", "w"});
+    model = rebase_file_warnings(std::move(model), "a.cpp", map);
+    
+    EXPECT_EQ(model.warnings[0].line_number, 4);
+    EXPECT_EQ(model.warnings[1].line_number, 2);
+    EXPECT_EQ(model.warnings[2].line_number, 6);
+    EXPECT_EQ(model.table->lines[2], 6);
+    EXPECT_EQ(old_table->lines[2], 4);  // Earlier snapshots are untouched
+    EXPECT_EQ(model.get_decision(0), NolintStyle::NOLINT);
+    
+    auto neighbours = neighbouring_warnings(model, 4, 6);
+    ASSERT_EQ(neighbours.size(), 2);
+    EXPECT_EQ(neighbours[1].warning_index, 2);
+    
+    model = goto_location(model, "a.cpp:6");
+    EXPECT_EQ(model.current_index, 2);
+}
@@ -0,0 +1,204 @@
+#include "../include/verify.hpp"
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+
+using namespace nolint;
+
+class VerifyTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        std::filesystem::create_directories(directory_ + "/src");
+        std::filesystem::create_directories(directory_ + "/include");
+        std::filesystem::create_directories(directory_ + "/build");
+        std::ofstream(directory_ + "/include/shared.hpp") << "int shared = 42;\n";
+        std::ofstream(directory_ + "/src/a.cpp") << "#include \"shared.hpp\"\n";
+        std::ofstream(directory_ + "/src/b.cpp") << "int b = 7;\n";
+        std::ofstream(directory_ + "/src/c.cpp") << "int c = 7;\n";
+        
+        // a.cpp includes the header; b.cpp has a depfile without it; c.cpp has none
+        auto root = std::filesystem::absolute(directory_).string();
+        std::ofstream(directory_ + "/build/a.o.d")
+            << "a.o: " << root << "/src/a.cpp \\\n  ../include/shared.hpp\n";
+        std::ofstream(directory_ + "/build/b.o.d") << "b.o: ../src/b.cpp\n";
+        std::ofstream(directory_ + "/build/compile_commands.json") << R"([
+  {"directory": ")" << root << R"(/build", "file": "../src/a.cpp",
+   "arguments": ["c++", "-MD", "-MF", "a.o.d", "-o", "a.o", "-c", "../src/a.cpp"]},
+  {"directory": ")" << root << R"(/build", "file": "../src/b.cpp",
+   "command": "c++ -MD -o b.o -c ../src/b.cpp"},
+  {"directory": ")" << root << R"(/build", "file": "../src/c.cpp",
+   "command": "c++ -c ../src/c.cpp"}
+])";
+        
+        // Stands in for clang-tidy: the header's warning survives, anything else doesn't
+        script_ = root + "/fake-clang-tidy";
+        std::ofstream(script_) << "#!/bin/sh\necho '" << root
+                               << "/include/shared.hpp:1:14: warning: 42 is a magic number "
+                                  "[readability-magic-numbers]'\n";
+        std::filesystem::permissions(script_, std::filesystem::perms::owner_all);
+    }
+    
+    void TearDown() override {
+        std::filesystem::remove_all(directory_);
+    }
+    
+    auto load_commands() const -> std::vector<CompileCommand> {
+        std::ifstream input(directory_ + "/build/compile_commands.json");
+        std::string json((std::istreambuf_iterator<char>(input)), {});
+        return parse_compile_commands(json).value();
+    }
+    
+    const std::string directory_ = "test_verify_dir";
+    std::string script_;
+};
+
+TEST(CompileCommandsTest, ParsesArgumentsAndCommandForms) {
+    auto commands = parse_compile_commands(R"([
+        {"directory": "/b", "file": "x.cpp", "arguments": ["c++", "-DNAME=\"v\"", "x.cpp"],
+         "output": "x.o", "extra": {"nested": [1, true, null]}},
+        {"directory": "/b", "command": "c++ -I'my dir' -DA=\\\"q\\\" -c y.cpp", "file": "y.cpp"}
+    ])");
+    
+    ASSERT_TRUE(commands.has_value());
+    ASSERT_EQ(commands->size(), 2);
+    EXPECT_EQ((*commands)[0].arguments[1], "-DNAME=\"v\"");
+    EXPECT_EQ((*commands)[0].output, "x.o");
+    EXPECT_EQ((*commands)[1].arguments,
+              (std::vector<std::string>{"c++", "-Imy dir", "-DA=\"q\"", "-c", "y.cpp"}));
+    EXPECT_FALSE(parse_compile_commands(R"([{"file": "x.cpp"}])").has_value());
+    EXPECT_FALSE(parse_compile_commands(R"([{"directory": "/b", "file": "x.cpp")").has_value());
+}
+
+TEST(CompileCommandsTest, DecodesUnicodeEscapes) {
+    auto commands = parse_compile_commands(
+        R"([{"directory": "/b", "file": "\u00e9\u4e2d\ud83d\ude00\ud800.cpp",)"
+        R"( "arguments": ["c++"]}])");
+    
+    ASSERT_TRUE(commands.has_value());
+    EXPECT_EQ((*commands)[0].file, "\xC3\xA9\xE4\xB8\xAD\xF0\x9F\x98\x80\xEF\xBF\xBD.cpp");
+    EXPECT_FALSE(parse_compile_commands(R"([{"directory": "/b", "file": "\u00zz.cpp",)"
+                                        R"( "arguments": ["c++"]}])")
+                     .has_value());
+    EXPECT_FALSE(parse_compile_commands(R"([{"directory": "/b", "file": "\u-001",)"
+                                        R"( "arguments": ["c++"]}])")
+                     .has_value());
+}
+
+TEST(CompileCommandsTest, FindsDepfiles) {
+    CompileCommand explicit_depfile{"/b", "x.cpp", {"c++", "-MFdeps/x.d", "-o", "x.o"}, ""};
+    CompileCommand from_output{"/b", "x.cpp", {"c++", "-MD", "-o", "obj/x.o", "-c", "x.cpp"}, ""};
+    CompileCommand no_output{"/b", "x.cpp", {"c++", "-c", "x.cpp"}, ""};
+    
+    EXPECT_EQ(depfile_candidates(explicit_depfile), (std::vector<std::string>{"/b/deps/x.d"}));
+    EXPECT_EQ(depfile_candidates(from_output),
+              (std::vector<std::string>{"/b/obj/x.o.d", "/b/obj/x.d"}));
+    EXPECT_TRUE(depfile_candidates(no_output).empty());
+}
+
+TEST(DepfileTest, ParsesMakeSyntax) {
+    auto prerequisites = parse_depfile("obj/x.o: src/x.cpp \\\n"
+                                       "  include/my\\ file.hpp /usr/include/c$$x.h\n"
+                                       "include/my\\ file.hpp:\n");
+    
+    EXPECT_EQ(prerequisites, (std::vector<std::string>{"src/x.cpp", "include/my file.hpp",
+                                                       "/usr/include/c$x.h"}));
+}
+
+TEST(VerifyTargetsTest, FollowsInsertedLinesAndMatchesSurvivors) {
+    std::vector<Warning> warnings = {
+        {"src/a.cpp", 2, 9, "readability-magic-numbers", "magic", std::nullopt},
+        {"src/a.cpp", 3, 9, "readability-magic-numbers", "magic", std::nullopt},
+        {"src/b.cpp", 1, 1, "readability-magic-numbers", "magic", std::nullopt}};
+    std::unordered_map<size_t, NolintStyle> decisions
+        = {{0, NolintStyle::NOLINTNEXTLINE}, {1, NolintStyle::NONE}, {2, NolintStyle::NOLINT}};
+    std::unordered_map<std::string, LineMap> line_maps
+        = {{"src/a.cpp", map_lines({"a", "b", "c"}, {"a", "// NOLINTNEXTLINE", "b", "c"})}};
+    
+    auto targets = verification_targets(warnings, decisions, line_maps);
+    
+    // b.cpp was not modified and warning 1 was not suppressed
+    ASSERT_EQ(targets.size(), 1);
+    EXPECT_EQ(targets[0].line_number, 3);
+    auto survivors = surviving_targets(
+        targets, {{"src/a.cpp", 3, 9, "readability-magic-numbers", "magic", std::nullopt},
+                  {"src/a.cpp", 4, 9, "readability-magic-numbers", "magic", std::nullopt}});
+    ASSERT_EQ(survivors.size(), 1);
+    EXPECT_TRUE(surviving_targets(targets, {}).empty());
+}
+
+TEST_F(VerifyTest, SelectsUnitsThatIncludeModifiedFiles) {
+    PathResolver paths;
+    
+    auto selection = select_translation_units(
+        load_commands(), {directory_ + "/include/shared.hpp", directory_ + "/src/c.cpp"}, paths);
+    
+    // a.cpp through its depfile, c.cpp because it is the modified source itself
+    ASSERT_EQ(selection.units, (std::vector<size_t>{0, 2}));
+    EXPECT_TRUE(selection.uncovered_files.empty());
+    EXPECT_EQ(selection.missing_depfiles, 1);
+}
+
+TEST_F(VerifyTest, ReportsModifiedFilesNoUnitIncludes) {
+    PathResolver paths;
+    std::ofstream(directory_ + "/include/unused.hpp") << "\n";
+    
+    auto selection
+        = select_translation_units(load_commands(), {directory_ + "/include/unused.hpp"}, paths);
+    
+    EXPECT_TRUE(selection.units.empty());
+    EXPECT_EQ(selection.uncovered_files,
+              (std::vector<std::string>{directory_ + "/include/unused.hpp"}));
+}
+
+TEST_F(VerifyTest, ReportsSurvivingSuppressions) {
+    std::vector<Warning> targets = {
+        {directory_ + "/include/shared.hpp", 1, 14, "readability-magic-numbers", "42",
+         std::nullopt},
+        {directory_ + "/src/b.cpp", 1, 9, "readability-magic-numbers", "7", std::nullopt}};
+    VerifyOptions options{.build_directory = directory_ + "/build",
+                          .clang_tidy = script_,
+                          .worker_count = 2};
+    
+    auto report = verify_suppressions(
+        options, targets, {directory_ + "/include/shared.hpp", directory_ + "/src/b.cpp"});
+    
+    ASSERT_TRUE(report.success);
+    EXPECT_EQ(report.translation_units, 2);
+    EXPECT_TRUE(report.failed_units.empty());
+    ASSERT_EQ(report.survivors.size(), 1);
+    EXPECT_EQ(report.survivors[0].line_number, 1);
+    EXPECT_EQ(report.survivors[0].column, 14);
+}
+
+TEST_F(VerifyTest, UnitsWhoseRunFailsAreReportedNotTrusted) {
+    // Compiler errors: no diagnostics for the suppression, and a non-zero exit
+    std::ofstream(script_) << "#!/bin/sh\necho 'a.cpp:1:1: error: unknown type name'\nexit 1\n";
+    std::vector<Warning> targets = {{directory_ + "/include/shared.hpp", 1, 14,
+                                     "readability-magic-numbers", "42", std::nullopt}};
+    VerifyOptions options{.build_directory = directory_ + "/build",
+                          .clang_tidy = script_,
+                          .worker_count = 1};
+    
+    auto report = verify_suppressions(options, targets, {directory_ + "/include/shared.hpp"});
+    
+    ASSERT_TRUE(report.success);
+    EXPECT_TRUE(report.survivors.empty());
+    ASSERT_EQ(report.failed_units.size(), 1);
+    EXPECT_NE(report.failed_units[0].find("a.cpp"), std::string::npos);
+    
+    // Killed by a signal
+    std::ofstream(script_) << "#!/bin/sh\nkill -9 $$\n";
+    report = verify_suppressions(options, targets, {directory_ + "/include/shared.hpp"});
+    EXPECT_EQ(report.failed_units.size(), 1);
+}
+
+TEST_F(VerifyTest, FailsWithoutCompilationDatabase) {
+    VerifyOptions options{.build_directory = directory_ + "/missing",
+                          .clang_tidy = script_,
+                          .worker_count = 1};
+    
+    auto report = verify_suppressions(options, {}, {});
+    
+    EXPECT_FALSE(report.success);
+    EXPECT_NE(report.error_message.find("compile_commands.json"), std::string::npos);
+}
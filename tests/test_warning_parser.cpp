@@ -65,3 +65,58 @@ TEST(WarningParserTest, HandleComplexPaths) {
     EXPECT_EQ(warnings[0].file_path, "/home/user/my-project/src/file.cpp");
     EXPECT_EQ(warnings[0].line_number, 42);
 }
+
+TEST(WarningParserTest, ScanLocatesPathAndCheckSpans) {
+    WarningParser parser;
+    std::string input = 
+        "noise warning: not a diagnostic\n"
+        "src/a.cpp:3:7: warning: use auto [modernize-use-auto]\n";
+    
+    auto spans = parser.scan(input);
+    
+    ASSERT_EQ(spans.size(), 1);
+    std::string_view line = std::string_view(input).substr(spans[0].line_offset, spans[0].line_length);
+    EXPECT_EQ(line.substr(0, spans[0].path_length), "src/a.cpp");
+    EXPECT_EQ(line.substr(spans[0].type_offset, spans[0].type_length), "modernize-use-auto");
+    EXPECT_EQ(line.substr(spans[0].message_offset, spans[0].message_length), "use auto");
+}
+
+TEST(WarningParserTest, MessageMayContainBrackets) {
+    WarningParser parser;
+    std::string input = "file.cpp:1:2: warning: use [[nodiscard]] here  [modernize-use-nodiscard]";
+    
+    auto warnings = parser.parse(input);
+    
+    ASSERT_EQ(warnings.size(), 1);
+    EXPECT_EQ(warnings[0].message, "use [[nodiscard]] here");
+    EXPECT_EQ(warnings[0].type, "modernize-use-nodiscard");
+    EXPECT_EQ(warnings[0].column, 2);
+}
+
+TEST(WarningParserTest, FunctionSizeNoteIsNotTakenFromLaterWarning) {
+    WarningParser parser;
+    std::string input = 
+        "a.cpp:1:6: warning: function 'f' exceeds [readability-function-size]\n"
+        "b.cpp:9:6: warning: function 'g' exceeds [readability-function-size]\n"
+        "b.cpp:9:6: note: 120 lines including whitespace and comments (threshold 80)\n";
+    
+    auto warnings = parser.parse(input);
+    
+    ASSERT_EQ(warnings.size(), 2);
+    EXPECT_FALSE(warnings[0].function_lines.has_value());
+    EXPECT_EQ(warnings[1].function_lines, 120);
+}
+
+TEST(WarningParserTest, ParseStreamFromCurrentPosition) {
+    WarningParser parser;
+    std::istringstream input("skipped\n"
+                             "file1.cpp:1:1: warning: message1 [type1]\n"
+                             "file2.cpp:2:2: warning: message2 [type2]\n");
+    std::string first_line;
+    std::getline(input, first_line);
+    
+    auto warnings = parser.parse(input);
+    
+    ASSERT_EQ(warnings.size(), 2);
+    EXPECT_EQ(warnings[1].file_path, "file2.cpp");
+}
@@ -0,0 +1,61 @@
+#include "../include/ui_model.hpp"
+#include "../include/warning_table.hpp"
+#include <gtest/gtest.h>
+
+using namespace nolint;
+
+namespace {
+
+auto sample_warnings() -> std::vector<Warning> {
+    return {
+        {"a.cpp", 1, 2, "readability-magic-numbers", "magic 42", std::nullopt},
+        {"b.cpp", 3, 4, "readability-function-size", "too big", 90},
+        {"a.cpp", 5, 6, "readability-magic-numbers", "magic 7", std::nullopt}
+    };
+}
+
+} // namespace
+
+TEST(WarningTableTest, RowsRoundTrip) {
+    auto warnings = sample_warnings();
+    
+    auto table = build_warning_table(warnings);
+    
+    ASSERT_EQ(table.size(), warnings.size());
+    for (size_t i = 0; i < warnings.size(); ++i) {
+        auto row = warning_row(table, i);
+        EXPECT_EQ(row.file_path(), warnings[i].file_path);
+        EXPECT_EQ(row.line_number(), warnings[i].line_number);
+        EXPECT_EQ(row.column(), warnings[i].column);
+        EXPECT_EQ(row.type(), warnings[i].type);
+        EXPECT_EQ(row.message(), warnings[i].message);
+        EXPECT_EQ(row.function_lines(), warnings[i].function_lines);
+    }
+}
+
+TEST(WarningTableTest, InternsRepeatedStrings) {
+    auto table = build_warning_table(sample_warnings());
+    
+    EXPECT_EQ(table.paths.names.size(), 2);
+    EXPECT_EQ(table.checks.unknown.names.size(), 0);
+    EXPECT_EQ(table.path_ids[0], table.path_ids[2]);
+    EXPECT_EQ(find_interned(table.paths, "b.cpp"), table.path_ids[1]);
+    EXPECT_FALSE(find_interned(table.paths, "c.cpp").has_value());
+}
+
+TEST(WarningTableTest, FilterSearchesEveryField) {
+    auto table = build_warning_table(sample_warnings());
+    
+    std::vector<std::pair<std::string, std::vector<size_t>>> cases = {
+        {"", {0, 1, 2}},
+        {"A.CPP", {0, 2}},
+        {"magic", {0, 2}},
+        {"size", {1}},
+        {"42", {0}},
+        {"b.cpp readability", {1}},
+        {"nothing", {}}
+    };
+    for (const auto& [filter, expected] : cases) {
+        EXPECT_EQ(filter_warnings(table, filter), expected) << filter;
+    }
+}